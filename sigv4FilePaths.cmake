@@ -9,6 +9,18 @@
 set( SIGV4_SOURCES
      "${CMAKE_CURRENT_LIST_DIR}/source/sigv4.c" )
 
+# Optional SHA-256 implementation for the SigV4 cryptography interface.
+set( SIGV4_SHA256_SOURCES
+     "${CMAKE_CURRENT_LIST_DIR}/source/sigv4_sha256.c" )
+
+# Optional POSIX helper that hashes file payloads through memory mappings.
+set( SIGV4_FILE_SOURCES
+     "${CMAKE_CURRENT_LIST_DIR}/source/sigv4_file.c" )
+
+# Optional CRC32C checksum and trailer framing for unsigned streaming uploads.
+set( SIGV4_CRC32C_SOURCES
+     "${CMAKE_CURRENT_LIST_DIR}/source/sigv4_crc32c.c" )
+
 # SigV4 library public include directories.
 set( SIGV4_INCLUDE_PUBLIC_DIRS
      "${CMAKE_CURRENT_LIST_DIR}/source/include" )
@@ -54,8 +54,12 @@
 #define SIGV4_HTTP_X_AMZ_SECURITY_TOKEN_HEADER      "x-amz-security-token"               /**< AWS identifier for security token. */
 
 #define SIGV4_STREAMING_AWS4_HMAC_SHA256_PAYLOAD    "STREAMING-AWS4-HMAC-SHA256-PAYLOAD" /**< S3 identifier for chunked payloads. */
+#define SIGV4_UNSIGNED_PAYLOAD                      "UNSIGNED-PAYLOAD"                   /**< S3 identifier for payloads that are not signed. */
+#define SIGV4_STREAMING_UNSIGNED_PAYLOAD_TRAILER    "STREAMING-UNSIGNED-PAYLOAD-TRAILER" /**< S3 identifier for chunked payloads that are protected by a trailing checksum. */
 #define SIGV4_HTTP_X_AMZ_CONTENT_SHA256_HEADER      "x-amz-content-sha256"               /**< S3 identifier for streaming requests. */
 #define SIGV4_HTTP_X_AMZ_STORAGE_CLASS_HEADER       "x-amz-storage-class"                /**< S3 identifier for reduced streaming redundancy. */
+#define SIGV4_HTTP_X_AMZ_TRAILER_HEADER             "x-amz-trailer"                      /**< S3 identifier for the trailers sent after a chunked payload. */
+#define SIGV4_HTTP_X_AMZ_CHECKSUM_CRC32C_HEADER     "x-amz-checksum-crc32c"              /**< S3 identifier for the CRC32C checksum of a payload. */
 
 #define SIGV4_ACCESS_KEY_ID_LENGTH                  20U                                  /**< Length of access key ID. */
 #define SIGV4_SECRET_ACCESS_KEY_LENGTH              40U                                  /**< Length of secret access key. */
@@ -63,6 +67,46 @@
 #define SIGV4_ISO_STRING_LEN                        16U                                  /**< Length of ISO 8601 date string. */
 #define SIGV4_EXPECTED_LEN_RFC_3339                 20U                                  /**< Length of RFC 3339 date input. */
 #define SIGV4_EXPECTED_LEN_RFC_5322                 29U                                  /**< Length of RFC 5322 date input. */
+
+#define SIGV4_HEX_PAYLOAD_HASH_LENGTH               ( SIGV4_HASH_DIGEST_LENGTH * 2U )    /**< Length of the hex-encoded payload hash written by #SigV4_PayloadHashFinal. */
+#define SIGV4_HEX_SIGNATURE_LENGTH                  ( SIGV4_HASH_DIGEST_LENGTH * 2U )    /**< Length of a hex-encoded signature. */
+
+/**
+ * @brief Longest chunk header written by #SigV4_SignChunk: the hex-encoded
+ * chunk size, ";chunk-signature=", the signature, and "\r\n".
+ */
+#define SIGV4_CHUNK_HEADER_MAX_LENGTH               ( ( 2U * sizeof( size_t ) ) + 17U + SIGV4_HEX_SIGNATURE_LENGTH + 2U )
+
+/**
+ * @brief Length of the event headers written by #SigV4_SignEvent: the 15
+ * byte ":date" timestamp header, and the ":chunk-signature" byte array
+ * header of 20 bytes followed by the signature.
+ */
+#define SIGV4_EVENT_HEADERS_LENGTH                  ( 35U + SIGV4_HASH_DIGEST_LENGTH )
+
+/**
+ * @brief Longest validity of a presigned URL, in seconds (seven days).
+ */
+#define SIGV4_PRESIGNED_URL_EXPIRES_MAX             604800U
+
+/**
+ * @brief Number of presigned URLs held by a #SigV4PresignPool_t: the URLs of
+ * the current and next windows, and a spare one that is generated while they
+ * are in use.
+ */
+#define SIGV4_PRESIGN_POOL_SLOT_COUNT               3U
+
+/**
+ * @brief Number of credential sets held by a #SigV4CredentialStore_t: the
+ * published one, and the one that the next credentials are written to.
+ */
+#define SIGV4_CREDENTIAL_STORE_SLOT_COUNT           2U
+
+/**
+ * @brief Largest number of chunks of a #SigV4ChunkHashJob_t, so that its
+ * group counters cannot wrap around.
+ */
+#define SIGV4_CHUNK_HASH_JOB_MAX_COUNT              0x10000000UL
 /** @}*/
 
 /**
@@ -110,6 +154,41 @@
  */
 #define SIGV4_HTTP_ALL_ARE_CANONICAL_FLAG        0x8U
 
+/**
+ * @ingroup sigv4_canonical_flags
+ * @brief Set this flag to indicate that the HTTP request payload input is the
+ * hex-encoded hash of the payload rather than the payload itself, for
+ * example as computed with #SigV4_PayloadHashFinal.
+ *
+ * This flag is valid only for #SigV4HttpParameters_t.flags.
+ */
+#define SIGV4_HTTP_PAYLOAD_IS_HASH               0x10U
+
+/**
+ * @ingroup sigv4_canonical_flags
+ * @brief Set this flag to sign the request with #SIGV4_UNSIGNED_PAYLOAD in
+ * place of the payload hash, so that the payload is not hashed.
+ *
+ * #SigV4HttpParameters_t.pPayload is ignored. The same value must be sent in
+ * the x-amz-content-sha256 header. This flag is valid only for
+ * #SigV4HttpParameters_t.flags, and cannot be combined with
+ * #SIGV4_HTTP_PAYLOAD_IS_HASH.
+ */
+#define SIGV4_HTTP_PAYLOAD_IS_UNSIGNED           0x20U
+
+/**
+ * @ingroup sigv4_canonical_flags
+ * @brief Set this flag to append the X-Amz-Security-Token parameter of a
+ * presigned URL after the signature, so that the security token is not
+ * signed.
+ *
+ * AWS IoT expects the security token in this position in the URL of an MQTT
+ * connection over WebSocket. This flag is valid only for
+ * #SigV4HttpParameters_t.flags, and is only used by
+ * #SigV4_GeneratePresignedUrl.
+ */
+#define SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED    0x40U
+
 /**
  * @ingroup sigv4_enum_types
  * @brief Return status of the SigV4 Utility Library.
@@ -121,7 +200,41 @@ typedef enum SigV4Status
      *
      * Functions that may return this value:
      * - #SigV4_GenerateHTTPAuthorization
+     * - #SigV4_ResignHTTPAuthorization
+     * - #SigV4_GeneratePresignedUrl
+     * - #SigV4_PresignPoolInit
+     * - #SigV4_PresignPoolRefresh
+     * - #SigV4_PresignPoolGet
+     * - #SigV4_PresignTemplateInit
+     * - #SigV4_PresignTemplateSign
+     * - #SigV4_GenerateHTTPAuthorizationBatch
+     * - #SigV4_DeriveSigningKeys
+     * - #SigV4_PayloadHashInit
+     * - #SigV4_PayloadHashUpdate
+     * - #SigV4_PayloadHashFinal
+     * - #SigV4_ChunkSignerInit
+     * - #SigV4_SignChunk
+     * - #SigV4_SignChunkHash
+     * - #SigV4_HashChunks
+     * - #SigV4_ChunkHashJobInit
+     * - #SigV4_ChunkHashJobRun
+     * - #SigV4_ChunkHashJobResult
+     * - #SigV4_EventSignerInit
+     * - #SigV4_SignEvent
+     * - #SigV4_ParseCredentialsExpiration
+     * - #SigV4_CredentialsExpireWithin
+     * - #SigV4_CredentialStoreInit
+     * - #SigV4_CredentialStorePublish
+     * - #SigV4_CredentialStoreAcquire
+     * - #SigV4_CredentialStoreRelease
      * - #SigV4_AwsIotDateToIso8601
+     * - #SigV4_Sha256InitCryptoInterface
+     * - #SigV4_HashFile
+     * - #SigV4_Crc32cInit
+     * - #SigV4_Crc32cUpdate
+     * - #SigV4_Crc32cFinal
+     * - #SigV4_Crc32cChunkHeader
+     * - #SigV4_Crc32cTrailer
      */
     SigV4Success,
 
@@ -131,7 +244,41 @@ typedef enum SigV4Status
      *
      * Functions that may return this value:
      * - #SigV4_GenerateHTTPAuthorization
+     * - #SigV4_ResignHTTPAuthorization
+     * - #SigV4_GeneratePresignedUrl
+     * - #SigV4_PresignPoolInit
+     * - #SigV4_PresignPoolRefresh
+     * - #SigV4_PresignPoolGet
+     * - #SigV4_PresignTemplateInit
+     * - #SigV4_PresignTemplateSign
+     * - #SigV4_GenerateHTTPAuthorizationBatch
+     * - #SigV4_DeriveSigningKeys
+     * - #SigV4_PayloadHashInit
+     * - #SigV4_PayloadHashUpdate
+     * - #SigV4_PayloadHashFinal
+     * - #SigV4_ChunkSignerInit
+     * - #SigV4_SignChunk
+     * - #SigV4_SignChunkHash
+     * - #SigV4_HashChunks
+     * - #SigV4_ChunkHashJobInit
+     * - #SigV4_ChunkHashJobRun
+     * - #SigV4_ChunkHashJobResult
+     * - #SigV4_EventSignerInit
+     * - #SigV4_SignEvent
+     * - #SigV4_ParseCredentialsExpiration
+     * - #SigV4_CredentialsExpireWithin
+     * - #SigV4_CredentialStoreInit
+     * - #SigV4_CredentialStorePublish
+     * - #SigV4_CredentialStoreAcquire
+     * - #SigV4_CredentialStoreRelease
      * - #SigV4_AwsIotDateToIso8601
+     * - #SigV4_Sha256InitCryptoInterface
+     * - #SigV4_HashFile
+     * - #SigV4_Crc32cInit
+     * - #SigV4_Crc32cUpdate
+     * - #SigV4_Crc32cFinal
+     * - #SigV4_Crc32cChunkHeader
+     * - #SigV4_Crc32cTrailer
      */
     SigV4InvalidParameter,
 
@@ -141,6 +288,21 @@ typedef enum SigV4Status
      *
      * Functions that may return this value:
      * - #SigV4_GenerateHTTPAuthorization
+     * - #SigV4_ResignHTTPAuthorization
+     * - #SigV4_GeneratePresignedUrl
+     * - #SigV4_PresignPoolRefresh
+     * - #SigV4_PresignTemplateInit
+     * - #SigV4_PresignTemplateSign
+     * - #SigV4_GenerateHTTPAuthorizationBatch
+     * - #SigV4_DeriveSigningKeys
+     * - #SigV4_PayloadHashFinal
+     * - #SigV4_SignChunk
+     * - #SigV4_SignChunkHash
+     * - #SigV4_SignEvent
+     * - #SigV4_CredentialStorePublish
+     * - #SigV4_HashFile
+     * - #SigV4_Crc32cChunkHeader
+     * - #SigV4_Crc32cTrailer
      */
     SigV4InsufficientMemory,
 
@@ -149,8 +311,104 @@ typedef enum SigV4Status
      *
      * Functions that may return this value:
      * - #SigV4_AwsIotDateToIso8601
+     * - #SigV4_ParseCredentialsExpiration
+     * - #SigV4_CredentialStorePublish
+     */
+    SigV4ISOFormattingError,
+
+    /**
+     * @brief The maximum number of header parameters was exceeded while parsing
+     * the HTTP headers.
+     *
+     * Functions that may return this value:
+     * - #SigV4_GenerateHTTPAuthorization
+     */
+    SigV4MaxHeaderPairCountExceeded,
+
+    /**
+     * @brief The maximum number of query parameters was exceeded while parsing
+     * the query string.
+     *
+     * Functions that may return this value:
+     * - #SigV4_GenerateHTTPAuthorization
+     */
+    SigV4MaxQueryPairCountExceeded,
+
+    /**
+     * @brief A function of the #SigV4CryptoInterface_t returned a failure.
+     *
+     * Functions that may return this value:
+     * - #SigV4_GenerateHTTPAuthorization
+     * - #SigV4_ResignHTTPAuthorization
+     * - #SigV4_GeneratePresignedUrl
+     * - #SigV4_PresignPoolRefresh
+     * - #SigV4_PresignTemplateSign
+     * - #SigV4_GenerateHTTPAuthorizationBatch
+     * - #SigV4_DeriveSigningKeys
+     * - #SigV4_PayloadHashInit
+     * - #SigV4_PayloadHashUpdate
+     * - #SigV4_PayloadHashFinal
+     * - #SigV4_ChunkSignerInit
+     * - #SigV4_SignChunk
+     * - #SigV4_SignChunkHash
+     * - #SigV4_HashChunks
+     * - #SigV4_ChunkHashJobRun
+     * - #SigV4_ChunkHashJobResult
+     * - #SigV4_EventSignerInit
+     * - #SigV4_SignEvent
+     * - #SigV4_HashFile
      */
-    SigV4ISOFormattingError
+    SigV4HashError,
+
+    /**
+     * @brief A file could not be opened or mapped.
+     *
+     * Functions that may return this value:
+     * - #SigV4_HashFile
+     */
+    SigV4FileError,
+
+    /**
+     * @brief The presign pool holds no URL for the given time.
+     *
+     * Functions that may return this value:
+     * - #SigV4_PresignPoolGet
+     */
+    SigV4PresignedUrlUnavailable,
+
+    /**
+     * @brief No credentials were published to the credential store yet.
+     *
+     * Functions that may return this value:
+     * - #SigV4_CredentialStoreAcquire
+     */
+    SigV4CredentialsUnavailable,
+
+    /**
+     * @brief Credentials published before the current ones are still
+     * acquired, so their memory cannot be reused yet.
+     *
+     * Functions that may return this value:
+     * - #SigV4_CredentialStorePublish
+     */
+    SigV4CredentialsInUse,
+
+    /**
+     * @brief The credentials expire within the given number of seconds, or
+     * have expired.
+     *
+     * Functions that may return this value:
+     * - #SigV4_CredentialsExpireWithin
+     */
+    SigV4CredentialsExpiring,
+
+    /**
+     * @brief Some chunks of the chunk hash job are not hashed yet.
+     *
+     * Functions that may return this value:
+     * - #SigV4_ChunkHashJobResult
+     */
+    SigV4ChunkHashesPending
 } SigV4Status_t;
 
 /**
@@ -205,6 +463,62 @@ typedef struct SigV4CryptoInterface
      * @brief Context for the hashInit, hashUpdate, and hashFinal interfaces.
      */
     void * pHashContext;
+
+    /**
+     * @brief The block length of the hash function, used to pad the HMAC
+     * key. This is 64 for SHA256.
+     *
+     * It must be at least #SIGV4_HASH_DIGEST_LENGTH and at most
+     * #SIGV4_HASH_MAX_BLOCK_LENGTH. Zero is taken as 64, so an interface
+     * that only sets the members before this one hashes with SHA256 block
+     * lengths.
+     */
+    size_t hashBlockLen;
+
+    /**
+     * @brief Copies the state of a hash context to another context of the
+     * same type.
+     *
+     * This is optional and can be NULL. When it is provided, together with
+     * storage in #SigV4SigningKeyCache_t, the library saves the HMAC inner
+     * and outer hash states of the cached signing key after the padded key
+     * block has been hashed, and restores them for every later signature
+     * instead of hashing that block again.
+     *
+     * @param[out] pDestContext Context to copy the hash state to.
+     * @param[in] pSrcContext Context to copy the hash state from.
+     *
+     * @return Zero on success, all other return values are failures.
+     */
+    int32_t ( * hashCopyContext )( void * pDestContext,
+                                   const void * pSrcContext );
+
+    /**
+     * @brief Calculates the binary digests of several independent messages,
+     * for example with a multi-buffer implementation that hashes them in
+     * parallel.
+     *
+     * This is optional and can be NULL. When it is provided,
+     * #SigV4_GenerateHTTPAuthorizationBatch hashes the payloads of up to
+     * #SIGV4_HASH_MULTIPLE_MAX_COUNT requests with one call, and
+     * #SigV4_DeriveSigningKeys derives the signing keys of up to that many
+     * regions together. It may use @p pHashContext, so it must not be called
+     * during another hash computation.
+     *
+     * @param[in] pHashContext The context of the other hash functions.
+     * @param[in] pInputs The messages to hash.
+     * @param[in] pInputLens The length of each message.
+     * @param[out] pDigests The buffer receiving the @p count digests, each
+     * #SIGV4_HASH_DIGEST_LENGTH bytes long, one after another.
+     * @param[in] count The number of messages.
+     *
+     * @return Zero on success, all other return values are failures.
+     */
+    int32_t ( * hashMultiple )( void * pHashContext,
+                                const uint8_t * const * pInputs,
+                                const size_t * pInputLens,
+                                uint8_t * pDigests,
+                                size_t count );
 } SigV4CryptoInterface_t;
 
 /**
@@ -227,6 +541,9 @@ typedef struct SigV4HttpParameters
      * - #SIGV4_HTTP_QUERY_IS_CANONICAL_FLAG    0x2
      * - #SIGV4_HTTP_HEADERS_ARE_CANONICAL_FLAG 0x4
      * - #SIGV4_HTTP_ALL_ARE_CANONICAL_FLAG     0x8
+     * - #SIGV4_HTTP_PAYLOAD_IS_HASH            0x10
+     * - #SIGV4_HTTP_PAYLOAD_IS_UNSIGNED        0x20
+     * - #SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED 0x40
      */
     uint32_t flags;
 
@@ -261,10 +578,23 @@ typedef struct SigV4HttpParameters
     /**
      * @brief The HTTP response body, if one exists (ex. PUT request). If this
      * body is chunked, then this field should be set with
-     * STREAMING-AWS4-HMAC-SHA256-PAYLOAD.
+     * STREAMING-AWS4-HMAC-SHA256-PAYLOAD. If #SIGV4_HTTP_PAYLOAD_IS_HASH is
+     * set, then this is the hex-encoded hash of the body, which is signed as
+     * is. If #SIGV4_HTTP_PAYLOAD_IS_UNSIGNED is set, then this is ignored.
      */
     const char * pPayload;
     size_t payloadLen; /**< @brief Length of pPayload. */
+
+    /**
+     * @brief Identifies the contents of pPayload for
+     * #SigV4Parameters_t.pPayloadHashCache, or 0 if its hash must not be
+     * cached.
+     *
+     * The cache finds a payload by its location, length and generation, and
+     * never reads the payload to compare it. The application must change the
+     * generation whenever it writes new contents to the same location.
+     */
+    uint32_t payloadGeneration;
 } SigV4HttpParameters_t;
 
 /**
@@ -301,8 +631,167 @@ typedef struct SigV4Credentials
      */
     const char * pExpiration;
     size_t expirationLen; /**< @brief Length of pExpiration. */
+
+    /**
+     * @brief The expiration time in seconds since the Unix epoch, or 0 if the
+     * credentials do not expire. This is set from pExpiration by
+     * #SigV4_ParseCredentialsExpiration, so that #SigV4_CredentialsExpireWithin
+     * does not parse the date again.
+     */
+    uint64_t expirationTime;
 } SigV4Credentials_t;
 
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Cache of the most recently derived signing key.
+ *
+ * The signing key depends only on the secret access key and on the date,
+ * region and service of the credential scope, so it changes at most once per
+ * UTC day for a given region and service. Passing a cache through
+ * #SigV4Parameters_t.pSigningKeyCache saves the four HMAC operations of the
+ * key derivation on every request signed with the same scope.
+ *
+ * The cache must be zero-initialized, apart from the optional hash state
+ * storage, before its first use. It holds a copy of the secret access key and
+ * the derived key, so it must be protected like the credentials themselves.
+ * The library does not serialize access to the cache; the application must
+ * not use one cache from several threads at once.
+ */
+typedef struct SigV4SigningKeyCache
+{
+    /**
+     * @brief Identifies the cached key: the credential scope date, region and
+     * service, followed by the secret access key.
+     */
+    char pTag[ SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH ];
+    size_t tagLen;     /**< @brief Length of pTag, or 0 if no key is cached. */
+    size_t regionLen;  /**< @brief Length of the region in pTag. */
+    size_t serviceLen; /**< @brief Length of the service in pTag. */
+
+    /**
+     * @brief The cached signing key.
+     */
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    /**
+     * @brief Optional storage for the HMAC inner hash state of the cached
+     * key, of the same type as #SigV4CryptoInterface_t.pHashContext. This
+     * can be NULL.
+     *
+     * The inner and outer hash states are only saved and used if both are
+     * provided and #SigV4CryptoInterface_t.hashCopyContext is set.
+     */
+    void * pInnerHashContext;
+
+    /**
+     * @brief Optional storage for the HMAC outer hash state of the cached
+     * key. See #SigV4SigningKeyCache_t.pInnerHashContext.
+     */
+    void * pOuterHashContext;
+
+    /**
+     * @brief 1 if pInnerHashContext and pOuterHashContext hold the hash
+     * states of the cached key, 0 otherwise.
+     */
+    uint8_t hashContextsSaved;
+
+    uint32_t hitCount;  /**< @brief Number of signatures that reused the cached key. */
+    uint32_t missCount; /**< @brief Number of signatures that derived the key. */
+} SigV4SigningKeyCache_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Snapshot of a signed request, from which
+ * #SigV4_ResignHTTPAuthorization signs the request again with another date.
+ *
+ * A retried request keeps its method, path, query, headers and payload, and
+ * only changes its x-amz-date header. When #SigV4Parameters_t.pRetrySnapshot
+ * points to a snapshot, #SigV4_GenerateHTTPAuthorization saves the hash state
+ * of the canonical request just before the value of that header, and the
+ * rest of the canonical request, which ends with the payload hash. Signing
+ * the retry then hashes only that rest, instead of the whole canonical
+ * request and the payload.
+ *
+ * A snapshot is only saved if #SigV4CryptoInterface_t.hashCopyContext is
+ * set, the request has an x-amz-date header equal to
+ * #SigV4Parameters_t.pDateIso8601, and the rest of the canonical request fits
+ * in #SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH bytes.
+ *
+ * An x-amz-security-token header whose value is the security token of
+ * #SigV4Parameters_t.pCredentials is not copied to pSuffix: its position is
+ * recorded, and the token of the credentials of the retry is hashed there,
+ * so it does not count towards #SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH.
+ */
+typedef struct SigV4RetrySnapshot
+{
+    /**
+     * @brief Storage for the saved hash state, of the same type as
+     * #SigV4CryptoInterface_t.pHashContext.
+     */
+    void * pHashContext;
+
+    /**
+     * @brief The canonical request from the value of the x-amz-date header
+     * on.
+     */
+    char pSuffix[ SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH ];
+    size_t suffixLen; /**< @brief Length of pSuffix, or 0 if no snapshot is saved. */
+
+    /**
+     * @brief Offset in pSuffix at which the security token of the
+     * credentials belongs, if tokenLen is not 0.
+     */
+    size_t tokenOffset;
+    size_t tokenLen; /**< @brief Length of the security token left out of pSuffix, or 0 if none is. */
+} SigV4RetrySnapshot_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief An entry of a #SigV4PayloadHashCache_t.
+ */
+typedef struct SigV4PayloadHashCacheEntry
+{
+    const char * pPayload; /**< @brief Location of the payload. */
+    size_t payloadLen;     /**< @brief Length of the payload. */
+    uint32_t generation;   /**< @brief Generation of the payload, or 0 if the entry is empty. */
+
+    /**
+     * @brief 1 if the entry was used since the clock hand last passed it, 0
+     * otherwise.
+     */
+    uint8_t referenced;
+
+    /**
+     * @brief The hex-encoded hash of the payload.
+     */
+    char pHexPayloadHash[ SIGV4_HEX_PAYLOAD_HASH_LENGTH ];
+} SigV4PayloadHashCacheEntry_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Cache of the hashes of recently signed payloads.
+ *
+ * The same payload is often signed several times: a retried request, a
+ * payload sent to several regions, or an idempotent PUT. Passing a cache
+ * through #SigV4Parameters_t.pPayloadHashCache saves hashing a payload whose
+ * #SigV4HttpParameters_t.payloadGeneration is not 0 when it is signed again.
+ *
+ * Entries are replaced with the CLOCK algorithm: a hand sweeps the entries,
+ * giving a second chance to those used since it last passed them. The cache
+ * must be zero-initialized before its first use. The library does not
+ * serialize access to the cache; the application must not use one cache from
+ * several threads at once.
+ */
+typedef struct SigV4PayloadHashCache
+{
+    SigV4PayloadHashCacheEntry_t pEntries[ SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT ]; /**< @brief The cached payload hashes. */
+    size_t clockHand;                                                             /**< @brief Index of the next entry considered for replacement. */
+
+    uint32_t hitCount;      /**< @brief Number of payloads whose hash was found in the cache. */
+    uint32_t missCount;     /**< @brief Number of payloads that were hashed and added to the cache. */
+    uint32_t evictionCount; /**< @brief Number of entries replaced by the hash of another payload. */
+} SigV4PayloadHashCache_t;
+
 /**
  * @ingroup sigv4_struct_types
  * @brief Complete configurations required for generating "String to Sign" and
@@ -352,12 +841,323 @@ typedef struct SigV4Parameters
     /**
      * @brief HTTP specific SigV4 parameters for canonical request calculation.
      */
-    SigV4HttpParameters_t * pHttpParameters;
+    const SigV4HttpParameters_t * pHttpParameters;
+
+    /**
+     * @brief Optional cache of the signing key. This can be NULL, in which
+     * case the signing key is derived for every request.
+     */
+    SigV4SigningKeyCache_t * pSigningKeyCache;
+
+    /**
+     * @brief Optional snapshot that #SigV4_GenerateHTTPAuthorization saves
+     * and #SigV4_ResignHTTPAuthorization signs a retry from. This can be
+     * NULL.
+     */
+    SigV4RetrySnapshot_t * pRetrySnapshot;
+
+    /**
+     * @brief Optional cache of payload hashes. This can be NULL, in which
+     * case the payload is hashed for every request.
+     *
+     * The payloads that #SigV4_GenerateHTTPAuthorizationBatch hashes together
+     * with #SigV4CryptoInterface_t.hashMultiple are not cached.
+     */
+    SigV4PayloadHashCache_t * pPayloadHashCache;
 } SigV4Parameters_t;
 
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Output of one request of #SigV4_GenerateHTTPAuthorizationBatch.
+ */
+typedef struct SigV4Authorization
+{
+    char * pAuthBuf; /**< @brief Buffer to hold the generated Authorization header value. */
+
+    /**
+     * @brief Input: the length of pAuthBuf, output: the length of the
+     * Authorization value written to the buffer.
+     */
+    size_t authBufLen;
+
+    char * pSignature;    /**< @brief Output: location of the signature in pAuthBuf. */
+    size_t signatureLen;  /**< @brief Output: the length of pSignature. */
+    SigV4Status_t status; /**< @brief Output: the result of signing this request. */
+} SigV4Authorization_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief State of a payload hash computed incrementally with
+ * #SigV4_PayloadHashInit, #SigV4_PayloadHashUpdate and
+ * #SigV4_PayloadHashFinal.
+ */
+typedef struct SigV4PayloadHash
+{
+    /**
+     * @brief The cryptography interface whose hash context holds the state.
+     * It must not be used for anything else until #SigV4_PayloadHashFinal.
+     */
+    const SigV4CryptoInterface_t * pCryptoInterface;
+
+    uint64_t payloadLen; /**< @brief Number of payload bytes hashed so far. */
+} SigV4PayloadHash_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief State of the chunk signature chain of an aws-chunked upload, signed
+ * with #SigV4_ChunkSignerInit and #SigV4_SignChunk.
+ *
+ * It holds the signing key of the request, so it must be protected like the
+ * credentials themselves.
+ */
+typedef struct SigV4ChunkSigner
+{
+    /**
+     * @brief The parameters of the request, or NULL once the final chunk is
+     * signed. They must remain valid until then.
+     */
+    const SigV4Parameters_t * pParams;
+
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ]; /**< @brief The signing key of the request. */
+
+    /**
+     * @brief The seed signature, then the signature of the last chunk signed.
+     */
+    char pPreviousSignature[ SIGV4_HEX_SIGNATURE_LENGTH ];
+
+    char pEmptyHash[ SIGV4_HEX_PAYLOAD_HASH_LENGTH ]; /**< @brief The hex-encoded hash of an empty string. */
+} SigV4ChunkSigner_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief The chunks of an aws-chunked upload, hashed together by application
+ * threads, set up with #SigV4_ChunkHashJobInit.
+ *
+ * Each thread that calls #SigV4_ChunkHashJobRun claims groups of up to
+ * #SIGV4_HASH_MULTIPLE_MAX_COUNT chunks until none is left. Once
+ * #SigV4_ChunkHashJobResult reports that every chunk is hashed, the signature
+ * chain is signed in order with #SigV4_SignChunkHash.
+ */
+typedef struct SigV4ChunkHashJob
+{
+    const char * const * pChunks; /**< @brief The chunk data. */
+    const size_t * pChunkLens;    /**< @brief The length of each chunk. */
+
+    /**
+     * @brief The hex-encoded hash of each chunk, of
+     * #SIGV4_HEX_PAYLOAD_HASH_LENGTH characters, one after another.
+     */
+    char * pHexChunkHashes;
+
+    size_t chunkCount;     /**< @brief The number of chunks. */
+    uint32_t groupCount;   /**< @brief The number of groups of chunks. */
+    uint32_t nextGroup;    /**< @brief The next group to claim, shared between the threads. */
+    uint32_t hashedGroups; /**< @brief The number of groups hashed, shared between the threads. */
+    uint32_t failed;       /**< @brief 1 once a thread failed to hash its group, 0 otherwise. */
+} SigV4ChunkHashJob_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief State of the signature chain of an event stream, signed with
+ * #SigV4_EventSignerInit and #SigV4_SignEvent.
+ *
+ * It holds a signing key, so it must be protected like the credentials
+ * themselves.
+ */
+typedef struct SigV4EventSigner
+{
+    /**
+     * @brief The parameters of the request that opened the stream. They must
+     * remain valid while events are signed.
+     */
+    const SigV4Parameters_t * pParams;
+
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ]; /**< @brief The signing key for the date of pKeyDate. */
+
+    char pKeyDate[ SIGV4_ISO_STRING_LEN ]; /**< @brief The ISO 8601 date that the signing key was derived for. */
+
+    /**
+     * @brief The seed signature, then the signature of the last event signed.
+     */
+    char pPreviousSignature[ SIGV4_HEX_SIGNATURE_LENGTH ];
+} SigV4EventSigner_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief A presigned URL of a #SigV4PresignPool_t, for one time window.
+ */
+typedef struct SigV4PresignedWindow
+{
+    uint64_t windowStart; /**< @brief Start of the window, in seconds since the Unix epoch. The URL is signed at this time. */
+    size_t queryLen;      /**< @brief Length of pQuery. */
+
+    /**
+     * @brief The query string generated by #SigV4_GeneratePresignedUrl.
+     */
+    char pQuery[ SIGV4_PRESIGN_POOL_QUERY_LENGTH ];
+} SigV4PresignedWindow_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Presigned URLs generated ahead of time for consecutive time windows.
+ *
+ * Time is divided into windows of windowSeconds. A background task of the
+ * application calls #SigV4_PresignPoolRefresh regularly to keep the URLs of
+ * the current and next windows ready, so that connecting only takes
+ * #SigV4_PresignPoolGet, which reads which URLs are ready with a single
+ * #SIGV4_ATOMIC_LOAD_U32.
+ *
+ * A pool holds the URLs of one endpoint signed with one set of credentials.
+ * It must be set up with #SigV4_PresignPoolInit, and set up again when the
+ * credentials change. Only one task may refresh a pool, but any number of
+ * tasks may get URLs from it at the same time. A URL that was obtained must
+ * be used within one window, as its memory is then reused.
+ */
+typedef struct SigV4PresignPool
+{
+    uint32_t windowSeconds;                                           /**< @brief Length of each window. */
+    SigV4PresignedWindow_t pWindows[ SIGV4_PRESIGN_POOL_SLOT_COUNT ]; /**< @brief The URLs. */
+
+    /**
+     * @brief Which windows hold the URLs of the current and next windows,
+     * written with #SIGV4_ATOMIC_STORE_U32 once the URLs are complete.
+     */
+    uint32_t published;
+} SigV4PresignPool_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief A set of credentials of a #SigV4CredentialStore_t.
+ */
+typedef struct SigV4CredentialSlot
+{
+    /**
+     * @brief The credentials, which point into pData.
+     */
+    SigV4Credentials_t credentials;
+
+    /**
+     * @brief Number of tasks that acquired the credentials and did not
+     * release them yet, updated with #SIGV4_ATOMIC_INCREMENT_U32 and
+     * #SIGV4_ATOMIC_DECREMENT_U32.
+     */
+    uint32_t readerCount;
+
+    /**
+     * @brief Copy of the access key ID, secret access key, security token and
+     * expiration of the credentials.
+     */
+    char pData[ SIGV4_CREDENTIAL_STORE_SLOT_LENGTH ];
+} SigV4CredentialSlot_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief Credentials shared by signing tasks while they are rotated.
+ *
+ * #SigV4Credentials_t only points to the credential strings, which must not
+ * change while a request is signed. A store keeps its own copy of the
+ * credentials in two slots instead. #SigV4_CredentialStorePublish writes new
+ * credentials, such as temporary credentials obtained before the current
+ * ones expire, to the slot that is not published, then publishes it by
+ * incrementing the epoch. Signing tasks take the published credentials with
+ * #SigV4_CredentialStoreAcquire and give them back with
+ * #SigV4_CredentialStoreRelease, without locks.
+ *
+ * The slot of an epoch is only written again two epochs later, once every
+ * task that acquired it has released it. A #SigV4SigningKeyCache_t compares
+ * the secret access key, so the signing keys derived from rotated
+ * credentials are not reused.
+ *
+ * A store must be set up with #SigV4_CredentialStoreInit. Only one task may
+ * publish credentials, but any number of tasks may acquire them at the same
+ * time. The store holds secret keys, so it must be protected like the
+ * credentials themselves.
+ */
+typedef struct SigV4CredentialStore
+{
+    SigV4CredentialSlot_t pSlots[ SIGV4_CREDENTIAL_STORE_SLOT_COUNT ]; /**< @brief The credentials. */
+
+    /**
+     * @brief Number of credential sets published, or 0 if none is. The
+     * published credentials are in slot epoch % #SIGV4_CREDENTIAL_STORE_SLOT_COUNT.
+     */
+    uint32_t epoch;
+} SigV4CredentialStore_t;
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief The parts of presigned URLs that are the same for every object key,
+ * compiled once by #SigV4_PresignTemplateInit.
+ *
+ * Presigned URLs of objects under the same path prefix, such as S3 objects
+ * of one bucket, differ only by the end of their path. They share the query
+ * string, the canonical headers, the credential scope and the signing key.
+ * #SigV4_PresignTemplateSign then only URI-encodes the object key and
+ * finishes the canonical request hash from the state saved after the prefix.
+ *
+ * pHashContext must be set before #SigV4_PresignTemplateInit, and
+ * #SigV4CryptoInterface_t.hashCopyContext must be set. A template can be
+ * compiled again, with other parameters, without clearing it.
+ */
+typedef struct SigV4PresignTemplate
+{
+    /**
+     * @brief Storage for the hash state of the canonical request up to the
+     * object key, of the same type as #SigV4CryptoInterface_t.pHashContext.
+     */
+    void * pHashContext;
+
+    /**
+     * @brief The signing key of the URLs. Its
+     * #SigV4SigningKeyCache_t.pInnerHashContext and
+     * #SigV4SigningKeyCache_t.pOuterHashContext can be set before
+     * #SigV4_PresignTemplateInit, so that the HMAC of each URL starts from the
+     * saved states of the key.
+     */
+    SigV4SigningKeyCache_t signingKey;
+
+    /**
+     * @brief The hash functions the template was compiled with, or NULL if it
+     * was not compiled.
+     */
+    SigV4CryptoInterface_t * pCryptoInterface;
+
+    uint8_t keyEncoding;          /**< @brief How many times object keys are URI-encoded. */
+    size_t stringToSignPrefixLen; /**< @brief Length of the string to sign before the canonical request hash. */
+    size_t queryLen;              /**< @brief Length of the query string before the signature. */
+    size_t canonicalSuffixLen;    /**< @brief Length of the canonical request after the path. */
+    size_t unsignedTokenLen;      /**< @brief Length of the security token parameter after the signature. */
+
+    /**
+     * @brief The start of the string to sign, followed by the canonical
+     * request after the path, which starts with a linefeed and the query
+     * string, then by the unsigned security token parameter, if any.
+     */
+    char pData[ SIGV4_PRESIGN_TEMPLATE_LENGTH ];
+} SigV4PresignTemplate_t;
+
 /**
  * @brief Generates the HTTP Authorization header value.
  *
+ * The canonical request, string to sign and signature are produced in a single
+ * forward pass over the request. The header and query locations are sorted in
+ * place, and the canonical request is passed to the hash through a stack
+ * buffer of #SIGV4_PROCESSING_BUFFER_LENGTH bytes as it is generated, so no
+ * heap memory is used and memory use does not grow with the size of the
+ * request. The string to sign must fit in that buffer.
+ *
+ * The generated value has the form:
+ * @code
+ * AWS4-HMAC-SHA256 Credential=<AccessKeyId>/<YYYYMMDD>/<Region>/<Service>/aws4_request, SignedHeaders=<SignedHeaders>, Signature=<Signature>
+ * @endcode
+ *
+ * Unless #SIGV4_HTTP_HEADERS_ARE_CANONICAL_FLAG is set, the headers are
+ * expected in raw HTTP form, with each "Name: value" line terminated by
+ * "\r\n". Unless #SIGV4_HTTP_QUERY_IS_CANONICAL_FLAG is set, the query keys
+ * and values are URI-encoded by the library, so they must not already be
+ * encoded. The request path is URI-encoded twice, as required by SigV4, for
+ * every service except S3.
+ *
  * @param[in] pParams Parameters for generating the SigV4 signature.
  * @param[out] pAuthBuf Buffer to hold the generated Authorization header value.
  * @param[in, out] authBufLen Input: the length of pAuthBuf, output: the length
@@ -366,6 +1166,19 @@ typedef struct SigV4Parameters
  * @param[out] signatureLen The length of pSignature.
  *
  * @return #SigV4Success if successful, error code otherwise.
+ * <br>
+ * #SigV4InvalidParameter if a required parameter is NULL or empty.
+ * <br>
+ * #SigV4InsufficientMemory if the string to sign does not fit in the
+ * processing buffer, or the Authorization value does not fit in @p pAuthBuf.
+ * <br>
+ * #SigV4MaxHeaderPairCountExceeded if there are more than
+ * #SIGV4_MAX_HTTP_HEADER_COUNT headers.
+ * <br>
+ * #SigV4MaxQueryPairCountExceeded if there are more than
+ * #SIGV4_MAX_QUERY_PAIR_COUNT query pairs.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
  */
 /* @[declare_sigV4_generateHTTPAuthorization_function] */
 SigV4Status_t SigV4_GenerateHTTPAuthorization( const SigV4Parameters_t * pParams,
@@ -375,6 +1188,800 @@ SigV4Status_t SigV4_GenerateHTTPAuthorization( const SigV4Parameters_t * pParams
                                                size_t * signatureLen );
 /* @[declare_sigV4_generateHTTPAuthorization_function] */
 
+/**
+ * @brief Generates the HTTP Authorization header value of a retried request
+ * from the snapshot saved when it was first signed.
+ *
+ * The retry must only differ from the request given to
+ * #SigV4_GenerateHTTPAuthorization by its date: its x-amz-date header must
+ * be set to #SigV4Parameters_t.pDateIso8601. The hash state saved in
+ * #SigV4Parameters_t.pRetrySnapshot is restored, and only the new date and
+ * the rest of the saved canonical request are hashed.
+ * #SigV4Parameters_t.pHttpParameters is ignored. The snapshot is not changed,
+ * so it can be used for several retries.
+ *
+ * If the snapshot left out the security token of the first request, the
+ * x-amz-security-token header of the retry must hold the security token of
+ * #SigV4Parameters_t.pCredentials, so that rotated session credentials can
+ * be used for the retry.
+ *
+ * @param[in] pParams Parameters of the retry, with the snapshot.
+ * @param[out] pAuthBuf Buffer to hold the generated Authorization header value.
+ * @param[in, out] authBufLen Input: the length of pAuthBuf, output: the length
+ * of the authorization value written to the buffer.
+ * @param[out] pSignature Location of the signature in the authorization string.
+ * @param[out] signatureLen The length of pSignature.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ * <br>
+ * #SigV4InvalidParameter if a required parameter is NULL or empty, no
+ * snapshot is saved in #SigV4Parameters_t.pRetrySnapshot, or the snapshot
+ * left out a security token and #SigV4Parameters_t.pCredentials has none.
+ * <br>
+ * #SigV4InsufficientMemory if the Authorization value does not fit in
+ * @p pAuthBuf.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_resignHTTPAuthorization_function] */
+SigV4Status_t SigV4_ResignHTTPAuthorization( const SigV4Parameters_t * pParams,
+                                             char * pAuthBuf,
+                                             size_t * authBufLen,
+                                             char ** pSignature,
+                                             size_t * signatureLen );
+/* @[declare_sigV4_resignHTTPAuthorization_function] */
+
+/**
+ * @brief Generates the query string of a presigned URL, which carries the
+ * signature of the request in place of an Authorization header.
+ *
+ * The query string is written to @p pQueryBuf in one pass, in canonical
+ * order, and the same bytes are signed as the canonical query. It has the
+ * form:
+ * @code
+ * X-Amz-Algorithm=AWS4-HMAC-SHA256&X-Amz-Credential=<AccessKeyId>%2F<YYYYMMDD>%2F<Region>%2F<Service>%2Faws4_request&X-Amz-Date=<Date>&X-Amz-Expires=<Seconds>[&X-Amz-Security-Token=<Token>]&X-Amz-SignedHeaders=<SignedHeaders>&X-Amz-Signature=<Signature>
+ * @endcode
+ *
+ * The security token is only present if
+ * #SigV4Credentials_t.pSecurityToken is set. If
+ * #SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED is set, it follows the signature
+ * instead, as AWS IoT expects for MQTT over WebSocket. For example, the URL
+ * of an AWS IoT MQTT connection is "wss://<Endpoint>/mqtt?" followed by the
+ * query string, signed for the "iotdevicegateway" service with a "GET"
+ * method, a "/mqtt" path and a "host" header.
+ *
+ * #SigV4HttpParameters_t.pQuery is placed in the query string around the
+ * X-Amz- parameters and signed as is, so it must already be in canonical
+ * form and must not contain X-Amz- parameters of its own. The headers and
+ * payload are signed as by #SigV4_GenerateHTTPAuthorization.
+ * #SigV4Parameters_t.pRetrySnapshot is ignored.
+ *
+ * @param[in] pParams Parameters for generating the SigV4 signature.
+ * @param[in] expiresSeconds How long the URL is valid for, from 1 to
+ * #SIGV4_PRESIGNED_URL_EXPIRES_MAX seconds.
+ * @param[out] pQueryBuf Buffer to hold the generated query string.
+ * @param[in, out] queryBufLen Input: the length of pQueryBuf, output: the
+ * length of the query string written to the buffer.
+ * @param[out] pSignature Location of the signature in the query string.
+ * @param[out] signatureLen The length of pSignature.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ * <br>
+ * #SigV4InvalidParameter if a required parameter is NULL or empty,
+ * @p expiresSeconds is out of range, or the query already contains X-Amz-
+ * parameters.
+ * <br>
+ * #SigV4InsufficientMemory if the query string does not fit in
+ * @p pQueryBuf, or the string to sign does not fit in the processing buffer.
+ * <br>
+ * #SigV4MaxHeaderPairCountExceeded if there are more than
+ * #SIGV4_MAX_HTTP_HEADER_COUNT headers.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_generatePresignedUrl_function] */
+SigV4Status_t SigV4_GeneratePresignedUrl( const SigV4Parameters_t * pParams,
+                                          uint32_t expiresSeconds,
+                                          char * pQueryBuf,
+                                          size_t * queryBufLen,
+                                          char ** pSignature,
+                                          size_t * signatureLen );
+/* @[declare_sigV4_generatePresignedUrl_function] */
+
+/**
+ * @brief Set up an empty presign pool.
+ *
+ * @param[out] pPool The pool.
+ * @param[in] windowSeconds Length of each window, from 1 to half of
+ * #SIGV4_PRESIGNED_URL_EXPIRES_MAX. Each URL is valid for two windows from the
+ * start of its own, so a URL obtained at the end of its window is still valid
+ * for a whole window.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if @p pPool is
+ * NULL or @p windowSeconds is out of range.
+ */
+/* @[declare_sigV4_presignPoolInit_function] */
+SigV4Status_t SigV4_PresignPoolInit( SigV4PresignPool_t * pPool,
+                                     uint32_t windowSeconds );
+/* @[declare_sigV4_presignPoolInit_function] */
+
+/**
+ * @brief Generate the presigned URLs of the window holding @p currentTime and
+ * of the next window, unless they are already in the pool.
+ *
+ * Usually, only the URL of the next window is generated, once per window.
+ * The URLs are generated with #SigV4_GeneratePresignedUrl, dated at the
+ * start of their window. #SigV4Parameters_t.pDateIso8601 is ignored.
+ *
+ * A slot that was published when the call started is not written again
+ * before the next call, as tasks may still read it. After a pause longer than
+ * a window, only the URL of the current window can be generated, and the
+ * URL of the next window is generated by the next call.
+ *
+ * @param[in, out] pPool The pool.
+ * @param[in] pParams Parameters of the URL.
+ * @param[in] currentTime The time, in seconds since the Unix epoch.
+ *
+ * @return #SigV4Success if successful, error code of
+ * #SigV4_GeneratePresignedUrl otherwise. #SigV4InvalidParameter is also
+ * returned if the pool was not set up, or @p currentTime is after the year
+ * 9999. URLs that were already generated stay in the pool after an error.
+ */
+/* @[declare_sigV4_presignPoolRefresh_function] */
+SigV4Status_t SigV4_PresignPoolRefresh( SigV4PresignPool_t * pPool,
+                                        const SigV4Parameters_t * pParams,
+                                        uint64_t currentTime );
+/* @[declare_sigV4_presignPoolRefresh_function] */
+
+/**
+ * @brief Get the presigned URL of the window holding @p currentTime.
+ *
+ * This does not wait for #SigV4_PresignPoolRefresh, and can be called while
+ * it runs.
+ *
+ * @param[in] pPool The pool.
+ * @param[in] currentTime The time, in seconds since the Unix epoch.
+ * @param[out] pQuery The query string of the URL, in the pool.
+ * @param[out] queryLen The length of @p pQuery.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is NULL, #SigV4PresignedUrlUnavailable if the URL of the window was not
+ * generated.
+ */
+/* @[declare_sigV4_presignPoolGet_function] */
+SigV4Status_t SigV4_PresignPoolGet( const SigV4PresignPool_t * pPool,
+                                    uint64_t currentTime,
+                                    const char ** pQuery,
+                                    size_t * queryLen );
+/* @[declare_sigV4_presignPoolGet_function] */
+
+/**
+ * @brief Compile the parts of presigned URLs that do not depend on the
+ * object key into a template.
+ *
+ * The path of #SigV4Parameters_t.pHttpParameters is the prefix shared by the
+ * objects, such as "/examplebucket/photos/", to which each object key is
+ * appended as is. An empty path is the prefix "/". The other parameters are
+ * those of #SigV4_GeneratePresignedUrl.
+ *
+ * @param[in, out] pTemplate The template, whose pHashContext is set.
+ * @param[in] pParams Parameters of the URLs.
+ * @param[in] expiresSeconds Number of seconds the URLs are valid for, from 1
+ * to #SIGV4_PRESIGNED_URL_EXPIRES_MAX.
+ *
+ * @return #SigV4Success if successful, error code of
+ * #SigV4_GeneratePresignedUrl otherwise. #SigV4InvalidParameter is also
+ * returned if @p pTemplate, its pHashContext, or
+ * #SigV4CryptoInterface_t.hashCopyContext is NULL, and
+ * #SigV4InsufficientMemory if the template does not fit in
+ * #SIGV4_PRESIGN_TEMPLATE_LENGTH bytes.
+ */
+/* @[declare_sigV4_presignTemplateInit_function] */
+SigV4Status_t SigV4_PresignTemplateInit( SigV4PresignTemplate_t * pTemplate,
+                                         const SigV4Parameters_t * pParams,
+                                         uint32_t expiresSeconds );
+/* @[declare_sigV4_presignTemplateInit_function] */
+
+/**
+ * @brief Generate the query string of the presigned URL of an object key
+ * from a template.
+ *
+ * The result is the one of #SigV4_GeneratePresignedUrl with the object key
+ * appended to the path of the template, but the key is the only input that
+ * is encoded and hashed.
+ *
+ * @param[in] pTemplate The template compiled by #SigV4_PresignTemplateInit.
+ * @param[in] pKey The object key, appended to the path prefix of the template.
+ * @param[in] keyLen Length of @p pKey.
+ * @param[out] pQueryBuf Buffer receiving the query string of the URL.
+ * @param[in, out] queryBufLen Input: the length of @p pQueryBuf. Output: the
+ * length of the query string written.
+ * @param[out] pSignature Location of the signature in @p pQueryBuf.
+ * @param[out] signatureLen Length of @p pSignature.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is NULL or the template was not compiled, #SigV4InsufficientMemory if
+ * @p pQueryBuf is too small, #SigV4HashError if the #SigV4CryptoInterface_t
+ * reported an error.
+ */
+/* @[declare_sigV4_presignTemplateSign_function] */
+SigV4Status_t SigV4_PresignTemplateSign( const SigV4PresignTemplate_t * pTemplate,
+                                         const char * pKey,
+                                         size_t keyLen,
+                                         char * pQueryBuf,
+                                         size_t * queryBufLen,
+                                         char ** pSignature,
+                                         size_t * signatureLen );
+/* @[declare_sigV4_presignTemplateSign_function] */
+
+/**
+ * @brief Generates the HTTP Authorization header values of several requests
+ * that share the credentials, date, region and service.
+ *
+ * This is equivalent to calling #SigV4_GenerateHTTPAuthorization for each
+ * request, but the signing key is derived and the Authorization prefix
+ * holding the credential scope is written only once for the whole batch.
+ * #SigV4Parameters_t.pHttpParameters is ignored; the requests are given by
+ * @p pHttpParamsArray instead. #SigV4Parameters_t.pRetrySnapshot is ignored
+ * as well.
+ *
+ * When the interface provides #SigV4CryptoInterface_t.hashMultiple, the
+ * payloads of up to #SIGV4_HASH_MULTIPLE_MAX_COUNT requests are hashed
+ * together. A request left alone in its group is hashed like a single one.
+ *
+ * A request that fails does not stop the batch. Its error is reported in
+ * #SigV4Authorization_t.status, and the other requests are still signed.
+ *
+ * @param[in] pParams Parameters shared by all the requests.
+ * @param[in] pHttpParamsArray The HTTP parameters of each request.
+ * @param[in, out] pAuthorizations The output buffer and result of each
+ * request, in the order of @p pHttpParamsArray.
+ * @param[in] requestCount The number of requests.
+ *
+ * @return #SigV4Success if all the requests were signed, otherwise the error
+ * code of the first request that failed, or:
+ * <br>
+ * #SigV4InvalidParameter if a shared parameter is NULL or empty.
+ * <br>
+ * #SigV4HashError if the signing key could not be derived.
+ */
+/* @[declare_sigV4_generateHTTPAuthorizationBatch_function] */
+SigV4Status_t SigV4_GenerateHTTPAuthorizationBatch( const SigV4Parameters_t * pParams,
+                                                    const SigV4HttpParameters_t * pHttpParamsArray,
+                                                    SigV4Authorization_t * pAuthorizations,
+                                                    size_t requestCount );
+/* @[declare_sigV4_generateHTTPAuthorizationBatch_function] */
+
+/**
+ * @brief Derive the signing keys of several regions and store each in a
+ * #SigV4SigningKeyCache_t.
+ *
+ * This prepares the caches of an application that signs for the same service
+ * in several regions, so that the requests it signs afterwards find their
+ * signing key cached. The first key of the derivation, which only depends on
+ * the secret access key and the date, is computed once. When the interface
+ * provides #SigV4CryptoInterface_t.hashMultiple, the rest of the derivation
+ * of up to #SIGV4_HASH_MULTIPLE_MAX_COUNT regions is done together.
+ *
+ * #SigV4Parameters_t.pRegion, #SigV4Parameters_t.pHttpParameters and
+ * #SigV4Parameters_t.pSigningKeyCache are ignored.
+ *
+ * @param[in] pParams Parameters holding the credentials, date, service and
+ * hash interface.
+ * @param[in] pRegions The regions.
+ * @param[in] pRegionLens Length of each region.
+ * @param[in, out] pCaches The cache of each region, in the order of
+ * @p pRegions. A cache with storage for the HMAC hash states gets them saved
+ * as well.
+ * @param[in] regionCount The number of regions.
+ *
+ * @return #SigV4Success if all the signing keys were cached, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL or empty.
+ * <br>
+ * #SigV4InsufficientMemory if the tag of a signing key does not fit in
+ * #SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH bytes.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_deriveSigningKeys_function] */
+SigV4Status_t SigV4_DeriveSigningKeys( const SigV4Parameters_t * pParams,
+                                       const char * const * pRegions,
+                                       const size_t * pRegionLens,
+                                       SigV4SigningKeyCache_t * pCaches,
+                                       size_t regionCount );
+/* @[declare_sigV4_deriveSigningKeys_function] */
+
+/**
+ * @brief Start hashing a payload that is passed in fragments.
+ *
+ * A payload that does not fit in memory, or that arrives in pieces, is hashed
+ * with #SigV4_PayloadHashUpdate as each fragment becomes available, and
+ * #SigV4_PayloadHashFinal writes the hex-encoded hash. That hash is then
+ * given as #SigV4HttpParameters_t.pPayload with #SIGV4_HTTP_PAYLOAD_IS_HASH
+ * set. The memory used does not depend on the size of the payload.
+ *
+ * The hash context of @p pCryptoInterface is in use until
+ * #SigV4_PayloadHashFinal, so signing in the meantime requires another
+ * #SigV4CryptoInterface_t with its own context.
+ *
+ * @param[out] pPayloadHash The payload hash state.
+ * @param[in] pCryptoInterface The hash functions and context to use.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter or hash function is NULL.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_payloadHashInit_function] */
+SigV4Status_t SigV4_PayloadHashInit( SigV4PayloadHash_t * pPayloadHash,
+                                     const SigV4CryptoInterface_t * pCryptoInterface );
+/* @[declare_sigV4_payloadHashInit_function] */
+
+/**
+ * @brief Hash the next fragment of a payload.
+ *
+ * @param[in, out] pPayloadHash The payload hash state, set up with
+ * #SigV4_PayloadHashInit.
+ * @param[in] pData The fragment. This can be NULL if @p dataLen is zero.
+ * @param[in] dataLen The length of @p pData.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_payloadHashUpdate_function] */
+SigV4Status_t SigV4_PayloadHashUpdate( SigV4PayloadHash_t * pPayloadHash,
+                                       const char * pData,
+                                       size_t dataLen );
+/* @[declare_sigV4_payloadHashUpdate_function] */
+
+/**
+ * @brief Finish hashing a payload, and write its hex-encoded hash.
+ *
+ * @param[in, out] pPayloadHash The payload hash state, set up with
+ * #SigV4_PayloadHashInit.
+ * @param[out] pHexPayloadHash The buffer for the hash. It is not
+ * null-terminated.
+ * @param[in] hexPayloadHashLen The length of @p pHexPayloadHash, at least
+ * #SIGV4_HEX_PAYLOAD_HASH_LENGTH.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL.
+ * <br>
+ * #SigV4InsufficientMemory if @p pHexPayloadHash is too small.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_payloadHashFinal_function] */
+SigV4Status_t SigV4_PayloadHashFinal( SigV4PayloadHash_t * pPayloadHash,
+                                      char * pHexPayloadHash,
+                                      size_t hexPayloadHashLen );
+/* @[declare_sigV4_payloadHashFinal_function] */
+
+/**
+ * @brief Start the chunk signature chain of an aws-chunked upload.
+ *
+ * The request itself is signed first, with #SigV4_GenerateHTTPAuthorization,
+ * with the x-amz-content-sha256 header and the payload hash both set to
+ * #SIGV4_STREAMING_AWS4_HMAC_SHA256_PAYLOAD (see #SIGV4_HTTP_PAYLOAD_IS_HASH).
+ * Its signature is the seed of the chain. Each chunk is then signed with
+ * #SigV4_SignChunk as it becomes available, so the upload can start before
+ * the whole body is known.
+ *
+ * @param[out] pSigner The chunk signer.
+ * @param[in] pParams The parameters the request was signed with. The signing
+ * key cache is used if there is one. #SigV4Parameters_t.pHttpParameters is
+ * ignored. They must remain valid until the final chunk is signed.
+ * @param[in] pSeedSignature The signature of the request.
+ * @param[in] seedSignatureLen The length of @p pSeedSignature, which must be
+ * #SIGV4_HEX_SIGNATURE_LENGTH.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL or invalid.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_chunkSignerInit_function] */
+SigV4Status_t SigV4_ChunkSignerInit( SigV4ChunkSigner_t * pSigner,
+                                     const SigV4Parameters_t * pParams,
+                                     const char * pSeedSignature,
+                                     size_t seedSignatureLen );
+/* @[declare_sigV4_chunkSignerInit_function] */
+
+/**
+ * @brief Sign the next chunk of an aws-chunked upload, and write its chunk
+ * header.
+ *
+ * The header is "<hex size>;chunk-signature=<signature>\r\n". It is written
+ * to the caller's send buffer, where it is followed by the chunk data and
+ * "\r\n". The final chunk of the upload is empty, and its header is
+ * followed by "\r\n" only. Signing it ends the chain and erases the signing
+ * key from @p pSigner.
+ *
+ * @param[in, out] pSigner The chunk signer, set up with
+ * #SigV4_ChunkSignerInit.
+ * @param[in] pChunk The chunk data. This can be NULL if @p chunkLen is zero.
+ * @param[in] chunkLen The length of @p pChunk, or zero for the final chunk.
+ * @param[out] pHeaderBuf The buffer for the chunk header. It is not
+ * null-terminated.
+ * @param[in, out] pHeaderBufLen Input: the length of @p pHeaderBuf, at most
+ * #SIGV4_CHUNK_HEADER_MAX_LENGTH is needed. Output: the length of the header.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL, or the final chunk was
+ * already signed.
+ * <br>
+ * #SigV4InsufficientMemory if @p pHeaderBuf is too small.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_signChunk_function] */
+SigV4Status_t SigV4_SignChunk( SigV4ChunkSigner_t * pSigner,
+                               const char * pChunk,
+                               size_t chunkLen,
+                               char * pHeaderBuf,
+                               size_t * pHeaderBufLen );
+/* @[declare_sigV4_signChunk_function] */
+
+/**
+ * @brief Sign the next chunk of an aws-chunked upload from the hash of its
+ * data, and write its chunk header.
+ *
+ * This is the second half of #SigV4_SignChunk. Hashing the chunk data is the
+ * costly half, and the hashes of different chunks are independent, so they
+ * can be computed ahead, out of order, or concurrently: with
+ * #SigV4_HashChunks, with a #SigV4ChunkHashJob_t run by several threads, or
+ * on worker threads that each use #SigV4_PayloadHashInit,
+ * #SigV4_PayloadHashUpdate and #SigV4_PayloadHashFinal with their own
+ * #SigV4CryptoInterface_t. Only the
+ * signature chain, which this function computes, must follow the order of
+ * the chunks.
+ *
+ * @param[in, out] pSigner The chunk signer, set up with
+ * #SigV4_ChunkSignerInit.
+ * @param[in] pHexChunkHash The hex-encoded hash of the chunk data.
+ * @param[in] hexChunkHashLen The length of @p pHexChunkHash, which must be
+ * #SIGV4_HEX_PAYLOAD_HASH_LENGTH.
+ * @param[in] chunkLen The length of the chunk data, or zero for the final
+ * chunk.
+ * @param[out] pHeaderBuf The buffer for the chunk header.
+ * @param[in, out] pHeaderBufLen Input: the length of @p pHeaderBuf. Output:
+ * the length of the header.
+ *
+ * @return See #SigV4_SignChunk.
+ */
+/* @[declare_sigV4_signChunkHash_function] */
+SigV4Status_t SigV4_SignChunkHash( SigV4ChunkSigner_t * pSigner,
+                                   const char * pHexChunkHash,
+                                   size_t hexChunkHashLen,
+                                   size_t chunkLen,
+                                   char * pHeaderBuf,
+                                   size_t * pHeaderBufLen );
+/* @[declare_sigV4_signChunkHash_function] */
+
+/**
+ * @brief Compute the hex-encoded hashes of several chunks, for
+ * #SigV4_SignChunkHash.
+ *
+ * When the interface provides #SigV4CryptoInterface_t.hashMultiple, up to
+ * #SIGV4_HASH_MULTIPLE_MAX_COUNT chunks are hashed with each call to it.
+ *
+ * @param[in] pCryptoInterface The hash functions and context to use.
+ * @param[in] pChunks The chunk data.
+ * @param[in] pChunkLens The length of each chunk.
+ * @param[out] pHexChunkHashes The buffer for the @p chunkCount hashes of
+ * #SIGV4_HEX_PAYLOAD_HASH_LENGTH characters, one after another.
+ * @param[in] chunkCount The number of chunks.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter or hash function is NULL.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_hashChunks_function] */
+SigV4Status_t SigV4_HashChunks( const SigV4CryptoInterface_t * pCryptoInterface,
+                                const char * const * pChunks,
+                                const size_t * pChunkLens,
+                                char * pHexChunkHashes,
+                                size_t chunkCount );
+/* @[declare_sigV4_hashChunks_function] */
+
+/**
+ * @brief Set up the hashing of the chunks of an aws-chunked upload by several
+ * application threads.
+ *
+ * This is #SigV4_HashChunks split into work items: groups of up to
+ * #SIGV4_HASH_MULTIPLE_MAX_COUNT consecutive chunks. The library has no
+ * threads of its own. The application calls #SigV4_ChunkHashJobRun from as
+ * many of its threads as it wants to use, then signs the chunks in order
+ * with #SigV4_SignChunkHash.
+ *
+ * @param[out] pJob The job to set up.
+ * @param[in] pChunks The chunk data. A chunk can be NULL if its length is
+ * zero.
+ * @param[in] pChunkLens The length of each chunk.
+ * @param[out] pHexChunkHashes The buffer for the @p chunkCount hashes of
+ * #SIGV4_HEX_PAYLOAD_HASH_LENGTH characters, one after another.
+ * @param[in] chunkCount The number of chunks, at most
+ * #SIGV4_CHUNK_HASH_JOB_MAX_COUNT.
+ *
+ * The chunks, their lengths and the hash buffer must remain valid until the
+ * job is complete.
+ *
+ * @return #SigV4Success if successful, or #SigV4InvalidParameter if a
+ * parameter or chunk is NULL, or there are too many chunks.
+ */
+/* @[declare_sigV4_chunkHashJobInit_function] */
+SigV4Status_t SigV4_ChunkHashJobInit( SigV4ChunkHashJob_t * pJob,
+                                      const char * const * pChunks,
+                                      const size_t * pChunkLens,
+                                      char * pHexChunkHashes,
+                                      size_t chunkCount );
+/* @[declare_sigV4_chunkHashJobInit_function] */
+
+/**
+ * @brief Hash groups of chunks of a chunk hash job until none is left to
+ * claim.
+ *
+ * Any number of threads can call this at the same time, each with its own
+ * #SigV4CryptoInterface_t and hash context. Groups are claimed with
+ * #SIGV4_ATOMIC_FETCH_ADD_U32, so each is hashed once, and each thread hashes
+ * the chunks of a group together when its interface provides
+ * #SigV4CryptoInterface_t.hashMultiple.
+ *
+ * @param[in, out] pJob The job, set up with #SigV4_ChunkHashJobInit.
+ * @param[in] pCryptoInterface The hash functions and context of this thread.
+ *
+ * @return #SigV4Success once no group is left to claim, even if other threads
+ * are still hashing theirs, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter or hash function is NULL.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error. The job
+ * then fails, and other threads stop claiming groups.
+ */
+/* @[declare_sigV4_chunkHashJobRun_function] */
+SigV4Status_t SigV4_ChunkHashJobRun( SigV4ChunkHashJob_t * pJob,
+                                     const SigV4CryptoInterface_t * pCryptoInterface );
+/* @[declare_sigV4_chunkHashJobRun_function] */
+
+/**
+ * @brief Check whether every chunk of a chunk hash job is hashed.
+ *
+ * The hashes are in the buffer given to #SigV4_ChunkHashJobInit once this
+ * returns #SigV4Success. It does not wait: the application joins its threads,
+ * or calls this again.
+ *
+ * @param[in] pJob The job, set up with #SigV4_ChunkHashJobInit.
+ *
+ * @return #SigV4Success if every chunk is hashed, or:
+ * <br>
+ * #SigV4ChunkHashesPending if threads are still hashing chunks.
+ * <br>
+ * #SigV4InvalidParameter if @p pJob is NULL.
+ * <br>
+ * #SigV4HashError if a thread failed to hash its chunks.
+ */
+/* @[declare_sigV4_chunkHashJobResult_function] */
+SigV4Status_t SigV4_ChunkHashJobResult( const SigV4ChunkHashJob_t * pJob );
+/* @[declare_sigV4_chunkHashJobResult_function] */
+
+/**
+ * @brief Set up the signature chain of an event stream, such as those of
+ * Amazon Transcribe streaming or Kinesis Video Streams.
+ *
+ * The signing key is derived once here, or taken from
+ * #SigV4Parameters_t.pSigningKeyCache, and reused for every event of the
+ * same day.
+ *
+ * @param[out] pSigner The event signer to set up.
+ * @param[in] pParams The parameters of the request that opened the stream.
+ * The HTTP parameters are not used. They must remain valid while events are
+ * signed.
+ * @param[in] pSeedSignature The hex-encoded signature of that request.
+ * @param[in] seedSignatureLen The length of @p pSeedSignature, which must be
+ * #SIGV4_HEX_SIGNATURE_LENGTH.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is invalid, #SigV4HashError if the #SigV4CryptoInterface_t reported an
+ * error.
+ */
+/* @[declare_sigV4_eventSignerInit_function] */
+SigV4Status_t SigV4_EventSignerInit( SigV4EventSigner_t * pSigner,
+                                     const SigV4Parameters_t * pParams,
+                                     const char * pSeedSignature,
+                                     size_t seedSignatureLen );
+/* @[declare_sigV4_eventSignerInit_function] */
+
+/**
+ * @brief Sign the next event of an event stream, and write its headers.
+ *
+ * The signature is the HMAC of:
+ * @code
+ * AWS4-HMAC-SHA256-PAYLOAD\n
+ * <ISO 8601 event date>\n
+ * <credential scope>\n
+ * <previous signature>\n
+ * <hash of the :date header>\n
+ * <hash of the payload>
+ * @endcode
+ *
+ * The #SIGV4_EVENT_HEADERS_LENGTH bytes written to @p pHeaderBuf are the
+ * ":date" header, a timestamp of @p eventTime, followed by the
+ * ":chunk-signature" header, in the binary header encoding of the event
+ * stream format. The application frames them, with the payload, into the
+ * event message that it sends. The stream is ended by signing an empty
+ * payload.
+ *
+ * When the event is on a later day than the previous one, the signing key
+ * for the new date is derived first.
+ *
+ * @param[in, out] pSigner The event signer, set up with
+ * #SigV4_EventSignerInit.
+ * @param[in] eventTime The time of the event, in seconds since the Unix
+ * epoch.
+ * @param[in] pPayload The payload of the event, which is the encoded inner
+ * event message. It may be NULL if @p payloadLen is zero.
+ * @param[in] payloadLen The length of @p pPayload.
+ * @param[out] pHeaderBuf The buffer for the event headers.
+ * @param[in] headerBufLen The length of @p pHeaderBuf, at least
+ * #SIGV4_EVENT_HEADERS_LENGTH.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL, @p pSigner is not set up,
+ * or @p eventTime is after the year 9999.
+ * <br>
+ * #SigV4InsufficientMemory if @p pHeaderBuf is too small.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_signEvent_function] */
+SigV4Status_t SigV4_SignEvent( SigV4EventSigner_t * pSigner,
+                               uint64_t eventTime,
+                               const uint8_t * pPayload,
+                               size_t payloadLen,
+                               uint8_t * pHeaderBuf,
+                               size_t headerBufLen );
+/* @[declare_sigV4_signEvent_function] */
+
+/**
+ * @brief Parse the expiration date of credentials into
+ * #SigV4Credentials_t.expirationTime.
+ *
+ * This is done once when the credentials are obtained, so that expiry can be
+ * checked with #SigV4_CredentialsExpireWithin on every request. If
+ * #SigV4Credentials_t.pExpiration is NULL or empty, the credentials do not
+ * expire and the expiration time is set to 0.
+ *
+ * @param[in, out] pCredentials The credentials. #SigV4Credentials_t.pExpiration
+ * is in the RFC 3339 or RFC 5322 format accepted by
+ * #SigV4_AwsIotDateToIso8601, as returned by AWS STS and the AWS IoT
+ * credential provider.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if @p pCredentials is NULL.
+ * <br>
+ * #SigV4ISOFormattingError if the expiration is not a valid date after the
+ * Unix epoch. The expiration time is not changed.
+ */
+/* @[declare_sigV4_parseCredentialsExpiration_function] */
+SigV4Status_t SigV4_ParseCredentialsExpiration( SigV4Credentials_t * pCredentials );
+/* @[declare_sigV4_parseCredentialsExpiration_function] */
+
+/**
+ * @brief Check whether credentials expire within a number of seconds.
+ *
+ * This only compares #SigV4Credentials_t.expirationTime, which must have been
+ * set with #SigV4_ParseCredentialsExpiration, so it is cheap enough to call
+ * before every request. A refresh task can use it to obtain new credentials
+ * ahead of expiry.
+ *
+ * @param[in] pCredentials The credentials.
+ * @param[in] currentTime The current time, in seconds since the Unix epoch.
+ * @param[in] seconds The margin before the expiration time.
+ *
+ * @return #SigV4Success if the credentials are valid for more than
+ * @p seconds after @p currentTime, or do not expire, #SigV4CredentialsExpiring
+ * if they expire within @p seconds or have expired, #SigV4InvalidParameter if
+ * @p pCredentials is NULL.
+ */
+/* @[declare_sigV4_credentialsExpireWithin_function] */
+SigV4Status_t SigV4_CredentialsExpireWithin( const SigV4Credentials_t * pCredentials,
+                                             uint64_t currentTime,
+                                             uint32_t seconds );
+/* @[declare_sigV4_credentialsExpireWithin_function] */
+
+/**
+ * @brief Set up a credential store, which holds no credentials until the
+ * first ones are published.
+ *
+ * @param[out] pStore The store.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if @p pStore is
+ * NULL.
+ */
+/* @[declare_sigV4_credentialStoreInit_function] */
+SigV4Status_t SigV4_CredentialStoreInit( SigV4CredentialStore_t * pStore );
+/* @[declare_sigV4_credentialStoreInit_function] */
+
+/**
+ * @brief Copy credentials to a credential store, and publish them to the
+ * tasks that acquire credentials from then on.
+ *
+ * The credentials are written to the slot of the credentials published
+ * before the current ones, which is wiped first. Tasks that still hold the
+ * current credentials keep using them until they release them.
+ *
+ * @param[in, out] pStore The store.
+ * @param[in] pCredentials The credentials. #SigV4Credentials_t.pSecurityToken
+ * and #SigV4Credentials_t.pExpiration may be NULL. The expiration is parsed
+ * as by #SigV4_ParseCredentialsExpiration, so the published credentials can
+ * be checked with #SigV4_CredentialsExpireWithin.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter is NULL, or the access key ID or
+ * the secret access key is empty.
+ * <br>
+ * #SigV4InsufficientMemory if the credentials do not fit in
+ * #SIGV4_CREDENTIAL_STORE_SLOT_LENGTH bytes.
+ * <br>
+ * #SigV4ISOFormattingError if the expiration is not a valid date.
+ * <br>
+ * #SigV4CredentialsInUse if the credentials published before the current
+ * ones are still acquired. The current credentials stay published, and the
+ * call can be retried.
+ */
+/* @[declare_sigV4_credentialStorePublish_function] */
+SigV4Status_t SigV4_CredentialStorePublish( SigV4CredentialStore_t * pStore,
+                                            const SigV4Credentials_t * pCredentials );
+/* @[declare_sigV4_credentialStorePublish_function] */
+
+/**
+ * @brief Acquire the published credentials of a credential store.
+ *
+ * This does not wait for #SigV4_CredentialStorePublish, and can be called
+ * while it runs. The credentials stay valid and unchanged until they are
+ * released with #SigV4_CredentialStoreRelease, which must be done once the
+ * request is signed.
+ *
+ * @param[in, out] pStore The store.
+ * @param[out] pCredentials The credentials, in the store, to set as
+ * #SigV4Parameters_t.pCredentials.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is NULL, #SigV4CredentialsUnavailable if no credentials were published.
+ */
+/* @[declare_sigV4_credentialStoreAcquire_function] */
+SigV4Status_t SigV4_CredentialStoreAcquire( SigV4CredentialStore_t * pStore,
+                                            SigV4Credentials_t ** pCredentials );
+/* @[declare_sigV4_credentialStoreAcquire_function] */
+
+/**
+ * @brief Release credentials acquired from a credential store.
+ *
+ * @param[in, out] pStore The store.
+ * @param[in] pCredentials The credentials returned by
+ * #SigV4_CredentialStoreAcquire.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is NULL, or @p pCredentials are not acquired credentials of @p pStore.
+ */
+/* @[declare_sigV4_credentialStoreRelease_function] */
+SigV4Status_t SigV4_CredentialStoreRelease( SigV4CredentialStore_t * pStore,
+                                            const SigV4Credentials_t * pCredentials );
+/* @[declare_sigV4_credentialStoreRelease_function] */
+
 /**
  * @brief Parse the date header value from the AWS IoT response, and generate
  * the formatted ISO 8601 date required for authentication.
@@ -39,8 +39,11 @@
  * @brief Macro defining the size of the internal buffer used for incremental
  * canonicalization and hashing.
  *
- * A buffer of this size in bytes is declared on the stack. It should be be
- * large enough for the digest output of the specified hash function.
+ * A buffer of this size in bytes is declared on the stack. The canonical
+ * request is passed to the hash function in fragments of up to this size, so
+ * it does not limit the size of requests. It must be large enough for the
+ * string to sign, which holds the credential scope and the hex-encoded digest
+ * of the specified hash function.
  *
  * <b>Possible values:</b> Any positive 32 bit integer. <br>
  * <b>Default value:</b> `1024`
@@ -92,6 +95,274 @@
     #define SIGV4_HASH_DIGEST_LENGTH    32U
 #endif
 
+/**
+ * @brief Macro defining the maximum block length of the hash function, used
+ * to size the padded HMAC key.
+ *
+ * #SigV4CryptoInterface_t.hashBlockLen must not exceed this value. This
+ * macro should be updated if using a hashing algorithm with a block length
+ * larger than that of SHA256 (64 bytes). For example, SHA512 would require
+ * this macro to be updated to 128.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `64`
+ */
+#ifndef SIGV4_HASH_MAX_BLOCK_LENGTH
+    #define SIGV4_HASH_MAX_BLOCK_LENGTH    64U
+#endif
+
+/**
+ * @brief Macro defining the maximum number of messages passed to
+ * #SigV4CryptoInterface_t.hashMultiple in one call.
+ *
+ * #SigV4_GenerateHTTPAuthorizationBatch hashes the payloads of up to this
+ * many requests together, and #SigV4_DeriveSigningKeys derives up to this
+ * many signing keys together. The working memory of both grows with this
+ * value. The default matches the eight lanes of the AVX2 implementation in
+ * sigv4_sha256.c.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `8`
+ */
+#ifndef SIGV4_HASH_MULTIPLE_MAX_COUNT
+    #define SIGV4_HASH_MULTIPLE_MAX_COUNT    8U
+#endif
+
+/**
+ * @brief Macro defining the size of the tag identifying the signing key held
+ * by a #SigV4SigningKeyCache_t.
+ *
+ * The tag holds the credential scope date, region and service, and the secret
+ * access key that the signing key was derived from. A signing key whose tag
+ * does not fit is not cached. The default fits a 40 character secret access
+ * key with a region and service name of up to 77 characters in total.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `128`
+ */
+#ifndef SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH
+    #define SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH    128U
+#endif
+
+/**
+ * @brief Macro defining the size of the canonical request suffix held by a
+ * #SigV4RetrySnapshot_t.
+ *
+ * The suffix is the canonical request from the value of the x-amz-date
+ * header on: the headers that sort after it, the signed headers and the
+ * payload hash. A request whose suffix does not fit is signed as usual, but
+ * no snapshot is saved. Headers that sort after x-amz-date may need a larger
+ * value, except for an x-amz-security-token holding the security token of
+ * the credentials, which is not copied to the suffix.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `1024`
+ */
+#ifndef SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH
+    #define SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH    1024U
+#endif
+
+/**
+ * @brief Macro defining the number of payload hashes held by a
+ * #SigV4PayloadHashCache_t.
+ *
+ * Each entry holds the location, length and generation of a payload, and its
+ * hex-encoded hash. When the cache is full, an entry that was not used since
+ * the clock hand last passed it is replaced.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `8`
+ */
+#ifndef SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT
+    #define SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT    8U
+#endif
+
+/**
+ * @brief Macro defining the length of the buffer of each presigned URL of a
+ * #SigV4PresignPool_t.
+ *
+ * The query string of a presigned URL is about 300 bytes, plus the
+ * URI-encoded security token of temporary credentials, which can be more
+ * than 1000 bytes.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `2048`
+ */
+#ifndef SIGV4_PRESIGN_POOL_QUERY_LENGTH
+    #define SIGV4_PRESIGN_POOL_QUERY_LENGTH    2048U
+#endif
+
+/**
+ * @brief Macro defining the length of the buffer of a #SigV4PresignTemplate_t.
+ *
+ * The buffer holds the start of the string to sign, about 100 bytes, and
+ * the canonical request after the path, which holds the query string of the
+ * presigned URLs, the canonical headers, the signed headers and the payload
+ * hash.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `2048`
+ */
+#ifndef SIGV4_PRESIGN_TEMPLATE_LENGTH
+    #define SIGV4_PRESIGN_TEMPLATE_LENGTH    2048U
+#endif
+
+/**
+ * @brief Macro that reads a uint32_t shared between tasks, with acquire
+ * ordering: no read that follows it may happen before it.
+ *
+ * #SigV4_PresignPoolGet reads which URLs of a #SigV4PresignPool_t are ready
+ * with it, and #SigV4_ChunkHashJobRun and #SigV4_ChunkHashJobResult the
+ * progress of a #SigV4ChunkHashJob_t. Define it, together with
+ * #SIGV4_ATOMIC_STORE_U32, for compilers
+ * other than GCC and Clang, for example with C11 atomic_load_explicit(), or a
+ * volatile read followed by a memory barrier.
+ *
+ * <b>Possible values:</b> An expression that reads the uint32_t that its
+ * argument points to. <br>
+ * <b>Default value:</b> `__atomic_load_n( pValue, __ATOMIC_ACQUIRE )` with
+ * GCC and Clang, a volatile read otherwise.
+ */
+#ifndef SIGV4_ATOMIC_LOAD_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_LOAD_U32( pValue )    __atomic_load_n( ( pValue ), __ATOMIC_ACQUIRE )
+    #else
+        #define SIGV4_ATOMIC_LOAD_U32( pValue )    ( *( ( const volatile uint32_t * ) ( pValue ) ) )
+    #endif
+#endif
+
+/**
+ * @brief Macro that writes a uint32_t shared between tasks, with release
+ * ordering: no write that precedes it may happen after it.
+ *
+ * #SigV4_PresignPoolRefresh publishes the URLs of a #SigV4PresignPool_t
+ * with it, once they are complete, and #SigV4_ChunkHashJobRun marks a
+ * #SigV4ChunkHashJob_t as failed with it.
+ *
+ * <b>Possible values:</b> A statement that writes its second argument to
+ * the uint32_t that its first argument points to. <br>
+ * <b>Default value:</b> `__atomic_store_n( pValue, value, __ATOMIC_RELEASE )`
+ * with GCC and Clang, a volatile write otherwise.
+ */
+#ifndef SIGV4_ATOMIC_STORE_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_STORE_U32( pValue, value )    __atomic_store_n( ( pValue ), ( value ), __ATOMIC_RELEASE )
+    #else
+        #define SIGV4_ATOMIC_STORE_U32( pValue, value )    ( *( ( volatile uint32_t * ) ( pValue ) ) = ( value ) )
+    #endif
+#endif
+
+/**
+ * @brief Macro that adds one to a uint32_t shared between tasks, as a single
+ * atomic operation that is also a full memory barrier.
+ *
+ * #SigV4_CredentialStoreAcquire counts the tasks that use a slot of a
+ * #SigV4CredentialStore_t with it, and #SigV4_CredentialStorePublish
+ * publishes a slot by incrementing the epoch. Define it, together with
+ * #SIGV4_ATOMIC_DECREMENT_U32 and #SIGV4_ATOMIC_LOAD_SEQ_CST_U32, for
+ * compilers other than GCC and Clang, for example with C11
+ * atomic_fetch_add().
+ *
+ * <b>Possible values:</b> A statement that atomically increments the
+ * uint32_t that its argument points to, with sequentially consistent
+ * ordering. <br>
+ * <b>Default value:</b> `__atomic_add_fetch( pValue, 1U, __ATOMIC_SEQ_CST )`
+ * with GCC and Clang. Other compilers must define it.
+ */
+#ifndef SIGV4_ATOMIC_INCREMENT_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_INCREMENT_U32( pValue )    ( void ) __atomic_add_fetch( ( pValue ), 1U, __ATOMIC_SEQ_CST )
+    #else
+        #error "Define SIGV4_ATOMIC_INCREMENT_U32 in sigv4_config.h for this compiler."
+    #endif
+#endif
+
+/**
+ * @brief Macro that subtracts one from a uint32_t shared between tasks, as a
+ * single atomic operation that is also a full memory barrier.
+ *
+ * #SigV4_CredentialStoreRelease gives a slot of a #SigV4CredentialStore_t
+ * back with it. See #SIGV4_ATOMIC_INCREMENT_U32.
+ *
+ * <b>Possible values:</b> A statement that atomically decrements the
+ * uint32_t that its argument points to, with sequentially consistent
+ * ordering. <br>
+ * <b>Default value:</b> `__atomic_sub_fetch( pValue, 1U, __ATOMIC_SEQ_CST )`
+ * with GCC and Clang. Other compilers must define it.
+ */
+#ifndef SIGV4_ATOMIC_DECREMENT_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_DECREMENT_U32( pValue )    ( void ) __atomic_sub_fetch( ( pValue ), 1U, __ATOMIC_SEQ_CST )
+    #else
+        #error "Define SIGV4_ATOMIC_DECREMENT_U32 in sigv4_config.h for this compiler."
+    #endif
+#endif
+
+/**
+ * @brief Macro that reads a uint32_t shared between tasks, with sequentially
+ * consistent ordering.
+ *
+ * #SigV4_CredentialStoreAcquire checks the epoch of a #SigV4CredentialStore_t
+ * with it after counting itself in to a slot, and
+ * #SigV4_CredentialStorePublish checks the count of a slot with it before
+ * writing the slot. The checks and the increments before them then fall in
+ * a single total order, so at least one of the two tasks sees the increment
+ * of the other. An acquire read may happen before the increment that
+ * precedes it, and does not give that guarantee. See
+ * #SIGV4_ATOMIC_INCREMENT_U32.
+ *
+ * <b>Possible values:</b> An expression that reads the uint32_t that its
+ * argument points to, with sequentially consistent ordering. <br>
+ * <b>Default value:</b> `__atomic_load_n( pValue, __ATOMIC_SEQ_CST )` with
+ * GCC and Clang. Other compilers must define it.
+ */
+#ifndef SIGV4_ATOMIC_LOAD_SEQ_CST_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_LOAD_SEQ_CST_U32( pValue )    __atomic_load_n( ( pValue ), __ATOMIC_SEQ_CST )
+    #else
+        #error "Define SIGV4_ATOMIC_LOAD_SEQ_CST_U32 in sigv4_config.h for this compiler."
+    #endif
+#endif
+
+/**
+ * @brief Macro that adds a value to a uint32_t shared between tasks, and
+ * evaluates to the value it held before, as a single atomic operation that is
+ * also a full memory barrier.
+ *
+ * #SigV4_ChunkHashJobRun claims the next group of chunks of a
+ * #SigV4ChunkHashJob_t with it, and counts the chunks it hashed. Define it
+ * for compilers other than GCC and Clang, for example with C11
+ * atomic_fetch_add().
+ *
+ * <b>Possible values:</b> An expression that atomically adds its second
+ * argument to the uint32_t that its first argument points to, with
+ * sequentially consistent ordering, and evaluates to the previous value. <br>
+ * <b>Default value:</b> `__atomic_fetch_add( pValue, value, __ATOMIC_SEQ_CST )`
+ * with GCC and Clang. Other compilers must define it.
+ */
+#ifndef SIGV4_ATOMIC_FETCH_ADD_U32
+    #if defined( __GNUC__ ) || defined( __clang__ )
+        #define SIGV4_ATOMIC_FETCH_ADD_U32( pValue, value )    __atomic_fetch_add( ( pValue ), ( value ), __ATOMIC_SEQ_CST )
+    #else
+        #error "Define SIGV4_ATOMIC_FETCH_ADD_U32 in sigv4_config.h for this compiler."
+    #endif
+#endif
+
+/**
+ * @brief Macro defining the length of the buffer of each credential set of
+ * a #SigV4CredentialStore_t.
+ *
+ * The buffer holds the access key ID, the secret access key, the security
+ * token and the expiration. Session tokens of temporary credentials can be
+ * more than 1000 bytes.
+ *
+ * <b>Possible values:</b> Any positive 32 bit integer. <br>
+ * <b>Default value:</b> `2048`
+ */
+#ifndef SIGV4_CREDENTIAL_STORE_SLOT_LENGTH
+    #define SIGV4_CREDENTIAL_STORE_SLOT_LENGTH    2048U
+#endif
+
 /**
  * @brief Macro to statically enable support for canonicalizing the URI,
  * headers, and query in this utility.
@@ -106,6 +377,102 @@
     #define SIGV4_USE_CANONICAL_SUPPORT    1
 #endif
 
+/**
+ * @brief Macro to enable the x86 SHA extensions in the bundled SHA-256
+ * implementation of sigv4_sha256.c.
+ *
+ * When this is 1 and the library is built for x86 with GCC 7 or later, or
+ * Clang, #SigV4_Sha256InitCryptoInterface checks with cpuid whether the
+ * processor supports the SHA extensions, and uses them if it does. On other
+ * targets, or when this is 0, only the portable C implementation is built.
+ *
+ * <b>Possible values:</b> 0 or 1 <br>
+ * <b>Default value:</b> `1`
+ */
+#ifndef SIGV4_SHA256_USE_SHA_NI
+    #define SIGV4_SHA256_USE_SHA_NI    1
+#endif
+
+/**
+ * @brief Macro to enable AVX2 in #SigV4_Sha256HashMultiple, the multi-buffer
+ * hash of the bundled SHA-256 implementation.
+ *
+ * When this is 1 and the library is built for x86 with GCC 7 or later, or
+ * Clang, #SigV4_Sha256InitCryptoInterface checks whether the processor and
+ * the operating system support AVX2. If they do, independent messages are
+ * hashed eight at a time. On other targets, or when this is 0, they are
+ * hashed one after another.
+ *
+ * <b>Possible values:</b> 0 or 1 <br>
+ * <b>Default value:</b> `1`
+ */
+#ifndef SIGV4_SHA256_USE_AVX2
+    #define SIGV4_SHA256_USE_AVX2    1
+#endif
+
+/**
+ * @brief Macro to enable SSE2 in the URI encoding of paths and query strings.
+ *
+ * When this is 1 and the library is built for x86-64 with GCC 7 or later, or
+ * Clang, runs of characters that need no encoding are found 16 characters at
+ * a time. Every x86-64 processor supports SSE2. On other targets, or when
+ * this is 0, characters are classified one at a time with a lookup table.
+ *
+ * <b>Possible values:</b> 0 or 1 <br>
+ * <b>Default value:</b> `1`
+ */
+#ifndef SIGV4_URI_ENCODE_USE_SSE2
+    #define SIGV4_URI_ENCODE_USE_SSE2    1
+#endif
+
+/**
+ * @brief Macro to enable AVX2 in the URI encoding of paths and query strings.
+ *
+ * When this is 1 and the library is built for x86-64 with GCC 7 or later, or
+ * Clang, the first URI encoding checks whether the processor and the
+ * operating system support AVX2. If they do, runs of characters that need no
+ * encoding are found 32 characters at a time, before #SIGV4_URI_ENCODE_USE_SSE2
+ * and the lookup table handle the rest.
+ *
+ * <b>Possible values:</b> 0 or 1 <br>
+ * <b>Default value:</b> `1`
+ */
+#ifndef SIGV4_URI_ENCODE_USE_AVX2
+    #define SIGV4_URI_ENCODE_USE_AVX2    1
+#endif
+
+/**
+ * @brief Macro to enable the SSE4.2 crc32 and PCLMUL instructions in the
+ * CRC32C implementation of sigv4_crc32c.c.
+ *
+ * When this is 1 and the library is built for x86-64 with GCC 7 or later, or
+ * Clang, #SigV4_Crc32cInit checks with cpuid whether the processor supports
+ * them, and uses them if it does. On other targets, or when this is 0, only
+ * the portable C implementation is built.
+ *
+ * <b>Possible values:</b> 0 or 1 <br>
+ * <b>Default value:</b> `1`
+ */
+#ifndef SIGV4_CRC32C_USE_SSE42
+    #define SIGV4_CRC32C_USE_SSE42    1
+#endif
+
+/**
+ * @brief Macro defining the number of bytes of a file that #SigV4_HashFile
+ * maps into memory at a time.
+ *
+ * A smaller window uses less address space, which matters on 32-bit
+ * targets, at the cost of more calls to mmap. It must be a multiple of the
+ * page size, as mapped windows start at multiples of it.
+ *
+ * <b>Possible values:</b> Any positive multiple of the page size that fits
+ * in a size_t. <br>
+ * <b>Default value:</b> `16777216` (16 MiB)
+ */
+#ifndef SIGV4_FILE_MAP_WINDOW_LENGTH
+    #define SIGV4_FILE_MAP_WINDOW_LENGTH    16777216U
+#endif
+
 /**
  * @brief Macro called by the SigV4 Utility library for logging "Error" level
  * messages.
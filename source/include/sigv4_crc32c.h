@@ -0,0 +1,180 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file sigv4_crc32c.h
+ * @brief Interface for the optional CRC32C checksum and trailer framing of
+ * the SigV4 Client Utility Library.
+ *
+ * With #SIGV4_STREAMING_UNSIGNED_PAYLOAD_TRAILER, the payload of an
+ * aws-chunked upload is not hashed. Its integrity is instead protected by a
+ * checksum sent in a trailer after the last chunk. Applications can build
+ * sigv4_crc32c.c to compute that checksum with CRC32C and frame the chunks
+ * and the x-amz-checksum-crc32c trailer.
+ */
+
+#ifndef SIGV4_CRC32C_H_
+#define SIGV4_CRC32C_H_
+
+/* Include SigV4 library header for the status codes. */
+#include "sigv4.h"
+
+/** @addtogroup sigv4_constants
+ *  @{
+ */
+#define SIGV4_CRC32C_LENGTH    4U /**< Length of a CRC32C checksum. */
+
+/**
+ * @brief Longest chunk header written by #SigV4_Crc32cChunkHeader: the
+ * hex-encoded chunk size and "\r\n".
+ */
+#define SIGV4_UNSIGNED_CHUNK_HEADER_MAX_LENGTH    ( ( 2U * sizeof( size_t ) ) + 2U )
+
+/**
+ * @brief Length of the final chunk and trailer written by
+ * #SigV4_Crc32cTrailer: "0\r\n", "x-amz-checksum-crc32c:", the base64
+ * encoded checksum, and "\r\n\r\n".
+ */
+#define SIGV4_CRC32C_TRAILER_LENGTH               37U
+/** @}*/
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief The state of a CRC32C computation.
+ *
+ * A context must be set up with #SigV4_Crc32cInit, which selects the
+ * implementation, before it is used.
+ */
+typedef struct SigV4Crc32c
+{
+    uint32_t crc; /**< The inverted checksum of the data so far. */
+
+    /**
+     * @brief 1 if the checksum is computed with the SSE4.2 crc32 and PCLMUL
+     * instructions, 0 if it is computed in portable C.
+     */
+    uint8_t useSse42;
+} SigV4Crc32c_t;
+
+/**
+ * @brief Start a new CRC32C computation.
+ *
+ * When #SIGV4_CRC32C_USE_SSE42 is 1 and the library is built for x86-64
+ * with GCC or Clang, the processor is queried for SSE4.2 and PCLMUL, which
+ * are used if they are present. Otherwise the checksum is computed in
+ * portable C, a byte at a time.
+ *
+ * @param[out] pCrc32c The context to set up.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if
+ * @p pCrc32c is NULL.
+ */
+/* @[declare_sigV4_crc32cInit_function] */
+SigV4Status_t SigV4_Crc32cInit( SigV4Crc32c_t * pCrc32c );
+/* @[declare_sigV4_crc32cInit_function] */
+
+/**
+ * @brief Add data to the checksum.
+ *
+ * @param[in, out] pCrc32c The context.
+ * @param[in] pData The data. It may be NULL if @p dataLen is zero.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a
+ * parameter is NULL.
+ */
+/* @[declare_sigV4_crc32cUpdate_function] */
+SigV4Status_t SigV4_Crc32cUpdate( SigV4Crc32c_t * pCrc32c,
+                                  const uint8_t * pData,
+                                  size_t dataLen );
+/* @[declare_sigV4_crc32cUpdate_function] */
+
+/**
+ * @brief Get the checksum of the data added so far.
+ *
+ * The context is not changed, so more data can still be added.
+ *
+ * @param[in] pCrc32c The context.
+ * @param[out] pChecksum The checksum.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a
+ * parameter is NULL.
+ */
+/* @[declare_sigV4_crc32cFinal_function] */
+SigV4Status_t SigV4_Crc32cFinal( const SigV4Crc32c_t * pCrc32c,
+                                 uint32_t * pChecksum );
+/* @[declare_sigV4_crc32cFinal_function] */
+
+/**
+ * @brief Add a chunk of an upload signed with
+ * #SIGV4_STREAMING_UNSIGNED_PAYLOAD_TRAILER to the checksum, and write its
+ * chunk header.
+ *
+ * The header is the hex-encoded chunk size followed by "\r\n". The
+ * application sends the header, the chunk data, and "\r\n". After the last
+ * chunk, it sends the trailer written by #SigV4_Crc32cTrailer.
+ *
+ * @param[in, out] pCrc32c The checksum of the upload, set up with
+ * #SigV4_Crc32cInit.
+ * @param[in] pChunk The chunk data.
+ * @param[in] chunkLen The length of the chunk, which must not be zero.
+ * @param[out] pHeaderBuf The buffer for the chunk header.
+ * @param[in, out] pHeaderBufLen Input: the length of @p pHeaderBuf. At most
+ * #SIGV4_UNSIGNED_CHUNK_HEADER_MAX_LENGTH is needed. Output: the length of
+ * the header.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a
+ * parameter is NULL or @p chunkLen is zero, #SigV4InsufficientMemory if the
+ * header does not fit. The checksum is only updated on success.
+ */
+/* @[declare_sigV4_crc32cChunkHeader_function] */
+SigV4Status_t SigV4_Crc32cChunkHeader( SigV4Crc32c_t * pCrc32c,
+                                       const char * pChunk,
+                                       size_t chunkLen,
+                                       char * pHeaderBuf,
+                                       size_t * pHeaderBufLen );
+/* @[declare_sigV4_crc32cChunkHeader_function] */
+
+/**
+ * @brief Write the final, empty chunk of an upload and its
+ * x-amz-checksum-crc32c trailer.
+ *
+ * The checksum is the base64 encoding of the big-endian CRC32C of the
+ * upload. The request must declare the trailer with the
+ * #SIGV4_HTTP_X_AMZ_TRAILER_HEADER header.
+ *
+ * @param[in] pCrc32c The checksum of the upload.
+ * @param[out] pTrailerBuf The buffer for the final chunk and the trailer.
+ * @param[in] trailerBufLen The length of @p pTrailerBuf, at least
+ * #SIGV4_CRC32C_TRAILER_LENGTH.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a
+ * parameter is NULL, #SigV4InsufficientMemory if the trailer does not fit.
+ */
+/* @[declare_sigV4_crc32cTrailer_function] */
+SigV4Status_t SigV4_Crc32cTrailer( const SigV4Crc32c_t * pCrc32c,
+                                   char * pTrailerBuf,
+                                   size_t trailerBufLen );
+/* @[declare_sigV4_crc32cTrailer_function] */
+
+#endif /* SIGV4_CRC32C_H_ */
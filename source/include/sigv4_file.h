@@ -0,0 +1,80 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file sigv4_file.h
+ * @brief Interface for the optional POSIX file payload hashing helper of the
+ * SigV4 Client Utility Library.
+ *
+ * Applications that upload files can build sigv4_file.c and use
+ * #SigV4_HashFile to compute the payload hash of a file without reading it
+ * into a buffer first. The hash is then signed with
+ * #SIGV4_HTTP_PAYLOAD_IS_HASH.
+ */
+
+#ifndef SIGV4_FILE_H_
+#define SIGV4_FILE_H_
+
+/* Include SigV4 library header for the cryptography interface. */
+#include "sigv4.h"
+
+/**
+ * @brief Compute the hex-encoded payload hash of a file.
+ *
+ * The file is mapped into memory #SIGV4_FILE_MAP_WINDOW_LENGTH bytes at a
+ * time and hashed straight from the page cache, so it is not copied into a
+ * buffer. The mappings are advised for sequential access, and the kernel is
+ * asked to read the next window ahead while the current one is hashed.
+ *
+ * @note The file must not be truncated while it is hashed. Accessing a
+ * mapped page beyond the end of a file raises SIGBUS.
+ *
+ * @param[in] pCryptoInterface The hash functions and context to use.
+ * @param[in] pFilePath The path of a regular file.
+ * @param[out] pHexPayloadHash The buffer for the hash. It is not
+ * null-terminated.
+ * @param[in] hexPayloadHashLen The length of @p pHexPayloadHash, at least
+ * #SIGV4_HEX_PAYLOAD_HASH_LENGTH.
+ * @param[out] pFileLen The length of the file, for the Content-Length
+ * header. This may be NULL.
+ *
+ * @return #SigV4Success if successful, or:
+ * <br>
+ * #SigV4InvalidParameter if a parameter or hash function is NULL.
+ * <br>
+ * #SigV4InsufficientMemory if @p pHexPayloadHash is too small.
+ * <br>
+ * #SigV4FileError if the file could not be opened or mapped, or is not a
+ * regular file.
+ * <br>
+ * #SigV4HashError if the #SigV4CryptoInterface_t reported an error.
+ */
+/* @[declare_sigV4_hashFile_function] */
+SigV4Status_t SigV4_HashFile( const SigV4CryptoInterface_t * pCryptoInterface,
+                              const char * pFilePath,
+                              char * pHexPayloadHash,
+                              size_t hexPayloadHashLen,
+                              uint64_t * pFileLen );
+/* @[declare_sigV4_hashFile_function] */
+
+#endif /* SIGV4_FILE_H_ */
@@ -50,6 +50,113 @@
 
 #define ISO_YEAR_LEN           4U                                 /**< Length of year value in ISO 8601 date. */
 #define ISO_NON_YEAR_LEN       2U                                 /**< Length of non-year values in ISO 8601 date. */
+#define ISO_DATE_SCOPE_LEN     8U                                 /**< Length of the date (YYYYMMDD) used in the credential scope. */
+
+/* Constants for the SigV4 signing process. */
+#define HMAC_INNER_PAD_BYTE               0x36U                               /**< Byte XOR-ed with the HMAC key to form the inner padding. */
+#define HMAC_OUTER_PAD_BYTE               0x5CU                               /**< Byte XOR-ed with the HMAC key to form the outer padding. */
+#define HMAC_DEFAULT_BLOCK_LENGTH         64U                                 /**< Block length used when #SigV4CryptoInterface_t.hashBlockLen is 0. */
+#define HEX_ENCODED_DIGEST_LEN            ( SIGV4_HASH_DIGEST_LENGTH * 2U )   /**< Length of a hex-encoded hash digest. */
+
+#define SIGNING_KEY_PREFIX                "AWS4"                              /**< Prefix prepended to the secret access key to form the first HMAC key. */
+#define SIGNING_KEY_PREFIX_LEN            ( sizeof( SIGNING_KEY_PREFIX ) - 1U ) /**< Length of #SIGNING_KEY_PREFIX. */
+#define CREDENTIAL_SCOPE_TERMINATOR       "aws4_request"                      /**< Final element of the credential scope. */
+#define CREDENTIAL_SCOPE_TERMINATOR_LEN   ( sizeof( CREDENTIAL_SCOPE_TERMINATOR ) - 1U ) /**< Length of #CREDENTIAL_SCOPE_TERMINATOR. */
+
+#define AUTH_CREDENTIAL_PREFIX            " Credential="                      /**< Precedes the credential scope in the Authorization header value. */
+#define AUTH_CREDENTIAL_PREFIX_LEN        ( sizeof( AUTH_CREDENTIAL_PREFIX ) - 1U ) /**< Length of #AUTH_CREDENTIAL_PREFIX. */
+#define AUTH_SIGNED_HEADERS_PREFIX        ", SignedHeaders="                  /**< Precedes the signed headers in the Authorization header value. */
+#define AUTH_SIGNED_HEADERS_PREFIX_LEN    ( sizeof( AUTH_SIGNED_HEADERS_PREFIX ) - 1U ) /**< Length of #AUTH_SIGNED_HEADERS_PREFIX. */
+#define AUTH_SIGNATURE_PREFIX             ", Signature="                      /**< Precedes the signature in the Authorization header value. */
+#define AUTH_SIGNATURE_PREFIX_LEN         ( sizeof( AUTH_SIGNATURE_PREFIX ) - 1U ) /**< Length of #AUTH_SIGNATURE_PREFIX. */
+
+#define PRESIGNED_PARAM_PREFIX            "X-Amz-"                            /**< Prefix of the names of the query parameters added to a presigned URL. */
+#define PRESIGNED_PARAM_PREFIX_LEN        ( sizeof( PRESIGNED_PARAM_PREFIX ) - 1U ) /**< Length of #PRESIGNED_PARAM_PREFIX. */
+#define PRESIGNED_CREDENTIAL_PREFIX       "X-Amz-Algorithm=" SIGV4_AWS4_HMAC_SHA256 "&X-Amz-Credential=" /**< Starts the X-Amz- parameters of a presigned URL. */
+#define PRESIGNED_CREDENTIAL_PREFIX_LEN   ( sizeof( PRESIGNED_CREDENTIAL_PREFIX ) - 1U ) /**< Length of #PRESIGNED_CREDENTIAL_PREFIX. */
+#define PRESIGNED_DATE_PREFIX             "&X-Amz-Date="                      /**< Precedes the date in a presigned URL. */
+#define PRESIGNED_DATE_PREFIX_LEN         ( sizeof( PRESIGNED_DATE_PREFIX ) - 1U ) /**< Length of #PRESIGNED_DATE_PREFIX. */
+#define PRESIGNED_EXPIRES_PREFIX          "&X-Amz-Expires="                   /**< Precedes the validity in seconds in a presigned URL. */
+#define PRESIGNED_EXPIRES_PREFIX_LEN      ( sizeof( PRESIGNED_EXPIRES_PREFIX ) - 1U ) /**< Length of #PRESIGNED_EXPIRES_PREFIX. */
+#define PRESIGNED_TOKEN_PREFIX            "&X-Amz-Security-Token="            /**< Precedes the security token in a presigned URL. */
+#define PRESIGNED_TOKEN_PREFIX_LEN        ( sizeof( PRESIGNED_TOKEN_PREFIX ) - 1U ) /**< Length of #PRESIGNED_TOKEN_PREFIX. */
+#define PRESIGNED_HEADERS_PREFIX          "&X-Amz-SignedHeaders="             /**< Precedes the signed headers in a presigned URL. */
+#define PRESIGNED_HEADERS_PREFIX_LEN      ( sizeof( PRESIGNED_HEADERS_PREFIX ) - 1U ) /**< Length of #PRESIGNED_HEADERS_PREFIX. */
+#define PRESIGNED_SIGNATURE_PREFIX        "&X-Amz-Signature="                 /**< Precedes the signature in a presigned URL. */
+#define PRESIGNED_SIGNATURE_PREFIX_LEN    ( sizeof( PRESIGNED_SIGNATURE_PREFIX ) - 1U ) /**< Length of #PRESIGNED_SIGNATURE_PREFIX. */
+#define PRESIGNED_EXPIRES_MAX_DIGITS      6U                                  /**< Number of decimal digits of #SIGV4_PRESIGNED_URL_EXPIRES_MAX. */
+
+/**
+ * @brief Value of #SigV4PresignPool_t.published holding the slot numbers of
+ * the current and next windows. Slot numbers start at 1, and 0 means that no
+ * URL is published.
+ */
+#define PRESIGN_POOL_PUBLISHED( currentSlot, nextSlot )    ( ( uint32_t ) ( currentSlot ) | ( ( uint32_t ) ( nextSlot ) << 8 ) )
+#define PRESIGN_POOL_CURRENT_SLOT( published )             ( ( published ) & 0xFFU )        /**< Slot number of the current window in #SigV4PresignPool_t.published. */
+#define PRESIGN_POOL_NEXT_SLOT( published )                ( ( ( published ) >> 8 ) & 0xFFU ) /**< Slot number of the next window in #SigV4PresignPool_t.published. */
+#define PRESIGN_POOL_URL_WINDOWS                           2U                                /**< Number of windows each URL of a presign pool is valid for. */
+
+#define CHUNK_STRING_TO_SIGN_PREFIX       "AWS4-HMAC-SHA256-PAYLOAD"          /**< First line of the string to sign of a chunk. */
+#define CHUNK_STRING_TO_SIGN_PREFIX_LEN   ( sizeof( CHUNK_STRING_TO_SIGN_PREFIX ) - 1U ) /**< Length of #CHUNK_STRING_TO_SIGN_PREFIX. */
+#define CHUNK_SIGNATURE_PREFIX            ";chunk-signature="                 /**< Separates the chunk size from the chunk signature in the chunk header. */
+#define CHUNK_SIGNATURE_PREFIX_LEN        ( sizeof( CHUNK_SIGNATURE_PREFIX ) - 1U ) /**< Length of #CHUNK_SIGNATURE_PREFIX. */
+#define CHUNK_LINE_TERMINATOR             "\r\n"                              /**< Ends the chunk header, and the chunk data. */
+#define CHUNK_LINE_TERMINATOR_LEN         ( sizeof( CHUNK_LINE_TERMINATOR ) - 1U ) /**< Length of #CHUNK_LINE_TERMINATOR. */
+#define CHUNK_SIZE_MAX_DIGITS             ( 2U * sizeof( size_t ) )           /**< Number of hex digits of the largest chunk size. */
+
+#define UNSIGNED_PAYLOAD_LEN              ( sizeof( SIGV4_UNSIGNED_PAYLOAD ) - 1U ) /**< Length of #SIGV4_UNSIGNED_PAYLOAD. */
+#define X_AMZ_DATE_HEADER_LEN             ( sizeof( SIGV4_HTTP_X_AMZ_DATE_HEADER ) - 1U ) /**< Length of #SIGV4_HTTP_X_AMZ_DATE_HEADER. */
+#define X_AMZ_SECURITY_TOKEN_HEADER_LEN   ( sizeof( SIGV4_HTTP_X_AMZ_SECURITY_TOKEN_HEADER ) - 1U ) /**< Length of #SIGV4_HTTP_X_AMZ_SECURITY_TOKEN_HEADER. */
+
+/* The signing algorithm is always AWS4-HMAC-SHA256, so the hash of an empty
+ * payload is known whenever the digest length is that of SHA-256. */
+#if ( SIGV4_HASH_DIGEST_LENGTH == 32U )
+    #define EMPTY_PAYLOAD_HASH            "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855" /**< Hex-encoded SHA-256 hash of an empty payload. */
+#endif
+
+#define EVENT_DATE_HEADER_NAME            ":date"                             /**< Name of the timestamp header of a signed event. */
+#define EVENT_DATE_HEADER_NAME_LEN        ( sizeof( EVENT_DATE_HEADER_NAME ) - 1U ) /**< Length of #EVENT_DATE_HEADER_NAME. */
+#define EVENT_SIGNATURE_HEADER_NAME       ":chunk-signature"                  /**< Name of the signature header of a signed event. */
+#define EVENT_SIGNATURE_HEADER_NAME_LEN   ( sizeof( EVENT_SIGNATURE_HEADER_NAME ) - 1U ) /**< Length of #EVENT_SIGNATURE_HEADER_NAME. */
+#define EVENT_HEADER_TYPE_BYTE_ARRAY      6U                                  /**< Event stream header value type of a byte array. */
+#define EVENT_HEADER_TYPE_TIMESTAMP       8U                                  /**< Event stream header value type of a timestamp. */
+#define EVENT_DATE_HEADER_LEN             ( 1U + EVENT_DATE_HEADER_NAME_LEN + 1U + 8U ) /**< Length of the encoded ":date" header. */
+#define SECONDS_PER_DAY                   86400UL                             /**< Number of seconds in a day. */
+#define EVENT_TIME_MAX                    ( ( ( uint64_t ) 2932897UL * SECONDS_PER_DAY ) - 1U ) /**< Last second of the year 9999, 2932897 days after the Unix epoch. */
+#define MILLISECONDS_PER_SECOND           1000U                               /**< Number of milliseconds in a second. */
+#define UNIX_EPOCH_YEAR                   1970L                               /**< Year of the Unix epoch, the earliest accepted credential expiration. */
+
+#define HTTP_EMPTY_PATH                   "/"                                 /**< Canonical URI used when the request path is empty. */
+#define S3_SERVICE_NAME                   "s3"                                /**< Service whose request paths are URI-encoded only once. */
+#define S3_SERVICE_NAME_LEN               ( sizeof( S3_SERVICE_NAME ) - 1U )  /**< Length of #S3_SERVICE_NAME. */
+#define PATH_NOT_ENCODED                  0U                                  /**< The request path is written as is. */
+#define PATH_ENCODED_ONCE                 1U                                  /**< The request path is URI-encoded once, as S3 expects. */
+#define PATH_ENCODED_TWICE                2U                                  /**< The request path is URI-encoded twice, as the other services expect. */
+
+#define LINEFEED_CHAR                     '\n'                                /**< Separates the elements of the canonical request and string to sign. */
+#define CARRIAGE_RETURN_CHAR              '\r'                                /**< Precedes the linefeed terminating a raw HTTP header. */
+#define HTTP_HEADER_NAME_SEPARATOR        ':'                                 /**< Separates a header name from its value. */
+#define SIGNED_HEADERS_SEPARATOR          ';'                                 /**< Separates header names in the signed headers list. */
+#define HEADER_VALUE_SEPARATOR            ','                                 /**< Joins the values of repeated header names. */
+#define QUERY_PAIR_SEPARATOR              '&'                                 /**< Separates query key/value pairs. */
+#define QUERY_VALUE_SEPARATOR             '='                                 /**< Separates a query key from its value. */
+#define SCOPE_SEPARATOR                   '/'                                 /**< Separates the elements of the credential scope. */
+#define SCOPE_SEPARATOR_ENCODED           "%2F"                               /**< URI encoding of #SCOPE_SEPARATOR, used in the X-Amz-Credential parameter. */
+#define SIGNED_HEADERS_SEPARATOR_ENCODED  "%3B"                               /**< URI encoding of #SIGNED_HEADERS_SEPARATOR, used in the X-Amz-SignedHeaders parameter. */
+#define URI_ENCODE_ESCAPE_CHAR            '%'                                 /**< Introduces a percent-encoded octet. */
+#define HEADER_NAME_PREFIX_LEN            8U                                  /**< Number of header name characters packed in HeaderRecord_t.namePrefix. */
+#define URI_ENCODED_OCTET_LEN             3U                                  /**< Length of a single percent-encoded octet, e.g. "%2F". */
+#define URI_CHAR_UNRESERVED               0x01U                               /**< Class of the RFC 3986 unreserved characters. */
+#define URI_CHAR_SLASH                    0x02U                               /**< Class of '/', which is not encoded in paths. */
+#define QUERY_KEY_PREFIX_LEN              8U                                  /**< Number of encoded query key characters packed in QueryRecord_t.keyPrefix. */
+
+/* Constants to scan a uint64_t word for a byte value in parallel (SIMD within
+ * a register). They are built from 32-bit halves, as C90 has no 64-bit
+ * integer constants. */
+#define SWAR_LOW_BITS                     ( ( ( uint64_t ) 0x01010101UL << 32 ) | ( uint64_t ) 0x01010101UL ) /**< The lowest bit of each byte. */
+#define SWAR_HIGH_BITS                    ( SWAR_LOW_BITS << 7 )              /**< The highest bit of each byte. */
+#define SWAR_BROADCAST( byte )            ( SWAR_LOW_BITS * ( uint64_t ) ( uint8_t ) ( byte ) ) /**< A word with every byte equal to byte. */
+#define SWAR_HAS_ZERO_BYTE( word )        ( ( ( word ) - SWAR_LOW_BITS ) & ~( word ) & SWAR_HIGH_BITS ) /**< Non-zero if and only if a byte of word is zero. */
 
 /**
  * @brief An aggregator representing the individually parsed elements of the
@@ -66,4 +173,139 @@ typedef struct SigV4DateTime
     int32_t tm_sec;  /**< Seconds (0 to 60) */
 } SigV4DateTime_t;
 
+/**
+ * @brief A read-only string that is not necessarily NULL-terminated.
+ */
+typedef struct SigV4ConstString
+{
+    const char * pData; /**< Pointer to the first character of the string. */
+    size_t dataLen;     /**< Length of pData. */
+} SigV4ConstString_t;
+
+/**
+ * @brief Location of a query pair, and the start of its URI-encoded key for
+ * fast sorting.
+ *
+ * As for #HeaderRecord_t, sorting the query only moves these records.
+ */
+typedef struct QueryRecord
+{
+    /**
+     * @brief The first #QUERY_KEY_PREFIX_LEN characters of the URI-encoded
+     * key, packed big-endian and zero-padded, so that comparing two prefixes
+     * as integers orders the encoded keys.
+     */
+    uint64_t keyPrefix;
+    const char * pKey; /**< Start of the key. The value, if any, starts after the '=' following the key. */
+    uint32_t keyLen;   /**< Length of the key. */
+    uint32_t valueLen; /**< Length of the value. */
+} QueryRecord_t;
+
+/**
+ * @brief Location of a header, and the start of its name for fast sorting.
+ *
+ * The header bytes themselves are never copied or moved: sorting the headers
+ * only moves these records.
+ */
+typedef struct HeaderRecord
+{
+    /**
+     * @brief The first #HEADER_NAME_PREFIX_LEN characters of the lowercase
+     * name, packed big-endian and zero-padded, so that comparing two prefixes
+     * as integers orders the names.
+     */
+    uint64_t namePrefix;
+    const char * pName; /**< Start of the header name. The value starts after the ':' following the name. */
+    uint32_t nameLen;   /**< Length of the header name. */
+    uint32_t valueLen;  /**< Length of the header value. */
+} HeaderRecord_t;
+
+/**
+ * @brief A bounded output buffer that is filled from front to back.
+ *
+ * When pCryptoInterface is set, the buffer is a window onto a hash input
+ * stream: data that does not fit is not an error, the buffered bytes are
+ * passed to hashUpdate to make room instead.
+ */
+typedef struct SigV4Buffer
+{
+    char * pData;     /**< Start of the buffer. */
+    size_t bufferLen; /**< Total length of pData. */
+    size_t dataLen;   /**< Number of bytes written to pData so far. */
+
+    /**
+     * @brief Hash interface that the buffer is flushed to, or NULL if the
+     * buffer is not streamed.
+     */
+    const SigV4CryptoInterface_t * pCryptoInterface;
+
+    /**
+     * @brief Snapshot that receives a copy of the data passed to the hash,
+     * or NULL.
+     */
+    SigV4RetrySnapshot_t * pRetrySnapshot;
+} SigV4Buffer_t;
+
+/**
+ * @brief State used to compute an HMAC with the user-provided hash interface.
+ *
+ * Only the padded key block is kept, so that the single hash context of the
+ * #SigV4CryptoInterface_t can be used for both the inner and outer hash.
+ */
+typedef struct HmacContext
+{
+    const SigV4CryptoInterface_t * pCryptoInterface; /**< Hash functions and context. */
+    uint8_t key[ SIGV4_HASH_MAX_BLOCK_LENGTH ];      /**< The key, padded (and XOR-ed) to the block length. */
+} HmacContext_t;
+
+/**
+ * @brief Longest message that #HmacLanes_t can hold after a padded key block.
+ */
+#define HMAC_LANE_MAX_DATA_LENGTH    SIGV4_HASH_MAX_BLOCK_LENGTH
+
+/**
+ * @brief Working memory used to compute several HMACs together with
+ * #SigV4CryptoInterface_t.hashMultiple.
+ *
+ * Each lane holds a padded key block followed by the message, so that it can
+ * be hashed in one call. The messages of the signing key derivation are short
+ * (a region, a service, "aws4_request", or an inner digest).
+ */
+typedef struct HmacLanes
+{
+    uint8_t pBuffers[ SIGV4_HASH_MULTIPLE_MAX_COUNT ][ SIGV4_HASH_MAX_BLOCK_LENGTH + HMAC_LANE_MAX_DATA_LENGTH ]; /**< Padded key block and message of each lane. */
+    const uint8_t * pInputs[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];                                                      /**< Pointers to pBuffers. */
+    size_t pInputLens[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];                                                            /**< Length of the input in each lane. */
+    uint8_t pInnerDigests[ SIGV4_HASH_MULTIPLE_MAX_COUNT * SIGV4_HASH_DIGEST_LENGTH ];                             /**< Inner hash of each lane. */
+} HmacLanes_t;
+
+/**
+ * @brief The Authorization value prefix, up to "SignedHeaders=", shared by
+ * all requests of a batch.
+ */
+typedef struct AuthorizationPrefix
+{
+    SigV4ConstString_t value;           /**< The prefix, in the Authorization buffer it was first written to. */
+    SigV4ConstString_t credentialScope; /**< The credential scope within the prefix. */
+} AuthorizationPrefix_t;
+
+/**
+ * @brief All working memory used to generate a signature.
+ *
+ * This is the only sizable memory used by #SigV4_GenerateHTTPAuthorization,
+ * and it is placed on the stack of that function.
+ */
+typedef struct CanonicalContext
+{
+    QueryRecord_t pQueryLoc[ SIGV4_MAX_QUERY_PAIR_COUNT ];           /**< Locations of the query pairs. */
+    size_t queryCount;                                               /**< Number of valid entries in pQueryLoc. */
+    HeaderRecord_t pHeadersLoc[ SIGV4_MAX_HTTP_HEADER_COUNT ];       /**< Locations of the headers. */
+    size_t headersCount;                                             /**< Number of valid entries in pHeadersLoc. */
+    char pBufProcessing[ SIGV4_PROCESSING_BUFFER_LENGTH ];           /**< Window onto the canonical request, then holds the string to sign. */
+    SigV4Buffer_t processing;                                        /**< Write state of pBufProcessing. */
+    HmacContext_t hmac;                                              /**< State of the HMAC currently being computed. */
+    SigV4RetrySnapshot_t * pRetrySnapshot;                           /**< Snapshot to save at the x-amz-date value, or NULL. */
+    SigV4ConstString_t securityToken;                                /**< Security token of the credentials, left out of the snapshot. */
+} CanonicalContext_t;
+
 #endif /* ifndef SIGV4_INTERNAL_H_ */
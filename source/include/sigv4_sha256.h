@@ -0,0 +1,179 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file sigv4_sha256.h
+ * @brief Interface for the optional SHA-256 implementation bundled with the
+ * SigV4 Client Utility Library.
+ *
+ * Applications that have no SHA-256 implementation of their own can build
+ * sigv4_sha256.c and use #SigV4_Sha256InitCryptoInterface to obtain a ready
+ * #SigV4CryptoInterface_t.
+ */
+
+#ifndef SIGV4_SHA256_H_
+#define SIGV4_SHA256_H_
+
+/* Include SigV4 library header for the cryptography interface. */
+#include "sigv4.h"
+
+/** @addtogroup sigv4_constants
+ *  @{
+ */
+#define SIGV4_SHA256_DIGEST_LENGTH    32U /**< Length of a SHA-256 digest. */
+#define SIGV4_SHA256_BLOCK_LENGTH     64U /**< Length of a SHA-256 block. */
+/** @}*/
+
+/**
+ * @ingroup sigv4_struct_types
+ * @brief The state of an incremental SHA-256 computation.
+ *
+ * A context must be set up with #SigV4_Sha256InitCryptoInterface, which
+ * selects the compression function, before it is used.
+ */
+typedef struct SigV4Sha256Context
+{
+    uint32_t state[ 8 ];                          /**< The intermediate hash value. */
+    uint64_t inputLen;                            /**< Number of bytes hashed so far. */
+    uint8_t block[ SIGV4_SHA256_BLOCK_LENGTH ];   /**< Input waiting for a full block. */
+    size_t blockLen;                              /**< Number of bytes in block. */
+
+    /**
+     * @brief 1 if blocks are compressed with the x86 SHA extensions, 0 if
+     * they are compressed in portable C.
+     */
+    uint8_t useShaNi;
+
+    /**
+     * @brief 1 if #SigV4_Sha256HashMultiple may hash eight messages together
+     * with AVX2, 0 if it hashes them one after another. It is not used when
+     * useShaNi is 1.
+     */
+    uint8_t useAvx2;
+} SigV4Sha256Context_t;
+
+/**
+ * @brief Set up a context and a cryptography interface that hashes with the
+ * bundled SHA-256 implementation.
+ *
+ * When #SIGV4_SHA256_USE_SHA_NI is 1 and the library is built for x86 with
+ * GCC or Clang, the processor is queried for the SHA extensions, and blocks
+ * are compressed with them if they are present. Otherwise blocks are
+ * compressed in portable C.
+ *
+ * All the members of @p pCryptoInterface are set, including
+ * #SigV4CryptoInterface_t.hashCopyContext, so the interface can save the HMAC
+ * states of a #SigV4SigningKeyCache_t whose storage holds a
+ * #SigV4Sha256Context_t.
+ *
+ * @param[out] pCryptoInterface The interface to set up.
+ * @param[out] pContext The hash context used by @p pCryptoInterface.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a parameter
+ * is NULL.
+ */
+/* @[declare_sigV4_sha256InitCryptoInterface_function] */
+SigV4Status_t SigV4_Sha256InitCryptoInterface( SigV4CryptoInterface_t * pCryptoInterface,
+                                               SigV4Sha256Context_t * pContext );
+/* @[declare_sigV4_sha256InitCryptoInterface_function] */
+
+/**
+ * @brief Start a new SHA-256 computation.
+ *
+ * This matches #SigV4CryptoInterface_t.hashInit.
+ *
+ * @param[in, out] pHashContext A #SigV4Sha256Context_t.
+ *
+ * @return Zero on success, -1 if @p pHashContext is NULL.
+ */
+int32_t SigV4_Sha256Init( void * pHashContext );
+
+/**
+ * @brief Hash more input.
+ *
+ * This matches #SigV4CryptoInterface_t.hashUpdate.
+ *
+ * @param[in, out] pHashContext A #SigV4Sha256Context_t.
+ * @param[in] pInput The input to hash.
+ * @param[in] inputLen Length of @p pInput.
+ *
+ * @return Zero on success, -1 if a parameter is NULL.
+ */
+int32_t SigV4_Sha256Update( void * pHashContext,
+                            const uint8_t * pInput,
+                            size_t inputLen );
+
+/**
+ * @brief Finish the computation and write the digest.
+ *
+ * This matches #SigV4CryptoInterface_t.hashFinal.
+ *
+ * @param[in, out] pHashContext A #SigV4Sha256Context_t.
+ * @param[out] pOutput Buffer receiving the digest.
+ * @param[in] outputLen Length of @p pOutput, at least
+ * #SIGV4_SHA256_DIGEST_LENGTH.
+ *
+ * @return Zero on success, -1 if a parameter is NULL or @p pOutput is too
+ * small.
+ */
+int32_t SigV4_Sha256Final( void * pHashContext,
+                           uint8_t * pOutput,
+                           size_t outputLen );
+
+/**
+ * @brief Copy the state of a computation to another context.
+ *
+ * This matches #SigV4CryptoInterface_t.hashCopyContext.
+ *
+ * @param[out] pDestContext The #SigV4Sha256Context_t to copy to.
+ * @param[in] pSrcContext The #SigV4Sha256Context_t to copy from.
+ *
+ * @return Zero on success, -1 if a parameter is NULL.
+ */
+int32_t SigV4_Sha256CopyContext( void * pDestContext,
+                                 const void * pSrcContext );
+
+/**
+ * @brief Hash several independent messages.
+ *
+ * This matches #SigV4CryptoInterface_t.hashMultiple. When
+ * #SigV4Sha256Context_t.useAvx2 is 1 and #SigV4Sha256Context_t.useShaNi is 0,
+ * the messages are hashed in groups of eight, one in each 32-bit lane of the
+ * AVX2 registers. Otherwise they are
+ * hashed one after another with the context, which loses any computation
+ * in progress.
+ *
+ * @param[in, out] pHashContext A #SigV4Sha256Context_t.
+ * @param[in] pInputs The messages.
+ * @param[in] pInputLens Length of each message.
+ * @param[out] pDigests Buffer receiving @p count digests, one after another.
+ * @param[in] count Number of messages.
+ *
+ * @return Zero on success, -1 if a parameter is NULL.
+ */
+int32_t SigV4_Sha256HashMultiple( void * pHashContext,
+                                  const uint8_t * const * pInputs,
+                                  const size_t * pInputLens,
+                                  uint8_t * pDigests,
+                                  size_t count );
+
+#endif /* SIGV4_SHA256_H_ */
@@ -31,6 +31,42 @@
 #include "sigv4.h"
 #include "sigv4_internal.h"
 
+/* SSE2 and AVX2 are used through compiler intrinsics, which are enabled per
+ * function with the target attribute of GCC and Clang. */
+#if defined( __x86_64__ ) && \
+    ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 7 ) ) )
+    #define URI_ENCODE_X86_INTRINSICS    1
+#else
+    #define URI_ENCODE_X86_INTRINSICS    0
+#endif
+
+#if ( URI_ENCODE_X86_INTRINSICS == 1 ) && ( SIGV4_URI_ENCODE_USE_SSE2 == 1 )
+    #define URI_ENCODE_SSE2_SUPPORTED    1
+#else
+    #define URI_ENCODE_SSE2_SUPPORTED    0
+#endif
+
+#if ( URI_ENCODE_X86_INTRINSICS == 1 ) && ( SIGV4_URI_ENCODE_USE_AVX2 == 1 )
+    #define URI_ENCODE_AVX2_SUPPORTED    1
+#else
+    #define URI_ENCODE_AVX2_SUPPORTED    0
+#endif
+
+#if ( URI_ENCODE_AVX2_SUPPORTED == 1 )
+    #include <cpuid.h>
+#endif
+
+#if ( URI_ENCODE_SSE2_SUPPORTED == 1 ) || ( URI_ENCODE_AVX2_SUPPORTED == 1 )
+    #include <immintrin.h>
+#endif
+
+#define URI_SCAN_SSE2_LENGTH         16U  /**< Characters classified at a time with SSE2. */
+#define URI_SCAN_AVX2_LENGTH         32U  /**< Characters classified at a time with AVX2. */
+#define URI_SCAN_AVX2_UNKNOWN        0U   /**< AVX2 support has not been checked yet. */
+#define URI_SCAN_AVX2_UNSUPPORTED    1U   /**< The processor or the OS does not support AVX2. */
+#define URI_SCAN_AVX2_SUPPORTED      2U   /**< AVX2 is used to find runs. */
+#define URI_SCAN_XCR0_AVX_STATE      0x6U /**< XCR0 bits of the SSE and AVX registers, saved by the OS. */
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -47,6 +83,53 @@ static void intToAscii( int32_t value,
                         char ** pBuffer,
                         size_t bufferLen );
 
+/**
+ * @brief Convert a time in seconds since the Unix epoch to its UTC date and
+ * time elements.
+ *
+ * @param[in] epochSeconds The time, at most #EVENT_TIME_MAX.
+ * @param[out] pDateElements The date and time elements.
+ */
+static void epochToDateTime( uint64_t epochSeconds,
+                             SigV4DateTime_t * pDateElements );
+
+/**
+ * @brief Convert a UTC date and time to seconds since the Unix epoch, the
+ * inverse of epochToDateTime().
+ *
+ * @param[in] pDateElements The valid date and time elements, in the year
+ * #UNIX_EPOCH_YEAR or later.
+ *
+ * @return The time in seconds since the Unix epoch.
+ */
+static uint64_t dateTimeToEpoch( const SigV4DateTime_t * pDateElements );
+
+/**
+ * @brief Parse the expiration date of credentials into seconds since the
+ * Unix epoch.
+ *
+ * @param[in] pExpiration The date in RFC 3339 or RFC 5322 format, or NULL.
+ * @param[in] expirationLen Length of @p pExpiration.
+ * @param[out] pExpirationTime The time, or 0 if @p pExpiration is NULL or
+ * empty.
+ *
+ * @return #SigV4Success if successful, #SigV4ISOFormattingError if the date is
+ * not valid or not after the Unix epoch.
+ */
+static SigV4Status_t parseExpirationTime( const char * pExpiration,
+                                          size_t expirationLen,
+                                          uint64_t * pExpirationTime );
+
+/**
+ * @brief Write a date in the ISO 8601 format, "YYYYMMDDThhmmssZ".
+ *
+ * @param[in] pDateElements The date and time elements.
+ * @param[out] pDateISO8601 The buffer of #SIGV4_ISO_STRING_LEN characters for
+ * the date.
+ */
+static void writeIso8601( const SigV4DateTime_t * pDateElements,
+                          char * pDateISO8601 );
+
 /**
  * @brief Check if the date represents a valid leap year day.
  *
@@ -122,244 +205,7507 @@ static SigV4Status_t parseDate( const char * pDate,
                                 size_t formatLen,
                                 SigV4DateTime_t * pDateElements );
 
-/*-----------------------------------------------------------*/
+/**
+ * @brief Encode binary data as a string of lowercase hexadecimal characters.
+ *
+ * @param[in] pInput The data to encode.
+ * @param[in] inputLen Length of @p pInput.
+ * @param[out] pHexOutput Buffer of at least 2 * @p inputLen characters.
+ */
+static void lowercaseHexEncode( const uint8_t * pInput,
+                                size_t inputLen,
+                                char * pHexOutput );
 
-static void intToAscii( int32_t value,
-                        char ** pBuffer,
-                        size_t bufferLen )
-{
-    int32_t currentVal = value;
-    size_t lenRemaining = bufferLen;
+/**
+ * @brief Pass the contents of a streamed buffer to the hash, and empty it.
+ *
+ * @param[in, out] pBuffer The streamed buffer.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t flushBuffer( SigV4Buffer_t * pBuffer );
 
-    assert( pBuffer != NULL );
-    assert( bufferLen > 0U );
+/**
+ * @brief Pass data of a streamed buffer to the hash, and copy it to the
+ * retry snapshot being saved, if any.
+ *
+ * A snapshot whose suffix the data does not fit in is dropped, so the request
+ * is still signed.
+ *
+ * @param[in, out] pBuffer The streamed buffer.
+ * @param[in] pData The data to hash.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hashStreamedData( SigV4Buffer_t * pBuffer,
+                                       const char * pData,
+                                       size_t dataLen );
 
-    /* Write base-10 remainder in its ASCII representation, and fill any
-     * remaining width with '0' characters. */
-    while( lenRemaining > 0U )
-    {
-        lenRemaining--;
-        ( *pBuffer )[ lenRemaining ] = ( char ) ( ( currentVal % 10 ) + '0' );
-        currentVal /= 10;
-    }
+/**
+ * @brief Append data to a bounded buffer.
+ *
+ * If the buffer is streamed, it is flushed when the data does not fit, and
+ * data larger than the whole buffer is hashed directly without being copied.
+ *
+ * @param[in, out] pBuffer The buffer to append to.
+ * @param[in] pData The data to append.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if the data fit, #SigV4InsufficientMemory if it did
+ * not, or #SigV4HashError if flushing a streamed buffer failed.
+ */
+static SigV4Status_t writeToBuffer( SigV4Buffer_t * pBuffer,
+                                    const char * pData,
+                                    size_t dataLen );
 
-    /* Move pointer to follow last written character. */
-    *pBuffer += bufferLen;
-}
+/**
+ * @brief Append a single character to a bounded buffer, flushing it first if
+ * it is streamed and full.
+ *
+ * @param[in, out] pBuffer The buffer to append to.
+ * @param[in] character The character to append.
+ *
+ * @return #SigV4Success if the character fit, #SigV4InsufficientMemory if it
+ * did not, or #SigV4HashError if flushing a streamed buffer failed.
+ */
+static SigV4Status_t writeCharToBuffer( SigV4Buffer_t * pBuffer,
+                                        char character );
 
-/*-----------------------------------------------------------*/
-static SigV4Status_t checkLeap( const SigV4DateTime_t * pDateElements )
-{
-    SigV4Status_t returnStatus = SigV4ISOFormattingError;
+/**
+ * @brief Hash data in a single operation with the user-provided interface.
+ *
+ * @param[in] pCryptoInterface The hash functions and context.
+ * @param[in] pInput The data to hash.
+ * @param[in] inputLen Length of @p pInput.
+ * @param[out] pDigest Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the digest.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t completeHash( const SigV4CryptoInterface_t * pCryptoInterface,
+                                   const uint8_t * pInput,
+                                   size_t inputLen,
+                                   uint8_t * pDigest );
 
-    assert( pDateElements != NULL );
+/**
+ * @brief Get the block length of the hash function of an interface.
+ *
+ * @param[in] pCryptoInterface The interface.
+ *
+ * @return #SigV4CryptoInterface_t.hashBlockLen, or #HMAC_DEFAULT_BLOCK_LENGTH
+ * if it is 0.
+ */
+static size_t getHashBlockLen( const SigV4CryptoInterface_t * pCryptoInterface );
 
-    /* If the date represents a leap day, verify that the leap year is valid. */
-    if( ( pDateElements->tm_mon == 2 ) && ( pDateElements->tm_mday == 29 ) )
-    {
-        if( ( ( pDateElements->tm_year % 400 ) != 0 ) &&
-            ( ( ( pDateElements->tm_year % 4 ) != 0 ) ||
-              ( ( pDateElements->tm_year % 100 ) == 0 ) ) )
-        {
-            LogError( ( "%ld is not a valid leap year.",
-                        ( long int ) pDateElements->tm_year ) );
-        }
-        else
-        {
-            returnStatus = SigV4Success;
-        }
-    }
+/**
+ * @brief Set the HMAC key and start the inner hash.
+ *
+ * The key is given in two parts, which are concatenated, so that the first
+ * key of the derivation chain ("AWS4" followed by the secret access key) does
+ * not need to be copied before use. Keys longer than the hash block length are
+ * hashed first, as specified by RFC 2104.
+ *
+ * @param[in, out] pHmac The HMAC context.
+ * @param[in] pKeyPrefix First part of the key. May be NULL if @p prefixLen is 0.
+ * @param[in] prefixLen Length of @p pKeyPrefix.
+ * @param[in] pKey Second part of the key.
+ * @param[in] keyLen Length of @p pKey.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacInit( HmacContext_t * pHmac,
+                               const uint8_t * pKeyPrefix,
+                               size_t prefixLen,
+                               const uint8_t * pKey,
+                               size_t keyLen );
 
-    return returnStatus;
-}
+/**
+ * @brief Add data to an ongoing HMAC.
+ *
+ * @param[in] pHmac The HMAC context.
+ * @param[in] pData The data to authenticate.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacUpdate( const HmacContext_t * pHmac,
+                                 const char * pData,
+                                 size_t dataLen );
 
-/*-----------------------------------------------------------*/
+/**
+ * @brief Complete the inner hash, then compute the outer hash of the HMAC.
+ *
+ * @param[in, out] pHmac The HMAC context.
+ * @param[out] pMac Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the result.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacFinal( HmacContext_t * pHmac,
+                                uint8_t * pMac );
 
-static SigV4Status_t validateDateTime( const SigV4DateTime_t * pDateElements )
-{
-    SigV4Status_t returnStatus = SigV4Success;
-    const int32_t daysPerMonth[] = MONTH_DAYS;
+/**
+ * @brief Compute a complete HMAC whose key is the output of a previous HMAC.
+ *
+ * @param[in, out] pHmac The HMAC context.
+ * @param[in, out] pKeyAndMac Input: the #SIGV4_HASH_DIGEST_LENGTH byte key,
+ * output: the resulting HMAC.
+ * @param[in] pData The data to authenticate.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t chainHmac( HmacContext_t * pHmac,
+                                uint8_t * pKeyAndMac,
+                                const char * pData,
+                                size_t dataLen );
 
-    assert( pDateElements != NULL );
+/**
+ * @brief Derive the signing key kSigning from the secret access key, and the
+ * date, region and service of the credential scope.
+ *
+ * @param[in] pParams Parameters containing the credentials and scope.
+ * @param[in, out] pHmac The HMAC context.
+ * @param[out] pSigningKey Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the key.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t deriveSigningKey( const SigV4Parameters_t * pParams,
+                                       HmacContext_t * pHmac,
+                                       uint8_t * pSigningKey );
 
-    if( pDateElements->tm_year < YEAR_MIN )
-    {
-        LogError( ( "Invalid 'year' value parsed from date string. "
-                    "Expected an integer %ld or greater, received: %ld",
-                    ( long int ) YEAR_MIN,
-                    ( long int ) pDateElements->tm_year ) );
-        returnStatus = SigV4ISOFormattingError;
-    }
+/**
+ * @brief Derive the first key of the chain, kDate, which only depends on the
+ * secret access key and the date.
+ *
+ * @param[in] pParams Parameters containing the credentials and date.
+ * @param[in, out] pHmac The HMAC context.
+ * @param[out] pDateKey Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the key.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t deriveDateKey( const SigV4Parameters_t * pParams,
+                                    HmacContext_t * pHmac,
+                                    uint8_t * pDateKey );
 
-    if( ( pDateElements->tm_mon < 1 ) || ( pDateElements->tm_mon > 12 ) )
-    {
-        LogError( ( "Invalid 'month' value parsed from date string. "
-                    "Expected an integer between 1 and 12, received: %ld",
-                    ( long int ) pDateElements->tm_mon ) );
-        returnStatus = SigV4ISOFormattingError;
-    }
+/**
+ * @brief Compute the HMACs of several messages, each with its own key, with
+ * #SigV4CryptoInterface_t.hashMultiple.
+ *
+ * @param[in] pCryptoInterface The hash functions and context.
+ * @param[in, out] pLanes Working memory for the padded key blocks.
+ * @param[in, out] pKeysAndMacs The keys of #SIGV4_HASH_DIGEST_LENGTH bytes,
+ * one after another, which are replaced by the HMACs.
+ * @param[in] pData The messages.
+ * @param[in] pDataLens Length of each message, at most
+ * #HMAC_LANE_MAX_DATA_LENGTH.
+ * @param[in] count Number of messages, at most #SIGV4_HASH_MULTIPLE_MAX_COUNT.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacMultiple( const SigV4CryptoInterface_t * pCryptoInterface,
+                                   HmacLanes_t * pLanes,
+                                   uint8_t * pKeysAndMacs,
+                                   const char * const * pData,
+                                   const size_t * pDataLens,
+                                   size_t count );
 
-    /* Ensure that the day of the month is valid for the relevant month. */
-    if( ( returnStatus != SigV4ISOFormattingError ) &&
-        ( ( pDateElements->tm_mday < 1 ) ||
-          ( pDateElements->tm_mday > daysPerMonth[ pDateElements->tm_mon - 1 ] ) ) )
-    {
-        /* Check if the date is a valid leap year day. */
-        returnStatus = checkLeap( pDateElements );
+/**
+ * @brief Derive the signing keys of several regions from kDate, one HMAC
+ * chain step at a time for all of them.
+ *
+ * @param[in] pParams Parameters containing the service and hash interface.
+ * @param[in, out] pLanes Working memory for the padded key blocks.
+ * @param[in] pDateKey The key kDate.
+ * @param[in] pRegions The regions.
+ * @param[in] pRegionLens Length of each region, at most
+ * #HMAC_LANE_MAX_DATA_LENGTH.
+ * @param[out] pSigningKeys Buffer for the @p count signing keys, one after
+ * another.
+ * @param[in] count Number of regions, at most #SIGV4_HASH_MULTIPLE_MAX_COUNT.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t deriveRegionKeysTogether( const SigV4Parameters_t * pParams,
+                                               HmacLanes_t * pLanes,
+                                               const uint8_t * pDateKey,
+                                               const char * const * pRegions,
+                                               const size_t * pRegionLens,
+                                               uint8_t * pSigningKeys,
+                                               size_t count );
 
-        if( returnStatus == SigV4ISOFormattingError )
-        {
-            LogError( ( "Invalid 'day' value parsed from date string. "
-                        "Expected an integer between 1 and %ld, received: %ld",
-                        ( long int ) daysPerMonth[ pDateElements->tm_mon - 1 ],
-                        ( long int ) pDateElements->tm_mday ) );
-        }
-    }
+/**
+ * @brief Store a signing key in the cache, with the tag identifying it and,
+ * when the cache has storage for them, its HMAC hash states.
+ *
+ * @param[in] pParams Parameters containing the credentials and scope.
+ * @param[in, out] pHmac The HMAC context.
+ * @param[in] pSigningKey The signing key.
+ * @param[in, out] pCache The cache.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory if the tag
+ * does not fit in the cache, #SigV4HashError if the hash states could not be
+ * saved.
+ */
+static SigV4Status_t storeSigningKey( const SigV4Parameters_t * pParams,
+                                      HmacContext_t * pHmac,
+                                      const uint8_t * pSigningKey,
+                                      SigV4SigningKeyCache_t * pCache );
 
-    /* SigV4DateTime_t values are asserted to be non-negative before they are
-     * assigned in function addToDate(). Therefore, we only verify logical upper
-     * bounds for the following values. */
-    if( pDateElements->tm_hour > 23 )
-    {
-        LogError( ( "Invalid 'hour' value parsed from date string. "
-                    "Expected an integer between 0 and 23, received: %ld",
-                    ( long int ) pDateElements->tm_hour ) );
-        returnStatus = SigV4ISOFormattingError;
-    }
+/**
+ * @brief Write the tag identifying a signing key: the credential scope date,
+ * region and service, followed by the secret access key.
+ *
+ * @param[in] pParams Parameters containing the credentials and scope.
+ * @param[in, out] pBuffer The buffer to write the tag to.
+ *
+ * @return #SigV4Success if the tag fit, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeSigningKeyTag( const SigV4Parameters_t * pParams,
+                                         SigV4Buffer_t * pBuffer );
 
-    if( pDateElements->tm_min > 59 )
-    {
-        LogError( ( "Invalid 'minute' value parsed from date string. "
-                    "Expected an integer between 0 and 59, received: %ld",
-                    ( long int ) pDateElements->tm_min ) );
-        returnStatus = SigV4ISOFormattingError;
-    }
+/**
+ * @brief Check whether the signing key for the given parameters is cached.
+ *
+ * @param[in] pCache The signing key cache.
+ * @param[in] pParams Parameters containing the credentials and scope.
+ *
+ * @return 1 if the cached key was derived from the same secret access key and
+ * credential scope, 0 otherwise.
+ */
+static uint8_t isSigningKeyCached( const SigV4SigningKeyCache_t * pCache,
+                                   const SigV4Parameters_t * pParams );
 
-    /* An upper limit of 60 accounts for the occasional leap second UTC
-     * adjustment. */
-    if( pDateElements->tm_sec > 60 )
-    {
-        LogError( ( "Invalid 'second' value parsed from date string. "
-                    "Expected an integer between 0 and 60, received: %ld",
-                    ( long int ) pDateElements->tm_sec ) );
-        returnStatus = SigV4ISOFormattingError;
-    }
+/**
+ * @brief Get the signing key from the cache, or derive it and update the
+ * cache, if one is configured.
+ *
+ * @param[in] pParams Parameters containing the credentials, scope and cache.
+ * @param[in, out] pHmac The HMAC context.
+ * @param[out] pSigningKey Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the key.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t getSigningKey( const SigV4Parameters_t * pParams,
+                                    HmacContext_t * pHmac,
+                                    uint8_t * pSigningKey );
 
-    return returnStatus;
-}
+/**
+ * @brief Save the HMAC inner and outer hash states of a signing key in the
+ * signing key cache, after hashing the padded key blocks.
+ *
+ * @param[in, out] pHmac The HMAC context.
+ * @param[in] pSigningKey The signing key.
+ * @param[in, out] pCache The cache providing storage for the hash states.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t saveHmacStates( HmacContext_t * pHmac,
+                                     const uint8_t * pSigningKey,
+                                     SigV4SigningKeyCache_t * pCache );
 
-/*-----------------------------------------------------------*/
+/**
+ * @brief Compute an HMAC with the signing key, starting from the hash states
+ * saved in the cache.
+ *
+ * @param[in] pCryptoInterface The hash functions and context.
+ * @param[in] pCache The cache holding the saved hash states.
+ * @param[in] pData The data to authenticate.
+ * @param[in] dataLen Length of @p pData.
+ * @param[out] pMac Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the HMAC.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacFromSavedStates( const SigV4CryptoInterface_t * pCryptoInterface,
+                                          const SigV4SigningKeyCache_t * pCache,
+                                          const char * pData,
+                                          size_t dataLen,
+                                          uint8_t * pMac );
 
-static void addToDate( const char formatChar,
-                       int32_t result,
-                       SigV4DateTime_t * pDateElements )
-{
-    assert( pDateElements != NULL );
-    assert( result >= 0 );
+/**
+ * @brief Compute an HMAC with the signing key, using the hash states saved in
+ * the cache if available.
+ *
+ * @param[in] pCache The cache holding the signing key, or NULL.
+ * @param[in, out] pHmac The HMAC context, whose hash interface is set.
+ * @param[in, out] pKeyAndMac The signing key, overwritten by the HMAC.
+ * @param[in] pData The data to authenticate.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hmacWithSigningKey( const SigV4SigningKeyCache_t * pCache,
+                                         HmacContext_t * pHmac,
+                                         uint8_t * pKeyAndMac,
+                                         const char * pData,
+                                         size_t dataLen );
 
-    switch( formatChar )
-    {
-        case 'Y':
-            pDateElements->tm_year = result;
-            break;
+/**
+ * @brief Classify a character for URI encoding with a lookup table.
+ *
+ * @param[in] character The character to classify.
+ *
+ * @return #URI_CHAR_UNRESERVED, #URI_CHAR_SLASH or 0.
+ */
+static uint8_t getUriCharClass( char character );
 
-        case 'M':
-            pDateElements->tm_mon = result;
-            break;
+/**
+ * @brief Find the end of a run of characters that are written unencoded,
+ * with SSE2 or AVX2 where they are available, and the lookup table of
+ * getUriCharClass() otherwise.
+ *
+ * @param[in] pData The data to scan.
+ * @param[in] start Index to start the scan at.
+ * @param[in] dataLen Length of @p pData.
+ * @param[in] encodeSlash 0 to include '/' characters in the run, 1 otherwise.
+ *
+ * @return Index of the first character to encode, or @p dataLen if there is
+ * none.
+ */
+static size_t findUnencodedRunEnd( const char * pData,
+                                   size_t start,
+                                   size_t dataLen,
+                                   uint8_t encodeSlash );
 
-        case 'D':
-            pDateElements->tm_mday = result;
-            break;
+#if ( URI_ENCODE_SSE2_SUPPORTED == 1 )
 
-        case 'h':
-            pDateElements->tm_hour = result;
-            break;
+/**
+ * @brief Find the end of a run of characters that are written unencoded,
+ * 16 characters at a time with SSE2.
+ *
+ * @param[in] pData The data to scan.
+ * @param[in] start Index to start the scan at.
+ * @param[in] dataLen Length of @p pData.
+ * @param[in] encodeSlash 0 to include '/' characters in the run, 1 otherwise.
+ *
+ * @return Index of the first character to encode, or of the first of the
+ * last characters that do not fill 16 bytes.
+ */
+    static size_t scanUnencodedRunSse2( const char * pData,
+                                        size_t start,
+                                        size_t dataLen,
+                                        uint8_t encodeSlash ) __attribute__( ( target( "sse2" ) ) );
 
-        case 'm':
-            pDateElements->tm_min = result;
-            break;
+#endif /* #if ( URI_ENCODE_SSE2_SUPPORTED == 1 ) */
+
+#if ( URI_ENCODE_AVX2_SUPPORTED == 1 )
+
+/**
+ * @brief Find the end of a run of characters that are written unencoded,
+ * 32 characters at a time with AVX2.
+ *
+ * @param[in] pData The data to scan.
+ * @param[in] start Index to start the scan at.
+ * @param[in] dataLen Length of @p pData.
+ * @param[in] encodeSlash 0 to include '/' characters in the run, 1 otherwise.
+ *
+ * @return Index of the first character to encode, or of the first of the
+ * last characters that do not fill 32 bytes.
+ */
+    static size_t scanUnencodedRunAvx2( const char * pData,
+                                        size_t start,
+                                        size_t dataLen,
+                                        uint8_t encodeSlash ) __attribute__( ( target( "avx2" ) ) );
+
+/**
+ * @brief Check once whether the processor and the operating system support
+ * AVX2, and remember the result for later URI encodings.
+ *
+ * @return 1 if AVX2 can be used, 0 otherwise.
+ */
+    static uint8_t useUriScanAvx2( void );
+
+#endif /* #if ( URI_ENCODE_AVX2_SUPPORTED == 1 ) */
+
+/**
+ * @brief URI-encode data into a buffer.
+ *
+ * @param[in, out] pBuffer The buffer to append the encoded data to.
+ * @param[in] pData The data to encode.
+ * @param[in] dataLen Length of @p pData.
+ * @param[in] encodeSlash 0 to leave '/' characters unencoded, 1 otherwise.
+ * @param[in] doubleEncode 1 to encode the result of the encoding a second time
+ * (so that "%XX" is written as "%25XX"), 0 otherwise.
+ *
+ * @return #SigV4Success if the encoded data fit, #SigV4InsufficientMemory
+ * otherwise.
+ */
+static SigV4Status_t writeEncodedData( SigV4Buffer_t * pBuffer,
+                                       const char * pData,
+                                       size_t dataLen,
+                                       uint8_t encodeSlash,
+                                       uint8_t doubleEncode );
+
+#if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+
+/**
+ * @brief Check whether a service URI-encodes request paths only once.
+ *
+ * @param[in] pParams Parameters containing the service name.
+ *
+ * @return 1 if the service is S3, 0 otherwise.
+ */
+    static uint8_t isS3Service( const SigV4Parameters_t * pParams );
+
+/**
+ * @brief Check whether a character belongs to the RFC 3986 unreserved set,
+ * which is never URI-encoded.
+ *
+ * @param[in] character The character to classify.
+ *
+ * @return 1 if the character is unreserved, 0 otherwise.
+ */
+    static uint8_t isUnreservedChar( char character );
+
+/**
+ * @brief Compare two strings by the order of their URI-encoded forms, without
+ * encoding them.
+ *
+ * Encoded reserved characters start with '%', which sorts before every
+ * unreserved character, and their hexadecimal digits sort in the same order as
+ * the characters themselves.
+ *
+ * @param[in] pFirst The first string.
+ * @param[in] pSecond The second string.
+ *
+ * @return Negative, zero or positive if the encoded @p pFirst sorts before,
+ * equal to or after the encoded @p pSecond.
+ */
+    static int32_t compareEncodedStrings( const SigV4ConstString_t * pFirst,
+                                          const SigV4ConstString_t * pSecond );
+
+/**
+ * @brief Pack the first #QUERY_KEY_PREFIX_LEN characters of the URI encoding
+ * of a query key into an integer that orders like the encoded key.
+ *
+ * @param[in] pKey The query key, not encoded.
+ * @param[in] keyLen Length of @p pKey.
+ *
+ * @return The big-endian, zero-padded encoded key prefix.
+ */
+    static uint64_t packEncodedKeyPrefix( const char * pKey,
+                                          size_t keyLen );
+
+/**
+ * @brief Order query pairs by encoded key, then by encoded value.
+ *
+ * @param[in] pFirst The first pair.
+ * @param[in] pSecond The second pair.
+ *
+ * @return Negative, zero or positive, as for #compareEncodedStrings.
+ */
+    static int32_t compareQueryRecords( const QueryRecord_t * pFirst,
+                                        const QueryRecord_t * pSecond );
+
+/**
+ * @brief Find the next query delimiter, eight bytes at a time.
+ *
+ * @param[in] pQuery The query string.
+ * @param[in] start Index to start the search at.
+ * @param[in] queryLen Length of @p pQuery.
+ * @param[in] matchValueSeparator 1 to stop at '=' as well as '&', 0 to stop
+ * at '&' only.
+ *
+ * @return Index of the delimiter, or @p queryLen if there is none.
+ */
+    static size_t findQueryDelimiter( const char * pQuery,
+                                      size_t start,
+                                      size_t queryLen,
+                                      uint8_t matchValueSeparator );
+
+/**
+ * @brief Split the query string into query records.
+ *
+ * @param[in, out] pCanonicalContext Context receiving the pair locations.
+ * @param[in] pQuery The query string.
+ * @param[in] queryLen Length of @p pQuery.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a pair is
+ * longer than 4 GiB, #SigV4MaxQueryPairCountExceeded if there are more than
+ * #SIGV4_MAX_QUERY_PAIR_COUNT pairs.
+ */
+    static SigV4Status_t parseQuery( CanonicalContext_t * pCanonicalContext,
+                                     const char * pQuery,
+                                     size_t queryLen );
+
+/**
+ * @brief Write the sorted, URI-encoded query pairs to the canonical request.
+ *
+ * @param[in, out] pCanonicalContext Context holding the pair locations.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+    static SigV4Status_t writeCanonicalQuery( CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Check whether a character is a space or a tab.
+ *
+ * @param[in] character The character to classify.
+ *
+ * @return 1 if the character is whitespace in a header value, 0 otherwise.
+ */
+    static uint8_t isHeaderSpace( char character );
+
+/**
+ * @brief Locate a header value without its leading and trailing whitespace.
+ *
+ * @param[in] pValue The header value.
+ * @param[in] valueLen Length of @p pValue.
+ * @param[out] pTrimmed The trimmed value, within @p pValue.
+ */
+    static void trimHeaderValue( const char * pValue,
+                                 size_t valueLen,
+                                 SigV4ConstString_t * pTrimmed );
+
+/**
+ * @brief Write a header value with leading and trailing whitespace removed,
+ * and sequential spaces replaced by a single space.
+ *
+ * @param[in, out] pBuffer The buffer to append the value to.
+ * @param[in] pValue The header value.
+ * @param[in] valueLen Length of @p pValue.
+ *
+ * @return #SigV4Success if the value fit, #SigV4InsufficientMemory otherwise.
+ */
+    static SigV4Status_t writeTrimmedHeaderValue( SigV4Buffer_t * pBuffer,
+                                                  const char * pValue,
+                                                  size_t valueLen );
+
+/**
+ * @brief Sort query records by encoded key and value with an insertion sort.
+ *
+ * @param[in, out] pRecords The records to sort.
+ * @param[in] recordCount Number of entries in @p pRecords.
+ */
+    static void sortQueryRecords( QueryRecord_t * pRecords,
+                                  size_t recordCount );
+
+/**
+ * @brief Sort header records by name with a stable insertion sort.
+ *
+ * Stability keeps repeated header names in their original order, which is the
+ * order their values must be joined in. Insertion sort moves few records for
+ * the typical number of headers, and most comparisons are decided by the name
+ * prefixes alone.
+ *
+ * @param[in, out] pRecords The records to sort.
+ * @param[in] recordCount Number of entries in @p pRecords.
+ */
+    static void sortHeaderRecords( HeaderRecord_t * pRecords,
+                                   size_t recordCount );
+
+#endif /* #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 ) */
+
+/**
+ * @brief Convert an ASCII character to lowercase.
+ *
+ * @param[in] character The character to convert.
+ *
+ * @return The lowercase character.
+ */
+static char lowercaseChar( char character );
+
+/**
+ * @brief Pack the first #HEADER_NAME_PREFIX_LEN characters of a header name,
+ * in lowercase, into an integer that orders like the name.
+ *
+ * @param[in] pName The header name.
+ * @param[in] nameLen Length of @p pName.
+ *
+ * @return The big-endian, zero-padded name prefix.
+ */
+static uint64_t packNamePrefix( const char * pName,
+                                size_t nameLen );
+
+/**
+ * @brief Compare two header names, ignoring case.
+ *
+ * @param[in] pFirst The first header.
+ * @param[in] pSecond The second header.
+ *
+ * @return Negative, zero or positive if the lowercase name of @p pFirst sorts
+ * before, equal to or after the lowercase name of @p pSecond.
+ */
+static int32_t compareHeaderNames( const HeaderRecord_t * pFirst,
+                                   const HeaderRecord_t * pSecond );
+
+/**
+ * @brief Split the HTTP headers into header records.
+ *
+ * @param[in, out] pCanonicalContext Context receiving the header locations.
+ * @param[in] pHeaders The headers.
+ * @param[in] headersLen Length of @p pHeaders.
+ * @param[in] isCanonical 1 if the lines are terminated by "\n" only, 0 if they
+ * are raw HTTP headers terminated by "\r\n".
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if a line does
+ * not contain a name or is longer than 4 GiB, #SigV4MaxHeaderPairCountExceeded
+ * if there are more than #SIGV4_MAX_HTTP_HEADER_COUNT headers.
+ */
+static SigV4Status_t parseHeaders( CanonicalContext_t * pCanonicalContext,
+                                   const char * pHeaders,
+                                   size_t headersLen,
+                                   uint8_t isCanonical );
+
+/**
+ * @brief Write a header name in lowercase.
+ *
+ * @param[in, out] pBuffer The buffer to append the name to.
+ * @param[in] pRecord The header.
+ *
+ * @return #SigV4Success if the name fit, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeLowercaseName( SigV4Buffer_t * pBuffer,
+                                         const HeaderRecord_t * pRecord );
+
+#if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+
+/**
+ * @brief Write the lowercase name of a header followed by a colon or, if the
+ * name repeats that of the previous header, the comma joining their values.
+ *
+ * @param[in, out] pCanonicalContext Context holding the sorted header locations.
+ * @param[in] index Index of the header in the sorted locations.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+    static SigV4Status_t writeHeaderNameOrSeparator( CanonicalContext_t * pCanonicalContext,
+                                                     size_t index );
+
+/**
+ * @brief Write the sorted headers in canonical form, each terminated by a
+ * linefeed, to the canonical request.
+ *
+ * @param[in, out] pCanonicalContext Context holding the sorted header locations.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+    static SigV4Status_t writeCanonicalHeaders( CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Write the trimmed value of a header to the canonical request.
+ *
+ * An x-amz-security-token header holding the security token of the
+ * credentials is hashed by #writeSecurityToken.
+ *
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ * @param[in] pRecord Location of the header.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+    static SigV4Status_t writeHeaderValue( CanonicalContext_t * pCanonicalContext,
+                                           const HeaderRecord_t * pRecord );
+
+/**
+ * @brief Check whether a header has a given name.
+ *
+ * @param[in] pRecord Location of the header.
+ * @param[in] pName The lowercase name to look for.
+ * @param[in] nameLen Length of @p pName.
+ *
+ * @return 1 if the lowercase header name is @p pName, 0 otherwise.
+ */
+    static uint8_t isHeaderNamed( const HeaderRecord_t * pRecord,
+                                  const char * pName,
+                                  size_t nameLen );
+
+#endif /* #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 ) */
+
+/**
+ * @brief Find the value of a header in canonical headers.
+ *
+ * @param[in] pHeaders The canonical headers, one "name:value" line each.
+ * @param[in] headersLen Length of @p pHeaders.
+ * @param[in] pName The lowercase header name.
+ * @param[in] nameLen Length of @p pName.
+ *
+ * @return Offset of the value in @p pHeaders, or @p headersLen if there is
+ * no such header.
+ */
+static size_t findCanonicalHeaderValue( const char * pHeaders,
+                                        size_t headersLen,
+                                        const char * pName,
+                                        size_t nameLen );
+
+/**
+ * @brief Write headers that are already in canonical form to the canonical
+ * request.
+ *
+ * They are written in parts when a retry snapshot is saved, so that the
+ * snapshot starts at the value of the x-amz-date header, and the security
+ * token of the credentials is hashed by #writeSecurityToken.
+ *
+ * @param[in] pHttpParams Parameters holding the canonical headers.
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t writeCanonicalHeaderLines( const SigV4HttpParameters_t * pHttpParams,
+                                                CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Check whether a header value is the security token of the
+ * credentials.
+ *
+ * @param[in] pCanonicalContext Context holding the security token.
+ * @param[in] pValue The trimmed header value.
+ * @param[in] valueLen Length of @p pValue.
+ *
+ * @return 1 if the value is the security token, 0 otherwise.
+ */
+static uint8_t isCredentialsToken( const CanonicalContext_t * pCanonicalContext,
+                                   const char * pValue,
+                                   size_t valueLen );
+
+/**
+ * @brief Hash the security token of the credentials as the next part of the
+ * canonical request.
+ *
+ * When the processing buffer is hashed, the token is hashed in place, after
+ * the buffered data, and is never copied to the buffer. If a retry snapshot is
+ * being copied, only the position of the token is recorded in it.
+ *
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError or
+ * #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeSecurityToken( CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Save the hash state of the canonical request in the retry snapshot
+ * of the context, if it has one, and start copying the rest of the canonical
+ * request to it.
+ *
+ * This is called when the value of the x-amz-date header is the next data
+ * written to the canonical request.
+ *
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t startRetrySnapshot( CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Keep the retry snapshot copied from the canonical request if its
+ * x-amz-date value is the date of the request, and discard it otherwise.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pSnapshot The snapshot holding the whole suffix of the
+ * canonical request.
+ */
+static void finishRetrySnapshot( const SigV4Parameters_t * pParams,
+                                 SigV4RetrySnapshot_t * pSnapshot );
+
+/**
+ * @brief Write the semicolon-separated list of signed header names.
+ *
+ * @param[in] pCanonicalContext Context holding the sorted header locations.
+ * @param[in, out] pBuffer The buffer to append the list to.
+ * @param[in] encodeSeparator 1 to URI-encode the semicolons, as in the
+ * X-Amz-SignedHeaders parameter of a presigned URL, 0 otherwise.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeSignedHeaders( const CanonicalContext_t * pCanonicalContext,
+                                         SigV4Buffer_t * pBuffer,
+                                         uint8_t encodeSeparator );
+
+/**
+ * @brief Find how the path of a request is URI-encoded in its canonical
+ * request.
+ *
+ * @param[in] pParams Parameters of the request.
+ *
+ * @return #PATH_NOT_ENCODED, #PATH_ENCODED_ONCE or #PATH_ENCODED_TWICE.
+ */
+static uint8_t getPathEncoding( const SigV4Parameters_t * pParams );
+
+/**
+ * @brief Write a path, or a part of it, to a buffer.
+ *
+ * @param[in, out] pBuffer The buffer.
+ * @param[in] pPath The path.
+ * @param[in] pathLen Length of @p pPath.
+ * @param[in] pathEncoding The value of getPathEncoding() for the request.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writePath( SigV4Buffer_t * pBuffer,
+                                const char * pPath,
+                                size_t pathLen,
+                                uint8_t pathEncoding );
+
+/**
+ * @brief Write the canonical URI to the canonical request.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeCanonicalUri( const SigV4Parameters_t * pParams,
+                                        CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Write the canonical query string to the canonical request.
+ *
+ * @param[in] pHttpParams HTTP parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeQueryString( const SigV4HttpParameters_t * pHttpParams,
+                                       CanonicalContext_t * pCanonicalContext );
+
+/**
+ * @brief Parse the headers of a request, and sort them unless they are
+ * already canonical.
+ *
+ * @param[in] pHttpParams HTTP parameters of the request.
+ * @param[in, out] pCanonicalContext Context receiving the header locations.
+ * @param[out] pIsCanonical 1 if the headers are given in canonical form, 0
+ * otherwise.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t parseRequestHeaders( const SigV4HttpParameters_t * pHttpParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          uint8_t * pIsCanonical );
+
+/**
+ * @brief Write the canonical headers and signed headers to the canonical
+ * request, and the signed headers to the Authorization value.
+ *
+ * @param[in] pHttpParams HTTP parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the canonical request.
+ * @param[in, out] pAuthBuffer The Authorization value being generated, or
+ * NULL for a presigned URL, whose signed headers are only written to the
+ * canonical request.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeHeaders( const SigV4HttpParameters_t * pHttpParams,
+                                   CanonicalContext_t * pCanonicalContext,
+                                   SigV4Buffer_t * pAuthBuffer );
+
+/**
+ * @brief Get the payload hash of a request whose payload is not hashed: the
+ * hash given as the payload, #SIGV4_UNSIGNED_PAYLOAD, or the known hash of an
+ * empty payload.
+ *
+ * @param[in] pHttpParams HTTP parameters of the request.
+ * @param[out] pPayloadHashLen The length of the returned payload hash.
+ *
+ * @return The payload hash, or NULL if the payload must be hashed.
+ */
+static const char * getFixedPayloadHash( const SigV4HttpParameters_t * pHttpParams,
+                                         size_t * pPayloadHashLen );
+
+/**
+ * @brief Compute the hex-encoded hash of the request payload.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[out] pHexPayloadHash Buffer of #HEX_ENCODED_DIGEST_LEN characters for
+ * the hash.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t hashPayload( const SigV4Parameters_t * pParams,
+                                  char * pHexPayloadHash );
+
+/**
+ * @brief Find the hash of a payload in the payload hash cache.
+ *
+ * @param[in, out] pCache The cache, whose entry is marked as used and whose
+ * statistics are updated.
+ * @param[in] pHttpParams HTTP parameters holding the payload.
+ *
+ * @return The hex-encoded hash of the payload, or NULL if it is not cached.
+ */
+static const char * lookUpPayloadHash( SigV4PayloadHashCache_t * pCache,
+                                       const SigV4HttpParameters_t * pHttpParams );
+
+/**
+ * @brief Add the hash of a payload to the payload hash cache, replacing the
+ * first entry found by the clock hand that was not used since it last
+ * passed.
+ *
+ * @param[in, out] pCache The cache.
+ * @param[in] pHttpParams HTTP parameters holding the payload.
+ * @param[in] pHexPayloadHash The hex-encoded hash of the payload.
+ */
+static void storePayloadHash( SigV4PayloadHashCache_t * pCache,
+                              const SigV4HttpParameters_t * pHttpParams,
+                              const char * pHexPayloadHash );
+
+/**
+ * @brief Compute the hex-encoded hashes of the payloads of several requests
+ * of a batch with #SigV4CryptoInterface_t.hashMultiple.
+ *
+ * @param[in] pCryptoInterface The hash functions and context.
+ * @param[in] pHttpParamsArray The HTTP parameters of the requests.
+ * @param[in] pAuthorizations The results of the requests. Only the payloads
+ * of the requests whose status is #SigV4Success, and that are not given as
+ * their hash, are hashed.
+ * @param[in] count Number of requests, at most #SIGV4_HASH_MULTIPLE_MAX_COUNT.
+ * @param[out] pHexPayloadHashes Buffer for @p count hashes of
+ * #HEX_ENCODED_DIGEST_LEN characters, one after another.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hashPayloadsTogether( const SigV4CryptoInterface_t * pCryptoInterface,
+                                           const SigV4HttpParameters_t * pHttpParamsArray,
+                                           const SigV4Authorization_t * pAuthorizations,
+                                           size_t count,
+                                           char * pHexPayloadHashes );
+
+/**
+ * @brief Generate the canonical request and hash it.
+ *
+ * The canonical request is never held in memory as a whole: it is written
+ * through the processing buffer, which is passed to the hash whenever it is
+ * full. The payload hash, which is the last line of the canonical request, is
+ * computed first, as the hash context is busy afterwards.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the processing buffer.
+ * @param[in, out] pAuthBuffer The Authorization value being generated, or
+ * NULL for a presigned URL.
+ * @param[in] pHexPayloadHash The hex-encoded payload hash, or NULL to compute
+ * it.
+ * @param[out] pDigest Buffer of #SIGV4_HASH_DIGEST_LENGTH bytes for the hash
+ * of the canonical request.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeCanonicalRequest( const SigV4Parameters_t * pParams,
+                                            CanonicalContext_t * pCanonicalContext,
+                                            SigV4Buffer_t * pAuthBuffer,
+                                            const char * pHexPayloadHash,
+                                            uint8_t * pDigest );
+
+/**
+ * @brief Write the start of the Authorization value, up to and including the
+ * "SignedHeaders=" label.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pAuthBuffer The Authorization value being generated.
+ * @param[out] pCredentialScope Location of the credential scope in
+ * @p pAuthBuffer.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeAuthorizationPrefix( const SigV4Parameters_t * pParams,
+                                               SigV4Buffer_t * pAuthBuffer,
+                                               SigV4ConstString_t * pCredentialScope );
+
+/**
+ * @brief Write the string to sign to the processing buffer.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the processing buffer.
+ * @param[in] pCanonicalRequestDigest The hash of the canonical request.
+ * @param[in] pCredentialScope The credential scope, or NULL to write it from
+ * @p pParams.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeStringToSign( const SigV4Parameters_t * pParams,
+                                        CanonicalContext_t * pCanonicalContext,
+                                        const uint8_t * pCanonicalRequestDigest,
+                                        const SigV4ConstString_t * pCredentialScope );
+
+/**
+ * @brief Sign the string to sign held in the processing buffer, and append the
+ * hex-encoded signature to the Authorization value.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Context holding the string to sign.
+ * @param[in] pSigningKey The signing key.
+ * @param[in] pSignaturePrefix The label written before the signature.
+ * @param[in] signaturePrefixLen Length of @p pSignaturePrefix.
+ * @param[in, out] pAuthBuffer The Authorization value being generated.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeSignature( const SigV4Parameters_t * pParams,
+                                     CanonicalContext_t * pCanonicalContext,
+                                     const uint8_t * pSigningKey,
+                                     const char * pSignaturePrefix,
+                                     size_t signaturePrefixLen,
+                                     SigV4Buffer_t * pAuthBuffer );
+
+/**
+ * @brief Generate the Authorization value of a request with a signing key
+ * derived beforehand.
+ *
+ * The Authorization prefix, which holds the credential scope, is only written
+ * for the first request of a batch, and copied for the others.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Working memory for the request.
+ * @param[in] pSigningKey The signing key.
+ * @param[in, out] pPrefix The Authorization prefix of a previous request, or
+ * an empty prefix, which is then set to the prefix written.
+ * @param[in] pHexPayloadHash The hex-encoded payload hash, or NULL to compute
+ * it.
+ * @param[in, out] pAuthBuffer The buffer for the Authorization value.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t generateAuthorization( const SigV4Parameters_t * pParams,
+                                            CanonicalContext_t * pCanonicalContext,
+                                            const uint8_t * pSigningKey,
+                                            AuthorizationPrefix_t * pPrefix,
+                                            const char * pHexPayloadHash,
+                                            SigV4Buffer_t * pAuthBuffer );
+
+/**
+ * @brief Generate the Authorization value of a retried request from the
+ * canonical request hash state and suffix saved in its retry snapshot.
+ *
+ * @param[in] pParams Parameters of the retry, with the snapshot.
+ * @param[in, out] pCanonicalContext Working memory for the request.
+ * @param[in] pSigningKey The signing key.
+ * @param[in, out] pAuthBuffer The buffer for the Authorization value.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t resignAuthorization( const SigV4Parameters_t * pParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          const uint8_t * pSigningKey,
+                                          SigV4Buffer_t * pAuthBuffer );
+
+/**
+ * @brief Find where the X-Amz- parameters of a presigned URL go in the
+ * canonical query of the request.
+ *
+ * @param[in] pQuery The canonical query.
+ * @param[in] queryLen Length of @p pQuery.
+ * @param[out] pSplit Index of the first parameter that sorts after the X-Amz-
+ * parameters, or @p queryLen if there is none.
+ *
+ * @return #SigV4Success if successful, #SigV4InvalidParameter if the query
+ * already has an X-Amz- parameter.
+ */
+static SigV4Status_t findPresignedQuerySplit( const char * pQuery,
+                                              size_t queryLen,
+                                              size_t * pSplit );
+
+/**
+ * @brief Write the validity of a presigned URL in decimal.
+ *
+ * @param[in, out] pBuffer The buffer to write to.
+ * @param[in] expiresSeconds The validity, at most
+ * #SIGV4_PRESIGNED_URL_EXPIRES_MAX.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writeExpires( SigV4Buffer_t * pBuffer,
+                                   uint32_t expiresSeconds );
+
+/**
+ * @brief Write the URI-encoded value of the X-Amz-Credential parameter,
+ * "<AccessKeyId>%2F<YYYYMMDD>%2F<region>%2F<service>%2Faws4_request".
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pBuffer The buffer to write to.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writePresignedCredential( const SigV4Parameters_t * pParams,
+                                               SigV4Buffer_t * pBuffer );
+
+/**
+ * @brief Write the X-Amz-Security-Token parameter of a presigned URL, if
+ * the credentials have a security token.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pBuffer The buffer to write to.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory otherwise.
+ */
+static SigV4Status_t writePresignedSecurityToken( const SigV4Parameters_t * pParams,
+                                                  SigV4Buffer_t * pBuffer );
+
+/**
+ * @brief Write the signed part of the query string of a presigned URL, which
+ * is also its canonical query: the query of the request with the X-Amz-
+ * parameters inserted in sorted order.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Context receiving the header locations.
+ * @param[in] expiresSeconds The validity of the URL.
+ * @param[in, out] pQueryBuffer The buffer for the query string.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writePresignedQuery( const SigV4Parameters_t * pParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          uint32_t expiresSeconds,
+                                          SigV4Buffer_t * pQueryBuffer );
+
+/**
+ * @brief Generate the query string of a presigned URL, up to and including
+ * its signature, with a signing key derived beforehand.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in, out] pCanonicalContext Working memory for the request.
+ * @param[in] pSigningKey The signing key.
+ * @param[in] expiresSeconds The validity of the URL.
+ * @param[in, out] pQueryBuffer The buffer for the query string.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t generatePresignedUrl( const SigV4Parameters_t * pParams,
+                                           CanonicalContext_t * pCanonicalContext,
+                                           const uint8_t * pSigningKey,
+                                           uint32_t expiresSeconds,
+                                           SigV4Buffer_t * pQueryBuffer );
+
+/**
+ * @brief Find the published URL of a window of a presign pool.
+ *
+ * @param[in] pPool The pool.
+ * @param[in] published The value of #SigV4PresignPool_t.published.
+ * @param[in] windowStart Start of the window.
+ *
+ * @return The slot number of the URL, or 0 if it is not published.
+ */
+static uint32_t findPresignedWindow( const SigV4PresignPool_t * pPool,
+                                     uint32_t published,
+                                     uint64_t windowStart );
+
+/**
+ * @brief Find a slot of a presign pool that a refresh may write: one that was
+ * not published when the refresh started, and is not excluded.
+ *
+ * Tasks that loaded #SigV4PresignPool_t.published before the refresh may
+ * still read the slots it held, even once they are no longer published, so
+ * they are only reused by a later refresh.
+ *
+ * @param[in] published The value of #SigV4PresignPool_t.published when the
+ * refresh started.
+ * @param[in] excludedSlot A slot number that must not be returned, or 0.
+ *
+ * @return The slot number, or 0 if there is none.
+ */
+static uint32_t findSparePresignSlot( uint32_t published,
+                                      uint32_t excludedSlot );
+
+/**
+ * @brief Generate the presigned URL of a window into a slot of a presign
+ * pool.
+ *
+ * @param[in, out] pPool The pool.
+ * @param[in] pParams Parameters of the URL.
+ * @param[in] slot The slot number, which must not be published.
+ * @param[in] windowStart Start of the window.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t presignWindow( SigV4PresignPool_t * pPool,
+                                    const SigV4Parameters_t * pParams,
+                                    uint32_t slot,
+                                    uint64_t windowStart );
+
+/**
+ * @brief Copy a credential string to the buffer of a credential store slot.
+ *
+ * @param[in, out] pBuffer The buffer of the slot.
+ * @param[in] pString The string, which may be NULL if @p stringLen is 0.
+ * @param[in] stringLen Length of @p pString.
+ * @param[out] pCopy The copy in the buffer, or NULL if the string is empty.
+ * @param[out] pCopyLen Length of @p pCopy.
+ *
+ * @return #SigV4Success if the string fit, #SigV4InsufficientMemory
+ * otherwise.
+ */
+static SigV4Status_t copyCredentialString( SigV4Buffer_t * pBuffer,
+                                           const char * pString,
+                                           size_t stringLen,
+                                           const char ** pCopy,
+                                           size_t * pCopyLen );
+
+/**
+ * @brief Wipe a slot of a credential store, and copy credentials to it.
+ *
+ * @param[in, out] pSlot The slot, which no task may hold.
+ * @param[in] pCredentials The credentials.
+ *
+ * @return #SigV4Success if the credentials fit, #SigV4InsufficientMemory
+ * otherwise.
+ */
+static SigV4Status_t copyCredentials( SigV4CredentialSlot_t * pSlot,
+                                      const SigV4Credentials_t * pCredentials );
+
+/**
+ * @brief Write the parts of presigned URLs that do not depend on the object
+ * key to a template, and save the canonical request hash state after the
+ * path prefix.
+ *
+ * @param[in, out] pTemplate The template.
+ * @param[in] pParams Parameters of the URLs, with the signing key cache of
+ * the template.
+ * @param[in, out] pCanonicalContext Working memory.
+ * @param[in] expiresSeconds The validity of the URLs.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t compilePresignTemplate( SigV4PresignTemplate_t * pTemplate,
+                                             const SigV4Parameters_t * pParams,
+                                             CanonicalContext_t * pCanonicalContext,
+                                             uint32_t expiresSeconds );
+
+/**
+ * @brief Write the query string of the presigned URL of an object key, up to
+ * and including its signature.
+ *
+ * @param[in] pTemplate The compiled template.
+ * @param[in] pKey The object key.
+ * @param[in] keyLen Length of @p pKey.
+ * @param[in, out] pQueryBuffer The buffer for the query string.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t signTemplateKey( const SigV4PresignTemplate_t * pTemplate,
+                                      const char * pKey,
+                                      size_t keyLen,
+                                      SigV4Buffer_t * pQueryBuffer );
+
+/**
+ * @brief Write the credential scope, "<YYYYMMDD>/<region>/<service>/aws4_request".
+ *
+ * @param[in] pParams Parameters containing the date, region and service.
+ * @param[in, out] pBuffer The buffer to write to.
+ *
+ * @return #SigV4Success if successful, error code otherwise.
+ */
+static SigV4Status_t writeCredentialScope( const SigV4Parameters_t * pParams,
+                                           SigV4Buffer_t * pBuffer );
+
+/**
+ * @brief Compute the signature of the next chunk or event of a signature
+ * chain, and make it the previous signature of the chain.
+ *
+ * The string to sign is streamed into the HMAC through a block-sized buffer.
+ *
+ * @param[in] pParams Parameters holding the date and the credential scope.
+ * @param[in] pSigningKey The signing key for the date of @p pParams.
+ * @param[in, out] pPreviousSignature The hex-encoded previous signature,
+ * replaced with the new one.
+ * @param[in] pHexHeadersHash The hex-encoded hash of the signed headers,
+ * which chunks do not have.
+ * @param[in] pHexPayloadHash The hex-encoded hash of the chunk data or of the
+ * event payload.
+ * @param[out] pSignature The signature.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t signChainLink( const SigV4Parameters_t * pParams,
+                                    const uint8_t * pSigningKey,
+                                    char * pPreviousSignature,
+                                    const char * pHexHeadersHash,
+                                    const char * pHexPayloadHash,
+                                    uint8_t * pSignature );
+
+/**
+ * @brief Write the ":date" header of an event, and the ":chunk-signature"
+ * header up to the signature.
+ *
+ * @param[in] eventTime The time of the event, in seconds since the Unix
+ * epoch.
+ * @param[out] pHeaderBuf The buffer of #SIGV4_EVENT_HEADERS_LENGTH bytes for
+ * the headers.
+ */
+static void writeEventHeaders( uint64_t eventTime,
+                               uint8_t * pHeaderBuf );
+
+/**
+ * @brief Sign a chunk from the hash of its data, and write its header.
+ *
+ * The chain is left unchanged if the header does not fit. Signing the final,
+ * empty chunk ends the chain.
+ *
+ * @param[in, out] pSigner The chunk signer.
+ * @param[in] pHexChunkHash The hex-encoded hash of the chunk data.
+ * @param[in] chunkLen The size of the chunk.
+ * @param[out] pHeaderBuf The buffer for the chunk header.
+ * @param[in, out] pHeaderBufLen The length of @p pHeaderBuf, then of the
+ * header.
+ *
+ * @return #SigV4Success if successful, #SigV4InsufficientMemory if the
+ * header does not fit, #SigV4HashError otherwise.
+ */
+static SigV4Status_t signChunkAndWriteHeader( SigV4ChunkSigner_t * pSigner,
+                                              const char * pHexChunkHash,
+                                              size_t chunkLen,
+                                              char * pHeaderBuf,
+                                              size_t * pHeaderBufLen );
+
+/**
+ * @brief Check that every chunk with data is not NULL.
+ *
+ * @param[in] pChunks The chunk data.
+ * @param[in] pChunkLens The length of each chunk.
+ * @param[in] chunkCount The number of chunks.
+ *
+ * @return #SigV4Success if the chunks are valid, #SigV4InvalidParameter
+ * otherwise.
+ */
+static SigV4Status_t checkChunks( const char * const * pChunks,
+                                  const size_t * pChunkLens,
+                                  size_t chunkCount );
+
+/**
+ * @brief Hash a group of chunks, together with
+ * #SigV4CryptoInterface_t.hashMultiple if the interface provides it.
+ *
+ * @param[in] pCryptoInterface The hash functions and context to use.
+ * @param[in] pChunks The chunk data.
+ * @param[in] pChunkLens The length of each chunk.
+ * @param[out] pHexChunkHashes The buffer for the hex-encoded hashes.
+ * @param[in] groupCount The number of chunks, at most
+ * #SIGV4_HASH_MULTIPLE_MAX_COUNT.
+ *
+ * @return #SigV4Success if successful, #SigV4HashError otherwise.
+ */
+static SigV4Status_t hashChunkGroup( const SigV4CryptoInterface_t * pCryptoInterface,
+                                     const char * const * pChunks,
+                                     const size_t * pChunkLens,
+                                     char * pHexChunkHashes,
+                                     size_t groupCount );
+
+/**
+ * @brief Get the number of hex digits of a chunk size, without leading zeros.
+ *
+ * @param[in] chunkLen The size of the chunk.
+ *
+ * @return The number of digits, at least one.
+ */
+static size_t getChunkSizeDigits( size_t chunkLen );
+
+/**
+ * @brief Write the header of a chunk: its size in hex, the chunk signature
+ * prefix, the signature and "\r\n".
+ *
+ * @param[in] chunkLen The size of the chunk.
+ * @param[in] digitCount The number of hex digits of @p chunkLen.
+ * @param[in] pSignature The hex-encoded signature of the chunk.
+ * @param[out] pHeader The buffer for the header, which must be large enough.
+ */
+static void writeChunkHeader( size_t chunkLen,
+                              size_t digitCount,
+                              const char * pSignature,
+                              char * pHeader );
+
+/**
+ * @brief Verify the credentials, date, scope and cryptography interface.
+ *
+ * @param[in] pParams Parameters of the request.
+ *
+ * @return #SigV4Success if the parameters are valid, #SigV4InvalidParameter
+ * otherwise.
+ */
+static SigV4Status_t verifySigningParams( const SigV4Parameters_t * pParams );
+
+/**
+ * @brief Verify the HTTP parameters of the request.
+ *
+ * @param[in] pHttpParams HTTP parameters of the request.
+ *
+ * @return #SigV4Success if the parameters are valid, #SigV4InvalidParameter
+ * otherwise.
+ */
+static SigV4Status_t verifyHttpParams( const SigV4HttpParameters_t * pHttpParams );
+
+/**
+ * @brief Verify the parameters of #SigV4_GenerateHTTPAuthorization.
+ *
+ * @param[in] pParams Parameters of the request.
+ * @param[in] pAuthBuf Buffer for the Authorization value.
+ * @param[in] authBufLen Length of @p pAuthBuf.
+ * @param[in] pSignature Location of the signature output.
+ * @param[in] signatureLen Length of the signature output.
+ *
+ * @return #SigV4Success if the parameters are valid, #SigV4InvalidParameter
+ * otherwise.
+ */
+static SigV4Status_t verifyParams( const SigV4Parameters_t * pParams,
+                                   const char * pAuthBuf,
+                                   const size_t * authBufLen,
+                                   char * const * pSignature,
+                                   const size_t * signatureLen );
+
+/*-----------------------------------------------------------*/
+
+static void intToAscii( int32_t value,
+                        char ** pBuffer,
+                        size_t bufferLen )
+{
+    int32_t currentVal = value;
+    size_t lenRemaining = bufferLen;
+
+    assert( pBuffer != NULL );
+    assert( bufferLen > 0U );
+
+    /* Write base-10 remainder in its ASCII representation, and fill any
+     * remaining width with '0' characters. */
+    while( lenRemaining > 0U )
+    {
+        lenRemaining--;
+        ( *pBuffer )[ lenRemaining ] = ( char ) ( ( currentVal % 10 ) + '0' );
+        currentVal /= 10;
+    }
+
+    /* Move pointer to follow last written character. */
+    *pBuffer += bufferLen;
+}
+
+/*-----------------------------------------------------------*/
+static SigV4Status_t checkLeap( const SigV4DateTime_t * pDateElements )
+{
+    SigV4Status_t returnStatus = SigV4ISOFormattingError;
+
+    assert( pDateElements != NULL );
+
+    /* If the date represents a leap day, verify that the leap year is valid. */
+    if( ( pDateElements->tm_mon == 2 ) && ( pDateElements->tm_mday == 29 ) )
+    {
+        if( ( ( pDateElements->tm_year % 400 ) != 0 ) &&
+            ( ( ( pDateElements->tm_year % 4 ) != 0 ) ||
+              ( ( pDateElements->tm_year % 100 ) == 0 ) ) )
+        {
+            LogError( ( "%ld is not a valid leap year.",
+                        ( long int ) pDateElements->tm_year ) );
+        }
+        else
+        {
+            returnStatus = SigV4Success;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t validateDateTime( const SigV4DateTime_t * pDateElements )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const int32_t daysPerMonth[] = MONTH_DAYS;
+
+    assert( pDateElements != NULL );
+
+    if( pDateElements->tm_year < YEAR_MIN )
+    {
+        LogError( ( "Invalid 'year' value parsed from date string. "
+                    "Expected an integer %ld or greater, received: %ld",
+                    ( long int ) YEAR_MIN,
+                    ( long int ) pDateElements->tm_year ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    if( ( pDateElements->tm_mon < 1 ) || ( pDateElements->tm_mon > 12 ) )
+    {
+        LogError( ( "Invalid 'month' value parsed from date string. "
+                    "Expected an integer between 1 and 12, received: %ld",
+                    ( long int ) pDateElements->tm_mon ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    /* Ensure that the day of the month is valid for the relevant month. */
+    if( ( returnStatus != SigV4ISOFormattingError ) &&
+        ( ( pDateElements->tm_mday < 1 ) ||
+          ( pDateElements->tm_mday > daysPerMonth[ pDateElements->tm_mon - 1 ] ) ) )
+    {
+        /* Check if the date is a valid leap year day. */
+        returnStatus = checkLeap( pDateElements );
+
+        if( returnStatus == SigV4ISOFormattingError )
+        {
+            LogError( ( "Invalid 'day' value parsed from date string. "
+                        "Expected an integer between 1 and %ld, received: %ld",
+                        ( long int ) daysPerMonth[ pDateElements->tm_mon - 1 ],
+                        ( long int ) pDateElements->tm_mday ) );
+        }
+    }
+
+    /* SigV4DateTime_t values are asserted to be non-negative before they are
+     * assigned in function addToDate(). Therefore, we only verify logical upper
+     * bounds for the following values. */
+    if( pDateElements->tm_hour > 23 )
+    {
+        LogError( ( "Invalid 'hour' value parsed from date string. "
+                    "Expected an integer between 0 and 23, received: %ld",
+                    ( long int ) pDateElements->tm_hour ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    if( pDateElements->tm_min > 59 )
+    {
+        LogError( ( "Invalid 'minute' value parsed from date string. "
+                    "Expected an integer between 0 and 59, received: %ld",
+                    ( long int ) pDateElements->tm_min ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    /* An upper limit of 60 accounts for the occasional leap second UTC
+     * adjustment. */
+    if( pDateElements->tm_sec > 60 )
+    {
+        LogError( ( "Invalid 'second' value parsed from date string. "
+                    "Expected an integer between 0 and 60, received: %ld",
+                    ( long int ) pDateElements->tm_sec ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void addToDate( const char formatChar,
+                       int32_t result,
+                       SigV4DateTime_t * pDateElements )
+{
+    assert( pDateElements != NULL );
+    assert( result >= 0 );
+
+    switch( formatChar )
+    {
+        case 'Y':
+            pDateElements->tm_year = result;
+            break;
+
+        case 'M':
+            pDateElements->tm_mon = result;
+            break;
+
+        case 'D':
+            pDateElements->tm_mday = result;
+            break;
+
+        case 'h':
+            pDateElements->tm_hour = result;
+            break;
+
+        case 'm':
+            pDateElements->tm_min = result;
+            break;
 
         case 's':
             pDateElements->tm_sec = result;
             break;
 
-        default:
+        default:
+
+            /* Do not assign values for skipped characters ('*'), or
+             * unrecognized format specifiers. */
+            break;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t scanValue( const char * pDate,
+                                const char formatChar,
+                                size_t readLoc,
+                                size_t lenToRead,
+                                SigV4DateTime_t * pDateElements )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    const char * pMonthNames[] = MONTH_NAMES;
+    const char * pLoc = pDate + readLoc;
+    size_t remainingLenToRead = lenToRead;
+    int32_t result = 0;
+
+    assert( pDate != NULL );
+    assert( pDateElements != NULL );
+
+    if( formatChar == '*' )
+    {
+        remainingLenToRead = 0U;
+    }
+
+    /* Determine if month value is non-numeric. */
+    if( ( formatChar == 'M' ) && ( remainingLenToRead == MONTH_ASCII_LEN ) )
+    {
+        while( result++ < 12 )
+        {
+            /* Search month array for parsed string. */
+            if( strncmp( pMonthNames[ result - 1 ], pLoc, MONTH_ASCII_LEN ) == 0 )
+            {
+                returnStatus = SigV4Success;
+                break;
+            }
+        }
+
+        if( returnStatus != SigV4Success )
+        {
+            LogError( ( "Unable to match string '%.3s' to a month value.",
+                        pLoc ) );
+            returnStatus = SigV4ISOFormattingError;
+        }
+
+        remainingLenToRead = 0U;
+    }
+
+    /* Interpret integer value of numeric representation. */
+    while( ( remainingLenToRead > 0U ) && ( *pLoc >= '0' ) && ( *pLoc <= '9' ) )
+    {
+        result = ( result * 10 ) + ( int32_t ) ( *pLoc - '0' );
+        remainingLenToRead--;
+        pLoc += 1;
+    }
+
+    if( remainingLenToRead != 0U )
+    {
+        LogError( ( "Parsing Error: Expected numerical string of type '%%%d%c', "
+                    "but received '%.*s'.",
+                    ( int ) lenToRead,
+                    formatChar,
+                    ( int ) lenToRead,
+                    pLoc ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    if( returnStatus != SigV4ISOFormattingError )
+    {
+        addToDate( formatChar,
+                   result,
+                   pDateElements );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t parseDate( const char * pDate,
+                                size_t dateLen,
+                                const char * pFormat,
+                                size_t formatLen,
+                                SigV4DateTime_t * pDateElements )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    size_t readLoc = 0U, lenToRead = 0U, formatIndex = 0U;
+
+    assert( pDate != NULL );
+    assert( pFormat != NULL );
+    assert( pDateElements != NULL );
+    ( void ) dateLen;
+
+    /* Loop through the format string. */
+    while( ( formatIndex < formatLen ) && ( returnStatus != SigV4ISOFormattingError ) )
+    {
+        if( pFormat[ formatIndex ] == '%' )
+        {
+            /* '%' must be followed by a length and type specification. */
+            assert( formatIndex < formatLen - 2 );
+            formatIndex++;
+
+            /* Numerical value of length specifier character. */
+            lenToRead = ( ( uint32_t ) pFormat[ formatIndex ] - ( uint32_t ) '0' );
+            formatIndex++;
+
+            /* Ensure read is within buffer bounds. */
+            assert( readLoc + lenToRead - 1 < dateLen );
+            returnStatus = scanValue( pDate,
+                                      pFormat[ formatIndex ],
+                                      readLoc,
+                                      lenToRead,
+                                      pDateElements );
+
+            readLoc += lenToRead;
+        }
+        else if( pDate[ readLoc ] != pFormat[ formatIndex ] )
+        {
+            LogError( ( "Parsing error: Expected character '%c', "
+                        "but received '%c'.",
+                        pFormat[ formatIndex ], pDate[ readLoc ] ) );
+            returnStatus = SigV4ISOFormattingError;
+        }
+        else
+        {
+            readLoc++;
+            LogDebug( ( "Successfully matched character '%c' found in format string.",
+                        pDate[ readLoc - 1 ] ) );
+        }
+
+        formatIndex++;
+    }
+
+    if( ( returnStatus != SigV4ISOFormattingError ) )
+    {
+        returnStatus = SigV4Success;
+    }
+    else
+    {
+        LogError( ( "Parsing Error: Date did not match expected string format." ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void epochToDateTime( uint64_t epochSeconds,
+                             SigV4DateTime_t * pDateElements )
+{
+    uint32_t daySeconds = 0U, days = 0U, era = 0U, dayOfEra = 0U;
+    uint32_t yearOfEra = 0U, dayOfYear = 0U, shiftedMonth = 0U, year = 0U;
+
+    assert( ( epochSeconds <= EVENT_TIME_MAX ) && ( pDateElements != NULL ) );
+
+    days = ( uint32_t ) ( epochSeconds / SECONDS_PER_DAY );
+    daySeconds = ( uint32_t ) ( epochSeconds % SECONDS_PER_DAY );
+
+    /* Count the days from 0000-03-01, so that the leap day ends each year,
+     * and split them into 400 year eras of 146097 days. */
+    days += 719468U;
+    era = days / 146097U;
+    dayOfEra = days - ( era * 146097U );
+    yearOfEra = ( dayOfEra - ( dayOfEra / 1460U ) + ( dayOfEra / 36524U ) - ( dayOfEra / 146096U ) ) / 365U;
+    dayOfYear = dayOfEra - ( ( 365U * yearOfEra ) + ( yearOfEra / 4U ) - ( yearOfEra / 100U ) );
+
+    /* Months from March, whose lengths repeat every five months of 153 days. */
+    shiftedMonth = ( ( 5U * dayOfYear ) + 2U ) / 153U;
+    year = yearOfEra + ( era * 400U );
+
+    pDateElements->tm_mday = ( int32_t ) ( dayOfYear - ( ( ( 153U * shiftedMonth ) + 2U ) / 5U ) + 1U );
+    pDateElements->tm_mon = ( int32_t ) ( ( shiftedMonth < 10U ) ? ( shiftedMonth + 3U ) : ( shiftedMonth - 9U ) );
+    pDateElements->tm_year = ( int32_t ) ( ( pDateElements->tm_mon <= 2 ) ? ( year + 1U ) : year );
+    pDateElements->tm_hour = ( int32_t ) ( daySeconds / 3600U );
+    pDateElements->tm_min = ( int32_t ) ( ( daySeconds % 3600U ) / 60U );
+    pDateElements->tm_sec = ( int32_t ) ( daySeconds % 60U );
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t dateTimeToEpoch( const SigV4DateTime_t * pDateElements )
+{
+    uint32_t year = 0U, era = 0U, yearOfEra = 0U, shiftedMonth = 0U;
+    uint32_t dayOfYear = 0U, dayOfEra = 0U, days = 0U, daySeconds = 0U;
+
+    assert( ( pDateElements != NULL ) && ( pDateElements->tm_year >= UNIX_EPOCH_YEAR ) );
+
+    /* Count from 0000-03-01 as epochToDateTime() does, so January and
+     * February belong to the previous year. */
+    year = ( uint32_t ) pDateElements->tm_year;
+    year = ( pDateElements->tm_mon <= 2 ) ? ( year - 1U ) : year;
+    shiftedMonth = ( uint32_t ) pDateElements->tm_mon;
+    shiftedMonth = ( shiftedMonth > 2U ) ? ( shiftedMonth - 3U ) : ( shiftedMonth + 9U );
+
+    era = year / 400U;
+    yearOfEra = year - ( era * 400U );
+    dayOfYear = ( ( ( 153U * shiftedMonth ) + 2U ) / 5U ) + ( uint32_t ) pDateElements->tm_mday - 1U;
+    dayOfEra = ( 365U * yearOfEra ) + ( yearOfEra / 4U ) - ( yearOfEra / 100U ) + dayOfYear;
+    days = ( era * 146097U ) + dayOfEra - 719468U;
+
+    daySeconds = ( ( uint32_t ) pDateElements->tm_hour * 3600U ) +
+                 ( ( uint32_t ) pDateElements->tm_min * 60U ) +
+                 ( uint32_t ) pDateElements->tm_sec;
+
+    return ( ( uint64_t ) days * SECONDS_PER_DAY ) + daySeconds;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t parseExpirationTime( const char * pExpiration,
+                                          size_t expirationLen,
+                                          uint64_t * pExpirationTime )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4DateTime_t date = { 0 };
+    const char * pFormatStr = NULL;
+    size_t formatLen = 0U;
+
+    assert( pExpirationTime != NULL );
+
+    *pExpirationTime = 0U;
+
+    if( ( pExpiration == NULL ) || ( expirationLen == 0U ) )
+    {
+        /* Credentials without an expiration do not expire. */
+    }
+    else if( ( expirationLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ||
+             ( expirationLen == SIGV4_EXPECTED_LEN_RFC_5322 ) )
+    {
+        pFormatStr = ( expirationLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
+                     ( FORMAT_RFC_3339 ) : ( FORMAT_RFC_5322 );
+
+        formatLen = ( expirationLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
+                    ( FORMAT_RFC_3339_LEN ) : ( FORMAT_RFC_5322_LEN );
+
+        returnStatus = parseDate( pExpiration, expirationLen, pFormatStr, formatLen, &date );
+    }
+    else
+    {
+        LogError( ( "Parsing Error: The expiration must be %u or %u characters long, "
+                    "for RFC 3339 and RFC 5322 formats, respectively.",
+                    SIGV4_EXPECTED_LEN_RFC_3339,
+                    SIGV4_EXPECTED_LEN_RFC_5322 ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( pFormatStr != NULL ) )
+    {
+        returnStatus = validateDateTime( &date );
+    }
+
+    if( ( returnStatus != SigV4Success ) || ( pFormatStr == NULL ) )
+    {
+        /* The expiration could not be parsed, or there is none. */
+    }
+    else if( date.tm_year >= UNIX_EPOCH_YEAR )
+    {
+        *pExpirationTime = dateTimeToEpoch( &date );
+    }
+    else
+    {
+        /* Dates before the Unix epoch are not representable. */
+    }
+
+    /* 0 stands for no expiration, so the epoch itself is not accepted
+     * either. */
+    if( ( returnStatus == SigV4Success ) && ( pFormatStr != NULL ) && ( *pExpirationTime == 0U ) )
+    {
+        LogError( ( "Parsing Error: The expiration must be after the Unix epoch." ) );
+        returnStatus = SigV4ISOFormattingError;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void writeIso8601( const SigV4DateTime_t * pDateElements,
+                          char * pDateISO8601 )
+{
+    char * pWriteLoc = pDateISO8601;
+
+    assert( ( pDateElements != NULL ) && ( pDateISO8601 != NULL ) );
+
+    intToAscii( pDateElements->tm_year, &pWriteLoc, ISO_YEAR_LEN );
+    intToAscii( pDateElements->tm_mon, &pWriteLoc, ISO_NON_YEAR_LEN );
+    intToAscii( pDateElements->tm_mday, &pWriteLoc, ISO_NON_YEAR_LEN );
+    *pWriteLoc = 'T';
+    pWriteLoc++;
+    intToAscii( pDateElements->tm_hour, &pWriteLoc, ISO_NON_YEAR_LEN );
+    intToAscii( pDateElements->tm_min, &pWriteLoc, ISO_NON_YEAR_LEN );
+    intToAscii( pDateElements->tm_sec, &pWriteLoc, ISO_NON_YEAR_LEN );
+    *pWriteLoc = 'Z';
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_AwsIotDateToIso8601( const char * pDate,
+                                         size_t dateLen,
+                                         char * pDateISO8601,
+                                         size_t dateISO8601Len )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4DateTime_t date = { 0 };
+    const char * pFormatStr = NULL;
+    size_t formatLen = 0U;
+
+    /* Check for NULL parameters. */
+    if( pDate == NULL )
+    {
+        LogError( ( "Parameter check failed: pDate is NULL." ) );
+    }
+    else if( pDateISO8601 == NULL )
+    {
+        LogError( ( "Parameter check failed: pDateISO8601 is NULL." ) );
+    }
+    /* Check that the date provided is of the expected length. */
+    else if( ( dateLen != SIGV4_EXPECTED_LEN_RFC_3339 ) &&
+             ( dateLen != SIGV4_EXPECTED_LEN_RFC_5322 ) )
+    {
+        LogError( ( "Parameter check failed: dateLen must be either %u or %u, "
+                    "for RFC 3339 and RFC 5322 formats, respectively.",
+                    SIGV4_EXPECTED_LEN_RFC_3339,
+                    SIGV4_EXPECTED_LEN_RFC_5322 ) );
+    }
+
+    /* Check that the output buffer provided is large enough for the formatted
+     * string. */
+    else if( dateISO8601Len < SIGV4_ISO_STRING_LEN )
+    {
+        LogError( ( "Parameter check failed: dateISO8601Len must be at least %u.",
+                    SIGV4_ISO_STRING_LEN ) );
+    }
+    else
+    {
+        /* Assign format string according to input type received. */
+        pFormatStr = ( dateLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
+                     ( FORMAT_RFC_3339 ) : ( FORMAT_RFC_5322 );
+
+        formatLen = ( dateLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
+                    ( FORMAT_RFC_3339_LEN ) : ( FORMAT_RFC_5322_LEN );
+
+        returnStatus = parseDate( pDate, dateLen, pFormatStr, formatLen, &date );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = validateDateTime( &date );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        /* Combine date elements into complete ASCII representation, and fill
+         * buffer with result. */
+        writeIso8601( &date, pDateISO8601 );
+
+        LogDebug( ( "Successfully formatted ISO 8601 date: \"%.*s\"",
+                    ( int ) dateISO8601Len,
+                    pDateISO8601 ) );
+    }
+
+    return returnStatus;
+}
+/*-----------------------------------------------------------*/
+
+static void lowercaseHexEncode( const uint8_t * pInput,
+                                size_t inputLen,
+                                char * pHexOutput )
+{
+    static const char digitArr[] = "0123456789abcdef";
+    size_t i = 0U;
+
+    assert( ( pInput != NULL ) && ( pHexOutput != NULL ) );
+
+    for( i = 0U; i < inputLen; i++ )
+    {
+        pHexOutput[ 2U * i ] = digitArr[ ( pInput[ i ] & 0xF0U ) >> 4 ];
+        pHexOutput[ ( 2U * i ) + 1U ] = digitArr[ pInput[ i ] & 0x0FU ];
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t flushBuffer( SigV4Buffer_t * pBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pBuffer != NULL ) && ( pBuffer->pCryptoInterface != NULL ) );
+
+    returnStatus = hashStreamedData( pBuffer, pBuffer->pData, pBuffer->dataLen );
+    pBuffer->dataLen = 0U;
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hashStreamedData( SigV4Buffer_t * pBuffer,
+                                       const char * pData,
+                                       size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4RetrySnapshot_t * pSnapshot = NULL;
+
+    assert( ( pBuffer != NULL ) && ( pBuffer->pCryptoInterface != NULL ) );
+    assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+    pSnapshot = pBuffer->pRetrySnapshot;
+
+    if( pBuffer->pCryptoInterface->hashUpdate( pBuffer->pCryptoInterface->pHashContext,
+                                               ( const uint8_t * ) pData,
+                                               dataLen ) != 0 )
+    {
+        LogError( ( "Failed to update the hash context with %lu bytes.",
+                    ( unsigned long ) dataLen ) );
+        returnStatus = SigV4HashError;
+    }
+    else if( pSnapshot == NULL )
+    {
+        /* No retry snapshot is being saved. */
+    }
+    else if( dataLen > ( sizeof( pSnapshot->pSuffix ) - pSnapshot->suffixLen ) )
+    {
+        LogDebug( ( "Retry snapshot not saved: The canonical request suffix does not fit in "
+                    "SIGV4_RETRY_SNAPSHOT_SUFFIX_LENGTH bytes." ) );
+        pSnapshot->suffixLen = 0U;
+        pBuffer->pRetrySnapshot = NULL;
+    }
+    else
+    {
+        ( void ) memcpy( &pSnapshot->pSuffix[ pSnapshot->suffixLen ], pData, dataLen );
+        pSnapshot->suffixLen += dataLen;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeToBuffer( SigV4Buffer_t * pBuffer,
+                                    const char * pData,
+                                    size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t copyLen = dataLen;
+
+    assert( ( pBuffer != NULL ) && ( pBuffer->dataLen <= pBuffer->bufferLen ) );
+    assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+    if( ( dataLen > ( pBuffer->bufferLen - pBuffer->dataLen ) ) && ( pBuffer->pCryptoInterface != NULL ) )
+    {
+        returnStatus = flushBuffer( pBuffer );
+
+        /* Data that would fill the buffer on its own gains nothing from being
+         * copied first. */
+        if( ( returnStatus == SigV4Success ) && ( dataLen >= pBuffer->bufferLen ) )
+        {
+            copyLen = 0U;
+            returnStatus = hashStreamedData( pBuffer, pData, dataLen );
+        }
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The stream could not be flushed. */
+    }
+    else if( copyLen > ( pBuffer->bufferLen - pBuffer->dataLen ) )
+    {
+        LogError( ( "Insufficient memory: %lu more bytes are needed.",
+                    ( unsigned long ) ( dataLen - ( pBuffer->bufferLen - pBuffer->dataLen ) ) ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else if( copyLen > 0U )
+    {
+        ( void ) memcpy( &pBuffer->pData[ pBuffer->dataLen ], pData, copyLen );
+        pBuffer->dataLen += copyLen;
+    }
+    else
+    {
+        /* Empty input: there is nothing to write. */
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeCharToBuffer( SigV4Buffer_t * pBuffer,
+                                        char character )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pBuffer != NULL ) && ( pBuffer->dataLen <= pBuffer->bufferLen ) );
+
+    if( ( pBuffer->dataLen == pBuffer->bufferLen ) && ( pBuffer->pCryptoInterface != NULL ) )
+    {
+        returnStatus = flushBuffer( pBuffer );
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The stream could not be flushed. */
+    }
+    else if( pBuffer->dataLen == pBuffer->bufferLen )
+    {
+        LogError( ( "Insufficient memory: buffer of %lu bytes is full.",
+                    ( unsigned long ) pBuffer->bufferLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        pBuffer->pData[ pBuffer->dataLen ] = character;
+        pBuffer->dataLen++;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t completeHash( const SigV4CryptoInterface_t * pCryptoInterface,
+                                   const uint8_t * pInput,
+                                   size_t inputLen,
+                                   uint8_t * pDigest )
+{
+    SigV4Status_t returnStatus = SigV4HashError;
+
+    assert( pCryptoInterface != NULL );
+    assert( pDigest != NULL );
+
+    if( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 )
+    {
+        LogError( ( "Failed to initialize the hash context." ) );
+    }
+    else if( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                           pInput,
+                                           inputLen ) != 0 )
+    {
+        LogError( ( "Failed to update the hash context." ) );
+    }
+    else if( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                          pDigest,
+                                          SIGV4_HASH_DIGEST_LENGTH ) != 0 )
+    {
+        LogError( ( "Failed to finalize the hash context." ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t getHashBlockLen( const SigV4CryptoInterface_t * pCryptoInterface )
+{
+    size_t blockLen = HMAC_DEFAULT_BLOCK_LENGTH;
+
+    assert( pCryptoInterface != NULL );
+
+    if( pCryptoInterface->hashBlockLen != 0U )
+    {
+        blockLen = pCryptoInterface->hashBlockLen;
+    }
+
+    return blockLen;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacInit( HmacContext_t * pHmac,
+                               const uint8_t * pKeyPrefix,
+                               size_t prefixLen,
+                               const uint8_t * pKey,
+                               size_t keyLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    size_t i = 0U, blockLen = 0U;
+
+    assert( ( pHmac != NULL ) && ( pHmac->pCryptoInterface != NULL ) );
+    assert( ( pKeyPrefix != NULL ) || ( prefixLen == 0U ) );
+    assert( pKey != NULL );
+
+    pCryptoInterface = pHmac->pCryptoInterface;
+    blockLen = getHashBlockLen( pCryptoInterface );
+    ( void ) memset( pHmac->key, 0, sizeof( pHmac->key ) );
+
+    if( ( prefixLen + keyLen ) <= blockLen )
+    {
+        if( prefixLen > 0U )
+        {
+            ( void ) memcpy( pHmac->key, pKeyPrefix, prefixLen );
+        }
+
+        ( void ) memcpy( &pHmac->key[ prefixLen ], pKey, keyLen );
+    }
+    /* Keys longer than the block length are replaced by their digest. */
+    else if( ( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 ) ||
+             ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext, pKeyPrefix, prefixLen ) != 0 ) ||
+             ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext, pKey, keyLen ) != 0 ) ||
+             ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext, pHmac->key, SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to hash the HMAC key." ) );
+        returnStatus = SigV4HashError;
+    }
+    else
+    {
+        /* The digest is now the key. */
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        for( i = 0U; i < blockLen; i++ )
+        {
+            pHmac->key[ i ] ^= ( uint8_t ) HMAC_INNER_PAD_BYTE;
+        }
+
+        if( ( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 ) ||
+            ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                            pHmac->key,
+                                            blockLen ) != 0 ) )
+        {
+            LogError( ( "Failed to start the HMAC inner hash." ) );
+            returnStatus = SigV4HashError;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacUpdate( const HmacContext_t * pHmac,
+                                 const char * pData,
+                                 size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pHmac != NULL ) && ( pHmac->pCryptoInterface != NULL ) );
+
+    if( pHmac->pCryptoInterface->hashUpdate( pHmac->pCryptoInterface->pHashContext,
+                                             ( const uint8_t * ) pData,
+                                             dataLen ) != 0 )
+    {
+        LogError( ( "Failed to update the HMAC inner hash." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacFinal( HmacContext_t * pHmac,
+                                uint8_t * pMac )
+{
+    SigV4Status_t returnStatus = SigV4HashError;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    size_t i = 0U, blockLen = 0U;
+
+    assert( ( pHmac != NULL ) && ( pHmac->pCryptoInterface != NULL ) );
+    assert( pMac != NULL );
+
+    pCryptoInterface = pHmac->pCryptoInterface;
+    blockLen = getHashBlockLen( pCryptoInterface );
+
+    /* Turn the inner padded key into the outer padded key. */
+    for( i = 0U; i < blockLen; i++ )
+    {
+        pHmac->key[ i ] ^= ( uint8_t ) ( HMAC_INNER_PAD_BYTE ^ HMAC_OUTER_PAD_BYTE );
+    }
+
+    /* The inner digest is held in the output buffer until the outer hash
+     * overwrites it. */
+    if( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                     pMac,
+                                     SIGV4_HASH_DIGEST_LENGTH ) != 0 )
+    {
+        LogError( ( "Failed to finalize the HMAC inner hash." ) );
+    }
+    else if( ( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 ) ||
+             ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                             pHmac->key,
+                                             blockLen ) != 0 ) ||
+             ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                             pMac,
+                                             SIGV4_HASH_DIGEST_LENGTH ) != 0 ) ||
+             ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                            pMac,
+                                            SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to compute the HMAC outer hash." ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t chainHmac( HmacContext_t * pHmac,
+                                uint8_t * pKeyAndMac,
+                                const char * pData,
+                                size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    returnStatus = hmacInit( pHmac, NULL, 0U, pKeyAndMac, SIGV4_HASH_DIGEST_LENGTH );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = hmacUpdate( pHmac, pData, dataLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = hmacFinal( pHmac, pKeyAndMac );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t deriveSigningKey( const SigV4Parameters_t * pParams,
+                                       HmacContext_t * pHmac,
+                                       uint8_t * pSigningKey )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( pParams != NULL );
+    assert( pSigningKey != NULL );
+
+    returnStatus = deriveDateKey( pParams, pHmac, pSigningKey );
+
+    /* kRegion = HMAC( kDate, Region ) */
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = chainHmac( pHmac, pSigningKey, pParams->pRegion, pParams->regionLen );
+    }
+
+    /* kService = HMAC( kRegion, Service ) */
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = chainHmac( pHmac, pSigningKey, pParams->pService, pParams->serviceLen );
+    }
+
+    /* kSigning = HMAC( kService, "aws4_request" ) */
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = chainHmac( pHmac,
+                                  pSigningKey,
+                                  CREDENTIAL_SCOPE_TERMINATOR,
+                                  CREDENTIAL_SCOPE_TERMINATOR_LEN );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t deriveDateKey( const SigV4Parameters_t * pParams,
+                                    HmacContext_t * pHmac,
+                                    uint8_t * pDateKey )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pParams != NULL ) && ( pDateKey != NULL ) );
+
+    /* kDate = HMAC( "AWS4" + kSecret, Date ) */
+    returnStatus = hmacInit( pHmac,
+                             ( const uint8_t * ) SIGNING_KEY_PREFIX,
+                             SIGNING_KEY_PREFIX_LEN,
+                             ( const uint8_t * ) pParams->pCredentials->pSecretAccessKey,
+                             pParams->pCredentials->secretAccessKeyLen );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = hmacUpdate( pHmac, pParams->pDateIso8601, ISO_DATE_SCOPE_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = hmacFinal( pHmac, pDateKey );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacMultiple( const SigV4CryptoInterface_t * pCryptoInterface,
+                                   HmacLanes_t * pLanes,
+                                   uint8_t * pKeysAndMacs,
+                                   const char * const * pData,
+                                   const size_t * pDataLens,
+                                   size_t count )
+{
+    SigV4Status_t returnStatus = SigV4HashError;
+    size_t i = 0U, j = 0U, blockLen = 0U;
+    uint8_t * pLane = NULL;
+
+    assert( ( pCryptoInterface != NULL ) && ( pCryptoInterface->hashMultiple != NULL ) );
+    assert( ( pLanes != NULL ) && ( pKeysAndMacs != NULL ) );
+    assert( ( pData != NULL ) && ( pDataLens != NULL ) );
+    assert( count <= SIGV4_HASH_MULTIPLE_MAX_COUNT );
+
+    blockLen = getHashBlockLen( pCryptoInterface );
+
+    /* Each inner message is the inner padded key block followed by the data.
+     * The keys are digests, so they are never longer than a block. */
+    for( i = 0U; i < count; i++ )
+    {
+        assert( pDataLens[ i ] <= HMAC_LANE_MAX_DATA_LENGTH );
+
+        pLane = pLanes->pBuffers[ i ];
+        ( void ) memset( pLane, 0, blockLen );
+        ( void ) memcpy( pLane, &pKeysAndMacs[ i * SIGV4_HASH_DIGEST_LENGTH ], SIGV4_HASH_DIGEST_LENGTH );
+
+        for( j = 0U; j < blockLen; j++ )
+        {
+            pLane[ j ] ^= ( uint8_t ) HMAC_INNER_PAD_BYTE;
+        }
+
+        ( void ) memcpy( &pLane[ blockLen ], pData[ i ], pDataLens[ i ] );
+        pLanes->pInputs[ i ] = pLane;
+        pLanes->pInputLens[ i ] = blockLen + pDataLens[ i ];
+    }
+
+    if( pCryptoInterface->hashMultiple( pCryptoInterface->pHashContext,
+                                        pLanes->pInputs,
+                                        pLanes->pInputLens,
+                                        pLanes->pInnerDigests,
+                                        count ) != 0 )
+    {
+        LogError( ( "Failed to compute the HMAC inner hashes." ) );
+    }
+    else
+    {
+        /* Each outer message is the outer padded key block followed by the
+         * inner digest. */
+        for( i = 0U; i < count; i++ )
+        {
+            pLane = pLanes->pBuffers[ i ];
+
+            for( j = 0U; j < blockLen; j++ )
+            {
+                pLane[ j ] ^= ( uint8_t ) ( HMAC_INNER_PAD_BYTE ^ HMAC_OUTER_PAD_BYTE );
+            }
+
+            ( void ) memcpy( &pLane[ blockLen ],
+                             &pLanes->pInnerDigests[ i * SIGV4_HASH_DIGEST_LENGTH ],
+                             SIGV4_HASH_DIGEST_LENGTH );
+            pLanes->pInputLens[ i ] = blockLen + SIGV4_HASH_DIGEST_LENGTH;
+        }
+
+        if( pCryptoInterface->hashMultiple( pCryptoInterface->pHashContext,
+                                            pLanes->pInputs,
+                                            pLanes->pInputLens,
+                                            pKeysAndMacs,
+                                            count ) != 0 )
+        {
+            LogError( ( "Failed to compute the HMAC outer hashes." ) );
+        }
+        else
+        {
+            returnStatus = SigV4Success;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t deriveRegionKeysTogether( const SigV4Parameters_t * pParams,
+                                               HmacLanes_t * pLanes,
+                                               const uint8_t * pDateKey,
+                                               const char * const * pRegions,
+                                               const size_t * pRegionLens,
+                                               uint8_t * pSigningKeys,
+                                               size_t count )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const char * pData[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];
+    size_t pDataLens[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];
+    size_t i = 0U;
+
+    assert( ( pParams != NULL ) && ( pDateKey != NULL ) && ( pSigningKeys != NULL ) );
+    assert( count <= SIGV4_HASH_MULTIPLE_MAX_COUNT );
+
+    for( i = 0U; i < count; i++ )
+    {
+        ( void ) memcpy( &pSigningKeys[ i * SIGV4_HASH_DIGEST_LENGTH ], pDateKey, SIGV4_HASH_DIGEST_LENGTH );
+    }
+
+    /* kRegion = HMAC( kDate, Region ) */
+    returnStatus = hmacMultiple( pParams->pCryptoInterface, pLanes, pSigningKeys, pRegions, pRegionLens, count );
+
+    /* kService = HMAC( kRegion, Service ) */
+    if( returnStatus == SigV4Success )
+    {
+        for( i = 0U; i < count; i++ )
+        {
+            pData[ i ] = pParams->pService;
+            pDataLens[ i ] = pParams->serviceLen;
+        }
+
+        returnStatus = hmacMultiple( pParams->pCryptoInterface, pLanes, pSigningKeys, pData, pDataLens, count );
+    }
+
+    /* kSigning = HMAC( kService, "aws4_request" ) */
+    if( returnStatus == SigV4Success )
+    {
+        for( i = 0U; i < count; i++ )
+        {
+            pData[ i ] = CREDENTIAL_SCOPE_TERMINATOR;
+            pDataLens[ i ] = CREDENTIAL_SCOPE_TERMINATOR_LEN;
+        }
+
+        returnStatus = hmacMultiple( pParams->pCryptoInterface, pLanes, pSigningKeys, pData, pDataLens, count );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeSigningKeyTag( const SigV4Parameters_t * pParams,
+                                         SigV4Buffer_t * pBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pParams != NULL ) && ( pBuffer != NULL ) );
+
+    returnStatus = writeToBuffer( pBuffer, pParams->pDateIso8601, ISO_DATE_SCOPE_LEN );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, pParams->pRegion, pParams->regionLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, pParams->pService, pParams->serviceLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer,
+                                      pParams->pCredentials->pSecretAccessKey,
+                                      pParams->pCredentials->secretAccessKeyLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t isSigningKeyCached( const SigV4SigningKeyCache_t * pCache,
+                                   const SigV4Parameters_t * pParams )
+{
+    uint8_t isCached = 0U;
+    size_t regionStart = ISO_DATE_SCOPE_LEN + 1U, serviceStart = 0U, secretStart = 0U;
+
+    assert( ( pCache != NULL ) && ( pParams != NULL ) );
+
+    /* Compare each part of the tag in place, rather than writing the tag of
+     * the parameters first. The region and service may hold the separator,
+     * so their lengths are compared too, or "a/b" and "c" would match "a"
+     * and "b/c". */
+    serviceStart = regionStart + pParams->regionLen + 1U;
+    secretStart = serviceStart + pParams->serviceLen + 1U;
+
+    if( ( pCache->tagLen == ( secretStart + pParams->pCredentials->secretAccessKeyLen ) ) &&
+        ( pCache->regionLen == pParams->regionLen ) &&
+        ( pCache->serviceLen == pParams->serviceLen ) &&
+        ( memcmp( pCache->pTag, pParams->pDateIso8601, ISO_DATE_SCOPE_LEN ) == 0 ) &&
+        ( memcmp( &pCache->pTag[ regionStart ], pParams->pRegion, pParams->regionLen ) == 0 ) &&
+        ( memcmp( &pCache->pTag[ serviceStart ], pParams->pService, pParams->serviceLen ) == 0 ) &&
+        ( memcmp( &pCache->pTag[ secretStart ],
+                  pParams->pCredentials->pSecretAccessKey,
+                  pParams->pCredentials->secretAccessKeyLen ) == 0 ) )
+    {
+        isCached = 1U;
+    }
+
+    return isCached;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t getSigningKey( const SigV4Parameters_t * pParams,
+                                    HmacContext_t * pHmac,
+                                    uint8_t * pSigningKey )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4SigningKeyCache_t * pCache = NULL;
+
+    assert( ( pParams != NULL ) && ( pSigningKey != NULL ) );
+
+    pCache = pParams->pSigningKeyCache;
+
+    if( ( pCache != NULL ) && ( isSigningKeyCached( pCache, pParams ) == 1U ) )
+    {
+        ( void ) memcpy( pSigningKey, pCache->pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+        pCache->hitCount++;
+    }
+    else
+    {
+        returnStatus = deriveSigningKey( pParams, pHmac, pSigningKey );
+
+        if( pCache != NULL )
+        {
+            pCache->missCount++;
+        }
+
+        if( ( returnStatus == SigV4Success ) && ( pCache != NULL ) )
+        {
+            returnStatus = storeSigningKey( pParams, pHmac, pSigningKey, pCache );
+
+            /* A key that cannot be cached is still used. */
+            if( returnStatus == SigV4InsufficientMemory )
+            {
+                returnStatus = SigV4Success;
+            }
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t storeSigningKey( const SigV4Parameters_t * pParams,
+                                      HmacContext_t * pHmac,
+                                      const uint8_t * pSigningKey,
+                                      SigV4SigningKeyCache_t * pCache )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Buffer_t tagBuffer = { 0 };
+
+    assert( ( pParams != NULL ) && ( pSigningKey != NULL ) && ( pCache != NULL ) );
+
+    pCache->hashContextsSaved = 0U;
+    tagBuffer.pData = pCache->pTag;
+    tagBuffer.bufferLen = SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH;
+
+    if( writeSigningKeyTag( pParams, &tagBuffer ) == SigV4Success )
+    {
+        ( void ) memcpy( pCache->pSigningKey, pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+        pCache->tagLen = tagBuffer.dataLen;
+        pCache->regionLen = pParams->regionLen;
+        pCache->serviceLen = pParams->serviceLen;
+
+        if( ( pCache->pInnerHashContext != NULL ) &&
+            ( pCache->pOuterHashContext != NULL ) &&
+            ( pParams->pCryptoInterface->hashCopyContext != NULL ) )
+        {
+            returnStatus = saveHmacStates( pHmac, pSigningKey, pCache );
+        }
+    }
+    else
+    {
+        /* The tag is partially overwritten, so the entry is invalid. */
+        LogDebug( ( "Signing key not cached: Tag does not fit in "
+                    "SIGV4_SIGNING_KEY_CACHE_TAG_LENGTH bytes." ) );
+        pCache->tagLen = 0U;
+        returnStatus = SigV4InsufficientMemory;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t saveHmacStates( HmacContext_t * pHmac,
+                                     const uint8_t * pSigningKey,
+                                     SigV4SigningKeyCache_t * pCache )
+{
+    SigV4Status_t returnStatus = SigV4HashError;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    size_t i = 0U, blockLen = 0U;
+
+    assert( ( pHmac != NULL ) && ( pHmac->pCryptoInterface != NULL ) );
+    assert( ( pSigningKey != NULL ) && ( pCache != NULL ) );
+
+    pCryptoInterface = pHmac->pCryptoInterface;
+    blockLen = getHashBlockLen( pCryptoInterface );
+
+    /* Hashes the inner padded key block. */
+    if( hmacInit( pHmac, NULL, 0U, pSigningKey, SIGV4_HASH_DIGEST_LENGTH ) != SigV4Success )
+    {
+        LogError( ( "Failed to hash the inner padded signing key." ) );
+    }
+    else if( pCryptoInterface->hashCopyContext( pCache->pInnerHashContext,
+                                                pCryptoInterface->pHashContext ) != 0 )
+    {
+        LogError( ( "Failed to save the HMAC inner hash state." ) );
+    }
+    else
+    {
+        for( i = 0U; i < blockLen; i++ )
+        {
+            pHmac->key[ i ] ^= ( uint8_t ) ( HMAC_INNER_PAD_BYTE ^ HMAC_OUTER_PAD_BYTE );
+        }
+
+        if( ( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 ) ||
+            ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                            pHmac->key,
+                                            blockLen ) != 0 ) ||
+            ( pCryptoInterface->hashCopyContext( pCache->pOuterHashContext,
+                                                 pCryptoInterface->pHashContext ) != 0 ) )
+        {
+            LogError( ( "Failed to save the HMAC outer hash state." ) );
+        }
+        else
+        {
+            pCache->hashContextsSaved = 1U;
+            returnStatus = SigV4Success;
+        }
+    }
+
+    ( void ) memset( pHmac->key, 0, sizeof( pHmac->key ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacFromSavedStates( const SigV4CryptoInterface_t * pCryptoInterface,
+                                          const SigV4SigningKeyCache_t * pCache,
+                                          const char * pData,
+                                          size_t dataLen,
+                                          uint8_t * pMac )
+{
+    SigV4Status_t returnStatus = SigV4HashError;
+
+    assert( ( pCryptoInterface != NULL ) && ( pCache != NULL ) );
+    assert( pMac != NULL );
+
+    if( ( pCryptoInterface->hashCopyContext( pCryptoInterface->pHashContext,
+                                             pCache->pInnerHashContext ) != 0 ) ||
+        ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                        ( const uint8_t * ) pData,
+                                        dataLen ) != 0 ) ||
+        ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                       pMac,
+                                       SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to compute the HMAC inner hash from the saved state." ) );
+    }
+    else if( ( pCryptoInterface->hashCopyContext( pCryptoInterface->pHashContext,
+                                                  pCache->pOuterHashContext ) != 0 ) ||
+             ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                             pMac,
+                                             SIGV4_HASH_DIGEST_LENGTH ) != 0 ) ||
+             ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                            pMac,
+                                            SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to compute the HMAC outer hash from the saved state." ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hmacWithSigningKey( const SigV4SigningKeyCache_t * pCache,
+                                         HmacContext_t * pHmac,
+                                         uint8_t * pKeyAndMac,
+                                         const char * pData,
+                                         size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pHmac != NULL ) && ( pHmac->pCryptoInterface != NULL ) );
+
+    /* The saved states always belong to the key returned by getSigningKey(),
+     * as they are invalidated whenever another key is derived. */
+    if( ( pCache != NULL ) &&
+        ( pCache->hashContextsSaved == 1U ) &&
+        ( pHmac->pCryptoInterface->hashCopyContext != NULL ) )
+    {
+        returnStatus = hmacFromSavedStates( pHmac->pCryptoInterface, pCache, pData, dataLen, pKeyAndMac );
+    }
+    else
+    {
+        returnStatus = chainHmac( pHmac, pKeyAndMac, pData, dataLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t getUriCharClass( char character )
+{
+    /* URI_CHAR_UNRESERVED (1) and URI_CHAR_SLASH (2) of every octet. */
+    static const uint8_t uriCharClassArr[ 256 ] =
+    {
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0x00 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0x10 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 1U, 1U, 2U, /* 0x20 */
+        1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0x30 */
+        0U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, /* 0x40 */
+        1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 0U, 1U, /* 0x50 */
+        0U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, /* 0x60 */
+        1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 1U, 0U, 0U, 0U, 1U, 0U, /* 0x70 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0x80 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0x90 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0xA0 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0xB0 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0xC0 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0xD0 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, /* 0xE0 */
+        0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U, 0U  /* 0xF0 */
+    };
+
+    return uriCharClassArr[ ( uint8_t ) character ];
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( URI_ENCODE_SSE2_SUPPORTED == 1 )
+
+    static size_t scanUnencodedRunSse2( const char * pData,
+                                        size_t start,
+                                        size_t dataLen,
+                                        uint8_t encodeSlash )
+    {
+        const __m128i caseBit = _mm_set1_epi8( 0x20 );
+        const __m128i beforeLetters = _mm_set1_epi8( ( char ) ( 'a' - 1 ) ), afterLetters = _mm_set1_epi8( ( char ) ( 'z' + 1 ) );
+        const __m128i beforeDigits = _mm_set1_epi8( ( char ) ( '-' - 1 ) ), afterDigits = _mm_set1_epi8( ( char ) ( '9' + 1 ) );
+        const __m128i underscore = _mm_set1_epi8( '_' ), tilde = _mm_set1_epi8( '~' );
+        const __m128i slash = _mm_set1_epi8( ( encodeSlash == 1U ) ? '/' : '\0' );
+        __m128i characters, letters, keep;
+        uint32_t keepBits = 0U;
+        uint8_t runEnded = 0U;
+        size_t i = start;
+
+        while( ( runEnded == 0U ) && ( ( dataLen - i ) >= URI_SCAN_SSE2_LENGTH ) )
+        {
+            /* Bytes above 0x7F are negative in the signed comparisons, so
+             * they fall outside every range. Setting the case bit maps the
+             * upper case letters onto the lower case ones. "-./0123456789"
+             * is contiguous, and '/' is removed from it when it is encoded. */
+            characters = _mm_loadu_si128( ( const __m128i * ) &pData[ i ] );
+            letters = _mm_or_si128( characters, caseBit );
+            keep = _mm_and_si128( _mm_cmpgt_epi8( letters, beforeLetters ), _mm_cmpgt_epi8( afterLetters, letters ) );
+            keep = _mm_or_si128( keep,
+                                 _mm_andnot_si128( _mm_cmpeq_epi8( characters, slash ),
+                                                   _mm_and_si128( _mm_cmpgt_epi8( characters, beforeDigits ),
+                                                                  _mm_cmpgt_epi8( afterDigits, characters ) ) ) );
+            keep = _mm_or_si128( keep, _mm_or_si128( _mm_cmpeq_epi8( characters, underscore ),
+                                                     _mm_cmpeq_epi8( characters, tilde ) ) );
+            keepBits = ( uint32_t ) _mm_movemask_epi8( keep );
+
+            if( keepBits == 0xFFFFU )
+            {
+                i += URI_SCAN_SSE2_LENGTH;
+            }
+            else
+            {
+                i += ( size_t ) __builtin_ctz( ~keepBits );
+                runEnded = 1U;
+            }
+        }
+
+        return i;
+    }
+
+#endif /* #if ( URI_ENCODE_SSE2_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( URI_ENCODE_AVX2_SUPPORTED == 1 )
+
+    static size_t scanUnencodedRunAvx2( const char * pData,
+                                        size_t start,
+                                        size_t dataLen,
+                                        uint8_t encodeSlash )
+    {
+        const __m256i caseBit = _mm256_set1_epi8( 0x20 );
+        const __m256i beforeLetters = _mm256_set1_epi8( ( char ) ( 'a' - 1 ) ), afterLetters = _mm256_set1_epi8( ( char ) ( 'z' + 1 ) );
+        const __m256i beforeDigits = _mm256_set1_epi8( ( char ) ( '-' - 1 ) ), afterDigits = _mm256_set1_epi8( ( char ) ( '9' + 1 ) );
+        const __m256i underscore = _mm256_set1_epi8( '_' ), tilde = _mm256_set1_epi8( '~' );
+        const __m256i slash = _mm256_set1_epi8( ( encodeSlash == 1U ) ? '/' : '\0' );
+        __m256i characters, letters, keep;
+        uint32_t keepBits = 0U;
+        uint8_t runEnded = 0U;
+        size_t i = start;
+
+        /* The characters are classified as in scanUnencodedRunSse2(). */
+        while( ( runEnded == 0U ) && ( ( dataLen - i ) >= URI_SCAN_AVX2_LENGTH ) )
+        {
+            characters = _mm256_loadu_si256( ( const __m256i * ) &pData[ i ] );
+            letters = _mm256_or_si256( characters, caseBit );
+            keep = _mm256_and_si256( _mm256_cmpgt_epi8( letters, beforeLetters ), _mm256_cmpgt_epi8( afterLetters, letters ) );
+            keep = _mm256_or_si256( keep,
+                                    _mm256_andnot_si256( _mm256_cmpeq_epi8( characters, slash ),
+                                                         _mm256_and_si256( _mm256_cmpgt_epi8( characters, beforeDigits ),
+                                                                           _mm256_cmpgt_epi8( afterDigits, characters ) ) ) );
+            keep = _mm256_or_si256( keep, _mm256_or_si256( _mm256_cmpeq_epi8( characters, underscore ),
+                                                           _mm256_cmpeq_epi8( characters, tilde ) ) );
+            keepBits = ( uint32_t ) _mm256_movemask_epi8( keep );
+
+            if( keepBits == 0xFFFFFFFFUL )
+            {
+                i += URI_SCAN_AVX2_LENGTH;
+            }
+            else
+            {
+                i += ( size_t ) __builtin_ctz( ~keepBits );
+                runEnded = 1U;
+            }
+        }
+
+        return i;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t useUriScanAvx2( void )
+    {
+        /* Tasks that check concurrently store the same result, so the
+         * word needs no ordering, only atomic accesses. */
+        static uint32_t avx2State = URI_SCAN_AVX2_UNKNOWN;
+        unsigned int eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+        uint32_t state = __atomic_load_n( &avx2State, __ATOMIC_RELAXED );
+
+        if( state == URI_SCAN_AVX2_UNKNOWN )
+        {
+            state = URI_SCAN_AVX2_UNSUPPORTED;
+
+            /* Leaf 1 reports AVX and whether XGETBV is available, to check
+             * that the OS saves the AVX registers. Leaf 7 reports AVX2. */
+            if( ( __get_cpuid( 1U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+                ( ( ecx & bit_OSXSAVE ) != 0U ) && ( ( ecx & bit_AVX ) != 0U ) )
+            {
+                __asm__ __volatile__ ( "xgetbv" : "=a" ( eax ), "=d" ( edx ) : "c" ( 0U ) );
+
+                if( ( ( eax & URI_SCAN_XCR0_AVX_STATE ) == URI_SCAN_XCR0_AVX_STATE ) &&
+                    ( __get_cpuid_count( 7U, 0U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+                    ( ( ebx & bit_AVX2 ) != 0U ) )
+                {
+                    state = URI_SCAN_AVX2_SUPPORTED;
+                }
+            }
+
+            __atomic_store_n( &avx2State, state, __ATOMIC_RELAXED );
+        }
+
+        return ( state == URI_SCAN_AVX2_SUPPORTED ) ? 1U : 0U;
+    }
+
+#endif /* #if ( URI_ENCODE_AVX2_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+static size_t findUnencodedRunEnd( const char * pData,
+                                   size_t start,
+                                   size_t dataLen,
+                                   uint8_t encodeSlash )
+{
+    uint8_t keepMask = URI_CHAR_UNRESERVED;
+    size_t i = start;
+
+    assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+    /* The vector scans stop at the end of the run, or before the characters
+     * that do not fill a vector, which the lookup table classifies. */
+    #if ( URI_ENCODE_AVX2_SUPPORTED == 1 )
+        if( useUriScanAvx2() == 1U )
+        {
+            i = scanUnencodedRunAvx2( pData, i, dataLen, encodeSlash );
+        }
+    #endif
+
+    #if ( URI_ENCODE_SSE2_SUPPORTED == 1 )
+        i = scanUnencodedRunSse2( pData, i, dataLen, encodeSlash );
+    #endif
+
+    if( encodeSlash == 0U )
+    {
+        keepMask |= URI_CHAR_SLASH;
+    }
+
+    while( ( i < dataLen ) && ( ( getUriCharClass( pData[ i ] ) & keepMask ) != 0U ) )
+    {
+        i++;
+    }
+
+    return i;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeEncodedData( SigV4Buffer_t * pBuffer,
+                                       const char * pData,
+                                       size_t dataLen,
+                                       uint8_t encodeSlash,
+                                       uint8_t doubleEncode )
+{
+    static const char digitArr[] = "0123456789ABCDEF";
+    SigV4Status_t returnStatus = SigV4Success;
+    char pEncoded[ 2U * URI_ENCODED_OCTET_LEN ] = { URI_ENCODE_ESCAPE_CHAR, '2', '5' };
+    size_t i = 0U, runEnd = 0U, escapeLen = 0U;
+    uint8_t octet = 0U;
+
+    assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+    /* When double encoding, the '%' of the first encoding is itself
+     * encoded as "%25". */
+    escapeLen = ( doubleEncode == 1U ) ? URI_ENCODED_OCTET_LEN : 1U;
+
+    while( ( i < dataLen ) && ( returnStatus == SigV4Success ) )
+    {
+        /* Copy each run of characters that need no encoding at once. */
+        runEnd = findUnencodedRunEnd( pData, i, dataLen, encodeSlash );
+
+        if( runEnd > i )
+        {
+            returnStatus = writeToBuffer( pBuffer, &pData[ i ], runEnd - i );
+            i = runEnd;
+        }
+
+        if( ( i < dataLen ) && ( returnStatus == SigV4Success ) )
+        {
+            octet = ( uint8_t ) pData[ i ];
+            pEncoded[ escapeLen ] = digitArr[ ( octet & 0xF0U ) >> 4 ];
+            pEncoded[ escapeLen + 1U ] = digitArr[ octet & 0x0FU ];
+            returnStatus = writeToBuffer( pBuffer, pEncoded, escapeLen + 2U );
+            i++;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+
+    static uint8_t isS3Service( const SigV4Parameters_t * pParams )
+    {
+        uint8_t isS3 = 0U;
+
+        assert( ( pParams != NULL ) && ( pParams->pService != NULL ) );
+
+        if( ( pParams->serviceLen == S3_SERVICE_NAME_LEN ) &&
+            ( strncmp( pParams->pService, S3_SERVICE_NAME, S3_SERVICE_NAME_LEN ) == 0 ) )
+        {
+            isS3 = 1U;
+        }
+
+        return isS3;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t isUnreservedChar( char character )
+    {
+        return ( uint8_t ) ( getUriCharClass( character ) & URI_CHAR_UNRESERVED );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static int32_t compareEncodedStrings( const SigV4ConstString_t * pFirst,
+                                          const SigV4ConstString_t * pSecond )
+    {
+        int32_t result = 0;
+        size_t i = 0U, minLen = 0U;
+        uint8_t firstUnreserved = 0U, secondUnreserved = 0U;
+
+        assert( ( pFirst != NULL ) && ( pSecond != NULL ) );
+
+        minLen = ( pFirst->dataLen < pSecond->dataLen ) ? pFirst->dataLen : pSecond->dataLen;
+
+        while( ( i < minLen ) && ( pFirst->pData[ i ] == pSecond->pData[ i ] ) )
+        {
+            i++;
+        }
+
+        if( i < minLen )
+        {
+            firstUnreserved = isUnreservedChar( pFirst->pData[ i ] );
+            secondUnreserved = isUnreservedChar( pSecond->pData[ i ] );
+
+            if( firstUnreserved != secondUnreserved )
+            {
+                /* The '%' of an encoded character sorts before all unreserved
+                 * characters. */
+                result = ( firstUnreserved == 0U ) ? -1 : 1;
+            }
+            else
+            {
+                result = ( ( uint8_t ) pFirst->pData[ i ] < ( uint8_t ) pSecond->pData[ i ] ) ? -1 : 1;
+            }
+        }
+        else if( pFirst->dataLen != pSecond->dataLen )
+        {
+            result = ( pFirst->dataLen < pSecond->dataLen ) ? -1 : 1;
+        }
+        else
+        {
+            /* The strings are equal. */
+        }
+
+        return result;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint64_t packEncodedKeyPrefix( const char * pKey,
+                                          size_t keyLen )
+    {
+        static const char digitArr[] = "0123456789ABCDEF";
+        uint64_t prefix = 0U;
+        char pEncoded[ URI_ENCODED_OCTET_LEN ] = { URI_ENCODE_ESCAPE_CHAR };
+        size_t i = 0U, j = 0U, encodedLen = 0U, packedLen = 0U;
+        uint8_t octet = 0U;
+
+        assert( ( pKey != NULL ) || ( keyLen == 0U ) );
+
+        for( i = 0U; ( i < keyLen ) && ( packedLen < QUERY_KEY_PREFIX_LEN ); i++ )
+        {
+            if( isUnreservedChar( pKey[ i ] ) == 1U )
+            {
+                prefix = ( prefix << 8 ) | ( uint8_t ) pKey[ i ];
+                packedLen++;
+            }
+            else
+            {
+                octet = ( uint8_t ) pKey[ i ];
+                pEncoded[ 1 ] = digitArr[ ( octet & 0xF0U ) >> 4 ];
+                pEncoded[ 2 ] = digitArr[ octet & 0x0FU ];
+                encodedLen = ( ( QUERY_KEY_PREFIX_LEN - packedLen ) < URI_ENCODED_OCTET_LEN ) ?
+                             ( QUERY_KEY_PREFIX_LEN - packedLen ) : URI_ENCODED_OCTET_LEN;
+
+                for( j = 0U; j < encodedLen; j++ )
+                {
+                    prefix = ( prefix << 8 ) | ( uint8_t ) pEncoded[ j ];
+                }
+
+                packedLen += encodedLen;
+            }
+        }
+
+        /* Encoded keys never contain a zero byte, so padding with zeros sorts
+         * a key before the longer keys it is a prefix of. */
+        for( ; packedLen < QUERY_KEY_PREFIX_LEN; packedLen++ )
+        {
+            prefix <<= 8;
+        }
+
+        return prefix;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static int32_t compareQueryRecords( const QueryRecord_t * pFirst,
+                                        const QueryRecord_t * pSecond )
+    {
+        int32_t result = 0;
+        SigV4ConstString_t first = { 0 }, second = { 0 };
+
+        assert( ( pFirst != NULL ) && ( pSecond != NULL ) );
+
+        if( pFirst->keyPrefix != pSecond->keyPrefix )
+        {
+            result = ( pFirst->keyPrefix < pSecond->keyPrefix ) ? -1 : 1;
+        }
+        else
+        {
+            first.pData = pFirst->pKey;
+            first.dataLen = pFirst->keyLen;
+            second.pData = pSecond->pKey;
+            second.dataLen = pSecond->keyLen;
+            result = compareEncodedStrings( &first, &second );
+        }
+
+        if( result == 0 )
+        {
+            first.pData = ( pFirst->valueLen > 0U ) ? &pFirst->pKey[ pFirst->keyLen + 1U ] : NULL;
+            first.dataLen = pFirst->valueLen;
+            second.pData = ( pSecond->valueLen > 0U ) ? &pSecond->pKey[ pSecond->keyLen + 1U ] : NULL;
+            second.dataLen = pSecond->valueLen;
+            result = compareEncodedStrings( &first, &second );
+        }
+
+        return result;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static size_t findQueryDelimiter( const char * pQuery,
+                                      size_t start,
+                                      size_t queryLen,
+                                      uint8_t matchValueSeparator )
+    {
+        uint64_t word = 0U, matches = 0U;
+        size_t i = start;
+
+        assert( ( pQuery != NULL ) && ( start <= queryLen ) );
+
+        /* Skip the words that contain no delimiter. A word is loaded with
+         * memcpy, as the query may not be aligned. */
+        while( ( matches == 0U ) && ( ( queryLen - i ) >= sizeof( word ) ) )
+        {
+            ( void ) memcpy( &word, &pQuery[ i ], sizeof( word ) );
+            matches = SWAR_HAS_ZERO_BYTE( word ^ SWAR_BROADCAST( QUERY_PAIR_SEPARATOR ) );
+
+            if( matchValueSeparator == 1U )
+            {
+                matches |= SWAR_HAS_ZERO_BYTE( word ^ SWAR_BROADCAST( QUERY_VALUE_SEPARATOR ) );
+            }
+
+            if( matches == 0U )
+            {
+                i += sizeof( word );
+            }
+        }
+
+        /* Locate the delimiter within the word that contains it, or within
+         * the bytes left over. This does not depend on the byte order. */
+        while( ( i < queryLen ) && ( pQuery[ i ] != QUERY_PAIR_SEPARATOR ) &&
+               ( ( matchValueSeparator == 0U ) || ( pQuery[ i ] != QUERY_VALUE_SEPARATOR ) ) )
+        {
+            i++;
+        }
+
+        return i;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static SigV4Status_t parseQuery( CanonicalContext_t * pCanonicalContext,
+                                     const char * pQuery,
+                                     size_t queryLen )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        QueryRecord_t * pRecord = NULL;
+        size_t start = 0U, end = 0U, separator = 0U;
+
+        assert( pCanonicalContext != NULL );
+        assert( ( pQuery != NULL ) || ( queryLen == 0U ) );
+
+        pCanonicalContext->queryCount = 0U;
+
+        while( ( start < queryLen ) && ( returnStatus == SigV4Success ) )
+        {
+            /* Find the end of the key, then the end of the pair. */
+            separator = findQueryDelimiter( pQuery, start, queryLen, 1U );
+            end = separator;
+
+            if( ( separator < queryLen ) && ( pQuery[ separator ] == QUERY_VALUE_SEPARATOR ) )
+            {
+                end = findQueryDelimiter( pQuery, separator + 1U, queryLen, 0U );
+            }
+
+            if( end == start )
+            {
+                /* Skip the empty pair of "&&". */
+            }
+            else if( ( size_t ) ( uint32_t ) ( end - start ) != ( end - start ) )
+            {
+                LogError( ( "Invalid query pair: %lu bytes is too long.", ( unsigned long ) ( end - start ) ) );
+                returnStatus = SigV4InvalidParameter;
+            }
+            else if( pCanonicalContext->queryCount == SIGV4_MAX_QUERY_PAIR_COUNT )
+            {
+                LogError( ( "Number of query pairs exceeds SIGV4_MAX_QUERY_PAIR_COUNT=%lu.",
+                            ( unsigned long ) SIGV4_MAX_QUERY_PAIR_COUNT ) );
+                returnStatus = SigV4MaxQueryPairCountExceeded;
+            }
+            else
+            {
+                /* A key without '=' has an empty value. */
+                pRecord = &pCanonicalContext->pQueryLoc[ pCanonicalContext->queryCount ];
+                pRecord->pKey = &pQuery[ start ];
+                pRecord->keyLen = ( uint32_t ) ( separator - start );
+                pRecord->valueLen = ( separator < end ) ? ( uint32_t ) ( end - separator - 1U ) : 0U;
+                pRecord->keyPrefix = packEncodedKeyPrefix( pRecord->pKey, pRecord->keyLen );
+                pCanonicalContext->queryCount++;
+            }
+
+            start = end + 1U;
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static SigV4Status_t writeCanonicalQuery( CanonicalContext_t * pCanonicalContext )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        const QueryRecord_t * pRecord = NULL;
+        size_t i = 0U;
+
+        assert( pCanonicalContext != NULL );
+
+        sortQueryRecords( pCanonicalContext->pQueryLoc, pCanonicalContext->queryCount );
+
+        for( i = 0U; ( i < pCanonicalContext->queryCount ) && ( returnStatus == SigV4Success ); i++ )
+        {
+            pRecord = &pCanonicalContext->pQueryLoc[ i ];
+
+            if( i > 0U )
+            {
+                returnStatus = writeCharToBuffer( &pCanonicalContext->processing, QUERY_PAIR_SEPARATOR );
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeEncodedData( &pCanonicalContext->processing,
+                                                 pRecord->pKey, pRecord->keyLen, 1U, 0U );
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeCharToBuffer( &pCanonicalContext->processing, QUERY_VALUE_SEPARATOR );
+            }
+
+            if( ( returnStatus == SigV4Success ) && ( pRecord->valueLen > 0U ) )
+            {
+                returnStatus = writeEncodedData( &pCanonicalContext->processing,
+                                                 &pRecord->pKey[ pRecord->keyLen + 1U ], pRecord->valueLen, 1U, 0U );
+            }
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t isHeaderSpace( char character )
+    {
+        return ( ( character == ' ' ) || ( character == '\t' ) ) ? 1U : 0U;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void trimHeaderValue( const char * pValue,
+                                 size_t valueLen,
+                                 SigV4ConstString_t * pTrimmed )
+    {
+        size_t start = 0U, end = valueLen;
+
+        assert( ( ( pValue != NULL ) || ( valueLen == 0U ) ) && ( pTrimmed != NULL ) );
+
+        while( ( start < end ) && ( isHeaderSpace( pValue[ start ] ) == 1U ) )
+        {
+            start++;
+        }
+
+        while( ( end > start ) && ( isHeaderSpace( pValue[ end - 1U ] ) == 1U ) )
+        {
+            end--;
+        }
+
+        pTrimmed->pData = &pValue[ start ];
+        pTrimmed->dataLen = end - start;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static SigV4Status_t writeTrimmedHeaderValue( SigV4Buffer_t * pBuffer,
+                                                  const char * pValue,
+                                                  size_t valueLen )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        SigV4ConstString_t trimmed = { 0 };
+        size_t i = 0U, runEnd = 0U;
+
+        assert( ( pValue != NULL ) || ( valueLen == 0U ) );
+
+        trimHeaderValue( pValue, valueLen, &trimmed );
+
+        while( ( i < trimmed.dataLen ) && ( returnStatus == SigV4Success ) )
+        {
+            /* Write each run of non-space characters at once, so that a value
+             * longer than the buffer, such as a security token, is hashed in
+             * place instead of being copied. */
+            runEnd = i;
+
+            while( ( runEnd < trimmed.dataLen ) && ( isHeaderSpace( trimmed.pData[ runEnd ] ) == 0U ) )
+            {
+                runEnd++;
+            }
+
+            returnStatus = writeToBuffer( pBuffer, &trimmed.pData[ i ], runEnd - i );
+            i = runEnd;
+
+            /* Only the first of a run of spaces is written. The value is
+             * trimmed, so it does not end with a space. */
+            if( ( i < trimmed.dataLen ) && ( returnStatus == SigV4Success ) )
+            {
+                returnStatus = writeCharToBuffer( pBuffer, ' ' );
+
+                while( isHeaderSpace( trimmed.pData[ i ] ) == 1U )
+                {
+                    i++;
+                }
+            }
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sortQueryRecords( QueryRecord_t * pRecords,
+                                  size_t recordCount )
+    {
+        QueryRecord_t pivot;
+        size_t i = 0U, j = 0U;
+
+        assert( pRecords != NULL );
+
+        for( i = 1U; i < recordCount; i++ )
+        {
+            pivot = pRecords[ i ];
+            j = i;
+
+            while( ( j > 0U ) && ( compareQueryRecords( &pRecords[ j - 1U ], &pivot ) > 0 ) )
+            {
+                pRecords[ j ] = pRecords[ j - 1U ];
+                j--;
+            }
+
+            pRecords[ j ] = pivot;
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sortHeaderRecords( HeaderRecord_t * pRecords,
+                                   size_t recordCount )
+    {
+        HeaderRecord_t pivot;
+        size_t i = 0U, j = 0U;
+
+        assert( pRecords != NULL );
+
+        for( i = 1U; i < recordCount; i++ )
+        {
+            pivot = pRecords[ i ];
+            j = i;
+
+            while( ( j > 0U ) && ( compareHeaderNames( &pRecords[ j - 1U ], &pivot ) > 0 ) )
+            {
+                pRecords[ j ] = pRecords[ j - 1U ];
+                j--;
+            }
+
+            pRecords[ j ] = pivot;
+        }
+    }
+
+#endif /* #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+static char lowercaseChar( char character )
+{
+    char lowercase = character;
+
+    if( ( character >= 'A' ) && ( character <= 'Z' ) )
+    {
+        lowercase = ( char ) ( character + ( 'a' - 'A' ) );
+    }
+
+    return lowercase;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint64_t packNamePrefix( const char * pName,
+                                size_t nameLen )
+{
+    uint64_t prefix = 0U;
+    size_t i = 0U;
+
+    assert( ( pName != NULL ) || ( nameLen == 0U ) );
+
+    for( i = 0U; i < HEADER_NAME_PREFIX_LEN; i++ )
+    {
+        prefix <<= 8;
+
+        if( i < nameLen )
+        {
+            prefix |= ( uint8_t ) lowercaseChar( pName[ i ] );
+        }
+    }
+
+    return prefix;
+}
+
+/*-----------------------------------------------------------*/
+
+static int32_t compareHeaderNames( const HeaderRecord_t * pFirst,
+                                   const HeaderRecord_t * pSecond )
+{
+    int32_t result = 0;
+    size_t i = 0U, minLen = 0U;
+    char firstChar = '\0', secondChar = '\0';
+
+    assert( ( pFirst != NULL ) && ( pSecond != NULL ) );
+
+    if( pFirst->namePrefix != pSecond->namePrefix )
+    {
+        result = ( pFirst->namePrefix < pSecond->namePrefix ) ? -1 : 1;
+    }
+    else
+    {
+        /* The names are equal up to the prefix length, or up to the end of
+         * the shorter name if that comes first. */
+        minLen = ( pFirst->nameLen < pSecond->nameLen ) ? pFirst->nameLen : pSecond->nameLen;
+
+        for( i = HEADER_NAME_PREFIX_LEN; ( i < minLen ) && ( result == 0 ); i++ )
+        {
+            firstChar = lowercaseChar( pFirst->pName[ i ] );
+            secondChar = lowercaseChar( pSecond->pName[ i ] );
+
+            if( firstChar != secondChar )
+            {
+                result = ( ( uint8_t ) firstChar < ( uint8_t ) secondChar ) ? -1 : 1;
+            }
+        }
+
+        if( ( result == 0 ) && ( pFirst->nameLen != pSecond->nameLen ) )
+        {
+            result = ( pFirst->nameLen < pSecond->nameLen ) ? -1 : 1;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t parseHeaders( CanonicalContext_t * pCanonicalContext,
+                                   const char * pHeaders,
+                                   size_t headersLen,
+                                   uint8_t isCanonical )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    HeaderRecord_t * pRecord = NULL;
+    size_t start = 0U, end = 0U, separator = 0U, lineLen = 0U;
+
+    assert( pCanonicalContext != NULL );
+    assert( ( pHeaders != NULL ) || ( headersLen == 0U ) );
+
+    pCanonicalContext->headersCount = 0U;
+
+    while( ( start < headersLen ) && ( returnStatus == SigV4Success ) )
+    {
+        end = start;
+        separator = headersLen;
+
+        while( ( end < headersLen ) && ( pHeaders[ end ] != LINEFEED_CHAR ) )
+        {
+            if( ( separator == headersLen ) && ( pHeaders[ end ] == HTTP_HEADER_NAME_SEPARATOR ) )
+            {
+                separator = end;
+            }
+
+            end++;
+        }
+
+        /* Raw headers are terminated by "\r\n". */
+        lineLen = end - start;
+
+        if( ( isCanonical == 0U ) && ( lineLen > 0U ) && ( pHeaders[ end - 1U ] == CARRIAGE_RETURN_CHAR ) )
+        {
+            lineLen--;
+        }
+
+        if( lineLen == 0U )
+        {
+            /* Skip the empty line ending the headers. */
+        }
+        else if( ( separator >= ( start + lineLen ) ) || ( separator == start ) )
+        {
+            LogError( ( "Invalid header line: \"%.*s\" has no header name.",
+                        ( int ) lineLen, &pHeaders[ start ] ) );
+            returnStatus = SigV4InvalidParameter;
+        }
+        else if( ( size_t ) ( uint32_t ) lineLen != lineLen )
+        {
+            LogError( ( "Invalid header line: %lu bytes is too long.", ( unsigned long ) lineLen ) );
+            returnStatus = SigV4InvalidParameter;
+        }
+        else if( pCanonicalContext->headersCount == SIGV4_MAX_HTTP_HEADER_COUNT )
+        {
+            LogError( ( "Number of headers exceeds SIGV4_MAX_HTTP_HEADER_COUNT=%lu.",
+                        ( unsigned long ) SIGV4_MAX_HTTP_HEADER_COUNT ) );
+            returnStatus = SigV4MaxHeaderPairCountExceeded;
+        }
+        else
+        {
+            pRecord = &pCanonicalContext->pHeadersLoc[ pCanonicalContext->headersCount ];
+            pRecord->pName = &pHeaders[ start ];
+            pRecord->nameLen = ( uint32_t ) ( separator - start );
+            pRecord->valueLen = ( uint32_t ) ( start + lineLen - separator - 1U );
+            pRecord->namePrefix = packNamePrefix( pRecord->pName, pRecord->nameLen );
+            pCanonicalContext->headersCount++;
+        }
+
+        start = end + 1U;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeLowercaseName( SigV4Buffer_t * pBuffer,
+                                         const HeaderRecord_t * pRecord )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t i = 0U;
+
+    assert( ( pBuffer != NULL ) && ( pRecord != NULL ) );
+
+    for( i = 0U; ( i < pRecord->nameLen ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, lowercaseChar( pRecord->pName[ i ] ) );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+
+    static SigV4Status_t writeHeaderNameOrSeparator( CanonicalContext_t * pCanonicalContext,
+                                                     size_t index )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        const HeaderRecord_t * pRecord = NULL;
+
+        assert( ( pCanonicalContext != NULL ) && ( index < pCanonicalContext->headersCount ) );
+
+        pRecord = &pCanonicalContext->pHeadersLoc[ index ];
+
+        /* The values of a repeated header name are joined by commas. */
+        if( ( index > 0U ) && ( compareHeaderNames( &pCanonicalContext->pHeadersLoc[ index - 1U ], pRecord ) == 0 ) )
+        {
+            returnStatus = writeCharToBuffer( &pCanonicalContext->processing, HEADER_VALUE_SEPARATOR );
+        }
+        else
+        {
+            if( index > 0U )
+            {
+                returnStatus = writeCharToBuffer( &pCanonicalContext->processing, LINEFEED_CHAR );
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeLowercaseName( &pCanonicalContext->processing, pRecord );
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeCharToBuffer( &pCanonicalContext->processing, HTTP_HEADER_NAME_SEPARATOR );
+            }
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static SigV4Status_t writeCanonicalHeaders( CanonicalContext_t * pCanonicalContext )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        const HeaderRecord_t * pRecord = NULL;
+        size_t i = 0U;
+
+        assert( pCanonicalContext != NULL );
+
+        for( i = 0U; ( i < pCanonicalContext->headersCount ) && ( returnStatus == SigV4Success ); i++ )
+        {
+            pRecord = &pCanonicalContext->pHeadersLoc[ i ];
+            returnStatus = writeHeaderNameOrSeparator( pCanonicalContext, i );
+
+            if( ( returnStatus == SigV4Success ) &&
+                ( pCanonicalContext->pRetrySnapshot != NULL ) &&
+                ( isHeaderNamed( pRecord, SIGV4_HTTP_X_AMZ_DATE_HEADER, X_AMZ_DATE_HEADER_LEN ) == 1U ) )
+            {
+                returnStatus = startRetrySnapshot( pCanonicalContext );
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeHeaderValue( pCanonicalContext, pRecord );
+            }
+        }
+
+        if( ( returnStatus == SigV4Success ) && ( pCanonicalContext->headersCount > 0U ) )
+        {
+            returnStatus = writeCharToBuffer( &pCanonicalContext->processing, LINEFEED_CHAR );
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static SigV4Status_t writeHeaderValue( CanonicalContext_t * pCanonicalContext,
+                                           const HeaderRecord_t * pRecord )
+    {
+        SigV4Status_t returnStatus = SigV4Success;
+        SigV4ConstString_t trimmed = { 0 };
+
+        assert( ( pCanonicalContext != NULL ) && ( pRecord != NULL ) );
+
+        trimHeaderValue( &pRecord->pName[ pRecord->nameLen + 1U ], pRecord->valueLen, &trimmed );
+
+        if( ( isHeaderNamed( pRecord, SIGV4_HTTP_X_AMZ_SECURITY_TOKEN_HEADER, X_AMZ_SECURITY_TOKEN_HEADER_LEN ) == 1U ) &&
+            ( isCredentialsToken( pCanonicalContext, trimmed.pData, trimmed.dataLen ) == 1U ) )
+        {
+            returnStatus = writeSecurityToken( pCanonicalContext );
+        }
+        else
+        {
+            returnStatus = writeTrimmedHeaderValue( &pCanonicalContext->processing,
+                                                    &pRecord->pName[ pRecord->nameLen + 1U ],
+                                                    pRecord->valueLen );
+        }
+
+        return returnStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t isHeaderNamed( const HeaderRecord_t * pRecord,
+                                  const char * pName,
+                                  size_t nameLen )
+    {
+        uint8_t isNamed = 0U;
+        size_t i = 0U;
+
+        assert( ( pRecord != NULL ) && ( pName != NULL ) );
+
+        if( pRecord->nameLen == nameLen )
+        {
+            isNamed = 1U;
+
+            for( i = 0U; ( i < nameLen ) && ( isNamed == 1U ); i++ )
+            {
+                if( lowercaseChar( pRecord->pName[ i ] ) != pName[ i ] )
+                {
+                    isNamed = 0U;
+                }
+            }
+        }
+
+        return isNamed;
+    }
+
+#endif /* #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeSignedHeaders( const CanonicalContext_t * pCanonicalContext,
+                                         SigV4Buffer_t * pBuffer,
+                                         uint8_t encodeSeparator )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t i = 0U;
+
+    assert( pCanonicalContext != NULL );
+
+    for( i = 0U; ( i < pCanonicalContext->headersCount ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        /* A repeated header name is only signed once. */
+        if( ( i == 0U ) || ( compareHeaderNames( &pCanonicalContext->pHeadersLoc[ i - 1U ],
+                                                 &pCanonicalContext->pHeadersLoc[ i ] ) != 0 ) )
+        {
+            if( ( i > 0U ) && ( encodeSeparator == 1U ) )
+            {
+                returnStatus = writeToBuffer( pBuffer, SIGNED_HEADERS_SEPARATOR_ENCODED, URI_ENCODED_OCTET_LEN );
+            }
+            else if( i > 0U )
+            {
+                returnStatus = writeCharToBuffer( pBuffer, SIGNED_HEADERS_SEPARATOR );
+            }
+            else
+            {
+                /* The first name has no separator. */
+            }
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeLowercaseName( pBuffer, &pCanonicalContext->pHeadersLoc[ i ] );
+            }
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t getPathEncoding( const SigV4Parameters_t * pParams )
+{
+    uint8_t pathEncoding = PATH_NOT_ENCODED;
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) );
+
+    #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+        if( ( pParams->pHttpParameters->flags & ( SIGV4_HTTP_PATH_IS_CANONICAL_FLAG | SIGV4_HTTP_ALL_ARE_CANONICAL_FLAG ) ) != 0U )
+        {
+            /* The path is written as is. */
+        }
+        /* Every service except S3 expects the path to be encoded twice. */
+        else if( isS3Service( pParams ) == 1U )
+        {
+            pathEncoding = PATH_ENCODED_ONCE;
+        }
+        else
+        {
+            pathEncoding = PATH_ENCODED_TWICE;
+        }
+    #else
+        ( void ) pParams;
+    #endif
+
+    return pathEncoding;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writePath( SigV4Buffer_t * pBuffer,
+                                const char * pPath,
+                                size_t pathLen,
+                                uint8_t pathEncoding )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( pBuffer != NULL );
+
+    if( pathEncoding == PATH_NOT_ENCODED )
+    {
+        returnStatus = writeToBuffer( pBuffer, pPath, pathLen );
+    }
+    else
+    {
+        returnStatus = writeEncodedData( pBuffer,
+                                         pPath,
+                                         pathLen,
+                                         0U,
+                                         ( pathEncoding == PATH_ENCODED_TWICE ) ? 1U : 0U );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeCanonicalUri( const SigV4Parameters_t * pParams,
+                                        CanonicalContext_t * pCanonicalContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4HttpParameters_t * pHttpParams = NULL;
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) );
+    assert( pCanonicalContext != NULL );
+
+    pHttpParams = pParams->pHttpParameters;
+
+    if( pHttpParams->pathLen == 0U )
+    {
+        returnStatus = writeToBuffer( &pCanonicalContext->processing, HTTP_EMPTY_PATH, sizeof( HTTP_EMPTY_PATH ) - 1U );
+    }
+    else
+    {
+        returnStatus = writePath( &pCanonicalContext->processing,
+                                  pHttpParams->pPath,
+                                  pHttpParams->pathLen,
+                                  getPathEncoding( pParams ) );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeQueryString( const SigV4HttpParameters_t * pHttpParams,
+                                       CanonicalContext_t * pCanonicalContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pHttpParams != NULL ) && ( pCanonicalContext != NULL ) );
+
+    #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+        if( ( pHttpParams->flags & ( SIGV4_HTTP_QUERY_IS_CANONICAL_FLAG | SIGV4_HTTP_ALL_ARE_CANONICAL_FLAG ) ) == 0U )
+        {
+            returnStatus = parseQuery( pCanonicalContext, pHttpParams->pQuery, pHttpParams->queryLen );
+
+            if( returnStatus == SigV4Success )
+            {
+                returnStatus = writeCanonicalQuery( pCanonicalContext );
+            }
+        }
+        else
+    #endif /* #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 ) */
+    {
+        returnStatus = writeToBuffer( &pCanonicalContext->processing, pHttpParams->pQuery, pHttpParams->queryLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t parseRequestHeaders( const SigV4HttpParameters_t * pHttpParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          uint8_t * pIsCanonical )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pHttpParams != NULL ) && ( pCanonicalContext != NULL ) && ( pIsCanonical != NULL ) );
+
+    #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+        *pIsCanonical = ( ( pHttpParams->flags & ( SIGV4_HTTP_HEADERS_ARE_CANONICAL_FLAG | SIGV4_HTTP_ALL_ARE_CANONICAL_FLAG ) ) != 0U ) ? 1U : 0U;
+    #else
+        *pIsCanonical = 1U;
+    #endif
+
+    returnStatus = parseHeaders( pCanonicalContext, pHttpParams->pHeaders, pHttpParams->headersLen, *pIsCanonical );
+
+    #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+        if( ( returnStatus == SigV4Success ) && ( *pIsCanonical == 0U ) )
+        {
+            sortHeaderRecords( pCanonicalContext->pHeadersLoc, pCanonicalContext->headersCount );
+        }
+    #endif
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeHeaders( const SigV4HttpParameters_t * pHttpParams,
+                                   CanonicalContext_t * pCanonicalContext,
+                                   SigV4Buffer_t * pAuthBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    uint8_t isCanonical = 0U;
+    size_t signedHeadersStart = 0U;
+
+    assert( ( pHttpParams != NULL ) && ( pCanonicalContext != NULL ) );
+
+    returnStatus = parseRequestHeaders( pHttpParams, pCanonicalContext, &isCanonical );
+
+    if( ( returnStatus == SigV4Success ) && ( isCanonical == 0U ) )
+    {
+        #if ( SIGV4_USE_CANONICAL_SUPPORT == 1 )
+            returnStatus = writeCanonicalHeaders( pCanonicalContext );
+        #endif
+    }
+    /* Canonical headers are already lowercase, sorted, trimmed and terminated
+     * by linefeeds. */
+    else if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCanonicalHeaderLines( pHttpParams, pCanonicalContext );
+    }
+    else
+    {
+        /* The headers could not be parsed. */
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &pCanonicalContext->processing, LINEFEED_CHAR );
+    }
+
+    /* The signed headers are written to the Authorization value, then copied
+     * from there to the canonical request. A presigned URL has no
+     * Authorization value. */
+    if( ( returnStatus == SigV4Success ) && ( pAuthBuffer == NULL ) )
+    {
+        returnStatus = writeSignedHeaders( pCanonicalContext, &pCanonicalContext->processing, 0U );
+    }
+    else if( returnStatus == SigV4Success )
+    {
+        signedHeadersStart = pAuthBuffer->dataLen;
+        returnStatus = writeSignedHeaders( pCanonicalContext, pAuthBuffer, 0U );
+
+        if( returnStatus == SigV4Success )
+        {
+            returnStatus = writeToBuffer( &pCanonicalContext->processing,
+                                          &pAuthBuffer->pData[ signedHeadersStart ],
+                                          pAuthBuffer->dataLen - signedHeadersStart );
+        }
+    }
+    else
+    {
+        /* The canonical headers could not be written. */
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t findCanonicalHeaderValue( const char * pHeaders,
+                                        size_t headersLen,
+                                        const char * pName,
+                                        size_t nameLen )
+{
+    size_t lineStart = 0U, valueStart = headersLen;
+    const char * pLineEnd = NULL;
+
+    assert( ( pHeaders != NULL ) || ( headersLen == 0U ) );
+    assert( pName != NULL );
+
+    while( lineStart < headersLen )
+    {
+        if( ( ( headersLen - lineStart ) > nameLen ) &&
+            ( strncmp( &pHeaders[ lineStart ], pName, nameLen ) == 0 ) &&
+            ( pHeaders[ lineStart + nameLen ] == HTTP_HEADER_NAME_SEPARATOR ) )
+        {
+            valueStart = lineStart + nameLen + 1U;
+            lineStart = headersLen;
+        }
+        else
+        {
+            pLineEnd = ( const char * ) memchr( &pHeaders[ lineStart ], LINEFEED_CHAR, headersLen - lineStart );
+            lineStart = ( pLineEnd != NULL ) ? ( ( size_t ) ( pLineEnd - pHeaders ) + 1U ) : headersLen;
+        }
+    }
+
+    return valueStart;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeCanonicalHeaderLines( const SigV4HttpParameters_t * pHttpParams,
+                                                CanonicalContext_t * pCanonicalContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const char * pHeaders = NULL;
+    const char * pLineEnd = NULL;
+    size_t headersLen = 0U, dateValueStart = 0U, tokenValueStart = 0U, tokenValueEnd = 0U;
+
+    assert( ( pHttpParams != NULL ) && ( pCanonicalContext != NULL ) );
+
+    pHeaders = pHttpParams->pHeaders;
+    headersLen = pHttpParams->headersLen;
+    dateValueStart = headersLen;
+    tokenValueStart = headersLen;
+    tokenValueEnd = headersLen;
+
+    if( pCanonicalContext->pRetrySnapshot != NULL )
+    {
+        dateValueStart = findCanonicalHeaderValue( pHeaders, headersLen,
+                                                   SIGV4_HTTP_X_AMZ_DATE_HEADER, X_AMZ_DATE_HEADER_LEN );
+    }
+
+    /* x-amz-security-token sorts after x-amz-date, so the token is only left
+     * out of a snapshot that starts before it. */
+    if( dateValueStart < headersLen )
+    {
+        tokenValueStart = dateValueStart + findCanonicalHeaderValue( &pHeaders[ dateValueStart ],
+                                                                     headersLen - dateValueStart,
+                                                                     SIGV4_HTTP_X_AMZ_SECURITY_TOKEN_HEADER,
+                                                                     X_AMZ_SECURITY_TOKEN_HEADER_LEN );
+    }
+
+    if( tokenValueStart < headersLen )
+    {
+        pLineEnd = ( const char * ) memchr( &pHeaders[ tokenValueStart ], LINEFEED_CHAR, headersLen - tokenValueStart );
+        tokenValueEnd = ( pLineEnd != NULL ) ? ( size_t ) ( pLineEnd - pHeaders ) : headersLen;
+
+        if( isCredentialsToken( pCanonicalContext, &pHeaders[ tokenValueStart ], tokenValueEnd - tokenValueStart ) == 0U )
+        {
+            tokenValueStart = headersLen;
+            tokenValueEnd = headersLen;
+        }
+    }
+
+    returnStatus = writeToBuffer( &pCanonicalContext->processing, pHeaders, dateValueStart );
+
+    if( ( returnStatus == SigV4Success ) && ( dateValueStart < headersLen ) )
+    {
+        returnStatus = startRetrySnapshot( pCanonicalContext );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &pCanonicalContext->processing,
+                                      &pHeaders[ dateValueStart ],
+                                      tokenValueStart - dateValueStart );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( tokenValueStart < headersLen ) )
+    {
+        returnStatus = writeSecurityToken( pCanonicalContext );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &pCanonicalContext->processing,
+                                      &pHeaders[ tokenValueEnd ],
+                                      headersLen - tokenValueEnd );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t isCredentialsToken( const CanonicalContext_t * pCanonicalContext,
+                                   const char * pValue,
+                                   size_t valueLen )
+{
+    uint8_t isToken = 0U;
+
+    assert( pCanonicalContext != NULL );
+    assert( ( pValue != NULL ) || ( valueLen == 0U ) );
+
+    if( ( pCanonicalContext->securityToken.dataLen > 0U ) &&
+        ( pCanonicalContext->securityToken.dataLen == valueLen ) &&
+        ( memcmp( pCanonicalContext->securityToken.pData, pValue, valueLen ) == 0 ) )
+    {
+        isToken = 1U;
+    }
+
+    return isToken;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeSecurityToken( CanonicalContext_t * pCanonicalContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Buffer_t * pProcessing = NULL;
+    SigV4RetrySnapshot_t * pSnapshot = NULL;
+
+    assert( pCanonicalContext != NULL );
+
+    pProcessing = &pCanonicalContext->processing;
+
+    /* A buffer that is not hashed, such as a presign template, keeps a copy
+     * of the token. */
+    if( pProcessing->pCryptoInterface == NULL )
+    {
+        returnStatus = writeToBuffer( pProcessing,
+                                      pCanonicalContext->securityToken.pData,
+                                      pCanonicalContext->securityToken.dataLen );
+    }
+    else
+    {
+        returnStatus = flushBuffer( pProcessing );
+
+        /* A retry is signed with the token of its own credentials, so a
+         * snapshot only needs to know where the token goes. A second token
+         * header is copied to the snapshot as any other data. */
+        pSnapshot = pProcessing->pRetrySnapshot;
+
+        if( ( pSnapshot != NULL ) && ( pSnapshot->tokenLen > 0U ) )
+        {
+            pSnapshot = NULL;
+        }
+
+        if( pSnapshot != NULL )
+        {
+            pProcessing->pRetrySnapshot = NULL;
+        }
+
+        if( returnStatus == SigV4Success )
+        {
+            returnStatus = hashStreamedData( pProcessing,
+                                             pCanonicalContext->securityToken.pData,
+                                             pCanonicalContext->securityToken.dataLen );
+        }
+
+        if( pSnapshot != NULL )
+        {
+            pSnapshot->tokenOffset = pSnapshot->suffixLen;
+            pSnapshot->tokenLen = pCanonicalContext->securityToken.dataLen;
+            pProcessing->pRetrySnapshot = pSnapshot;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t startRetrySnapshot( CanonicalContext_t * pCanonicalContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4RetrySnapshot_t * pSnapshot = NULL;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+
+    assert( pCanonicalContext != NULL );
+
+    pSnapshot = pCanonicalContext->pRetrySnapshot;
+    pCryptoInterface = pCanonicalContext->processing.pCryptoInterface;
+
+    /* The snapshot is only saved once, at the first x-amz-date value. */
+    if( pSnapshot != NULL )
+    {
+        assert( ( pCryptoInterface != NULL ) && ( pCryptoInterface->hashCopyContext != NULL ) );
+
+        pCanonicalContext->pRetrySnapshot = NULL;
+        returnStatus = flushBuffer( &pCanonicalContext->processing );
+
+        if( returnStatus != SigV4Success )
+        {
+            /* The canonical request could not be hashed up to the date. */
+        }
+        else if( pCryptoInterface->hashCopyContext( pSnapshot->pHashContext,
+                                                    pCryptoInterface->pHashContext ) != 0 )
+        {
+            LogError( ( "Failed to save the canonical request hash state in the retry snapshot." ) );
+            returnStatus = SigV4HashError;
+        }
+        else
+        {
+            pSnapshot->suffixLen = 0U;
+            pSnapshot->tokenOffset = 0U;
+            pSnapshot->tokenLen = 0U;
+            pCanonicalContext->processing.pRetrySnapshot = pSnapshot;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void finishRetrySnapshot( const SigV4Parameters_t * pParams,
+                                 SigV4RetrySnapshot_t * pSnapshot )
+{
+    assert( ( pParams != NULL ) && ( pSnapshot != NULL ) );
+
+    /* A retry is signed with its new date in place of the saved one, so the
+     * saved one must be the date the request was signed with. */
+    if( ( pSnapshot->suffixLen <= SIGV4_ISO_STRING_LEN ) ||
+        ( strncmp( pSnapshot->pSuffix, pParams->pDateIso8601, SIGV4_ISO_STRING_LEN ) != 0 ) ||
+        ( pSnapshot->pSuffix[ SIGV4_ISO_STRING_LEN ] != LINEFEED_CHAR ) )
+    {
+        LogDebug( ( "Retry snapshot not saved: The x-amz-date header is not the date of the request." ) );
+        pSnapshot->suffixLen = 0U;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static const char * getFixedPayloadHash( const SigV4HttpParameters_t * pHttpParams,
+                                         size_t * pPayloadHashLen )
+{
+    const char * pPayloadHash = NULL;
+
+    assert( ( pHttpParams != NULL ) && ( pPayloadHashLen != NULL ) );
+
+    if( ( pHttpParams->flags & SIGV4_HTTP_PAYLOAD_IS_HASH ) != 0U )
+    {
+        pPayloadHash = pHttpParams->pPayload;
+        *pPayloadHashLen = pHttpParams->payloadLen;
+    }
+    else if( ( pHttpParams->flags & SIGV4_HTTP_PAYLOAD_IS_UNSIGNED ) != 0U )
+    {
+        pPayloadHash = SIGV4_UNSIGNED_PAYLOAD;
+        *pPayloadHashLen = UNSIGNED_PAYLOAD_LEN;
+    }
+
+    #ifdef EMPTY_PAYLOAD_HASH
+        else if( pHttpParams->payloadLen == 0U )
+        {
+            pPayloadHash = EMPTY_PAYLOAD_HASH;
+            *pPayloadHashLen = HEX_ENCODED_DIGEST_LEN;
+        }
+    #endif
+    else
+    {
+        /* The payload must be hashed. */
+    }
+
+    return pPayloadHash;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hashPayload( const SigV4Parameters_t * pParams,
+                                  char * pHexPayloadHash )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    uint8_t pDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+    SigV4PayloadHashCache_t * pCache = NULL;
+    const char * pCachedHash = NULL;
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) && ( pHexPayloadHash != NULL ) );
+
+    /* Only payloads whose contents the application identifies are cached. */
+    if( pParams->pHttpParameters->payloadGeneration != 0U )
+    {
+        pCache = pParams->pPayloadHashCache;
+    }
+
+    if( pCache != NULL )
+    {
+        pCachedHash = lookUpPayloadHash( pCache, pParams->pHttpParameters );
+    }
+
+    if( pCachedHash != NULL )
+    {
+        ( void ) memcpy( pHexPayloadHash, pCachedHash, HEX_ENCODED_DIGEST_LEN );
+    }
+    else
+    {
+        returnStatus = completeHash( pParams->pCryptoInterface,
+                                     ( const uint8_t * ) pParams->pHttpParameters->pPayload,
+                                     pParams->pHttpParameters->payloadLen,
+                                     pDigest );
+
+        if( returnStatus == SigV4Success )
+        {
+            lowercaseHexEncode( pDigest, SIGV4_HASH_DIGEST_LENGTH, pHexPayloadHash );
+        }
+
+        if( ( returnStatus == SigV4Success ) && ( pCache != NULL ) )
+        {
+            storePayloadHash( pCache, pParams->pHttpParameters, pHexPayloadHash );
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static const char * lookUpPayloadHash( SigV4PayloadHashCache_t * pCache,
+                                       const SigV4HttpParameters_t * pHttpParams )
+{
+    const char * pHexPayloadHash = NULL;
+    SigV4PayloadHashCacheEntry_t * pEntry = NULL;
+    size_t i = 0U;
+
+    assert( ( pCache != NULL ) && ( pHttpParams != NULL ) );
+    assert( pHttpParams->payloadGeneration != 0U );
+
+    for( i = 0U; ( i < SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT ) && ( pHexPayloadHash == NULL ); i++ )
+    {
+        pEntry = &pCache->pEntries[ i ];
+
+        if( ( pEntry->generation == pHttpParams->payloadGeneration ) &&
+            ( pEntry->pPayload == pHttpParams->pPayload ) &&
+            ( pEntry->payloadLen == pHttpParams->payloadLen ) )
+        {
+            pEntry->referenced = 1U;
+            pHexPayloadHash = pEntry->pHexPayloadHash;
+        }
+    }
+
+    if( pHexPayloadHash != NULL )
+    {
+        pCache->hitCount++;
+    }
+    else
+    {
+        pCache->missCount++;
+    }
+
+    return pHexPayloadHash;
+}
+
+/*-----------------------------------------------------------*/
+
+static void storePayloadHash( SigV4PayloadHashCache_t * pCache,
+                              const SigV4HttpParameters_t * pHttpParams,
+                              const char * pHexPayloadHash )
+{
+    SigV4PayloadHashCacheEntry_t * pEntry = NULL;
+
+    assert( ( pCache != NULL ) && ( pHttpParams != NULL ) && ( pHexPayloadHash != NULL ) );
+
+    if( pCache->clockHand >= SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT )
+    {
+        pCache->clockHand = 0U;
+    }
+
+    pEntry = &pCache->pEntries[ pCache->clockHand ];
+
+    /* Every used entry passed loses its second chance, so the hand stops
+     * within one sweep of the entries. */
+    while( pEntry->referenced == 1U )
+    {
+        pEntry->referenced = 0U;
+        pCache->clockHand = ( pCache->clockHand + 1U ) % SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT;
+        pEntry = &pCache->pEntries[ pCache->clockHand ];
+    }
+
+    if( pEntry->generation != 0U )
+    {
+        pCache->evictionCount++;
+    }
+
+    pEntry->pPayload = pHttpParams->pPayload;
+    pEntry->payloadLen = pHttpParams->payloadLen;
+    pEntry->generation = pHttpParams->payloadGeneration;
+    pEntry->referenced = 0U;
+    ( void ) memcpy( pEntry->pHexPayloadHash, pHexPayloadHash, HEX_ENCODED_DIGEST_LEN );
+    pCache->clockHand = ( pCache->clockHand + 1U ) % SIGV4_PAYLOAD_HASH_CACHE_ENTRY_COUNT;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hashPayloadsTogether( const SigV4CryptoInterface_t * pCryptoInterface,
+                                           const SigV4HttpParameters_t * pHttpParamsArray,
+                                           const SigV4Authorization_t * pAuthorizations,
+                                           size_t count,
+                                           char * pHexPayloadHashes )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const uint8_t * pInputs[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];
+    size_t pInputLens[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];
+    size_t pRequestIndices[ SIGV4_HASH_MULTIPLE_MAX_COUNT ];
+    uint8_t pDigests[ SIGV4_HASH_MULTIPLE_MAX_COUNT * SIGV4_HASH_DIGEST_LENGTH ];
+    size_t i = 0U, inputCount = 0U, payloadHashLen = 0U;
+
+    assert( ( pCryptoInterface != NULL ) && ( pCryptoInterface->hashMultiple != NULL ) );
+    assert( ( pHttpParamsArray != NULL ) && ( pAuthorizations != NULL ) && ( pHexPayloadHashes != NULL ) );
+    assert( count <= SIGV4_HASH_MULTIPLE_MAX_COUNT );
+
+    for( i = 0U; i < count; i++ )
+    {
+        /* A payload whose hash is already known is not hashed. */
+        if( ( pAuthorizations[ i ].status == SigV4Success ) &&
+            ( getFixedPayloadHash( &pHttpParamsArray[ i ], &payloadHashLen ) == NULL ) )
+        {
+            pInputs[ inputCount ] = ( const uint8_t * ) pHttpParamsArray[ i ].pPayload;
+            pInputLens[ inputCount ] = pHttpParamsArray[ i ].payloadLen;
+            pRequestIndices[ inputCount ] = i;
+            inputCount++;
+        }
+    }
+
+    if( ( inputCount > 0U ) &&
+        ( pCryptoInterface->hashMultiple( pCryptoInterface->pHashContext,
+                                          pInputs,
+                                          pInputLens,
+                                          pDigests,
+                                          inputCount ) != 0 ) )
+    {
+        LogError( ( "Failed to hash the payloads of the batch." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    for( i = 0U; ( i < inputCount ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        lowercaseHexEncode( &pDigests[ i * SIGV4_HASH_DIGEST_LENGTH ],
+                            SIGV4_HASH_DIGEST_LENGTH,
+                            &pHexPayloadHashes[ pRequestIndices[ i ] * HEX_ENCODED_DIGEST_LEN ] );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeCanonicalRequest( const SigV4Parameters_t * pParams,
+                                            CanonicalContext_t * pCanonicalContext,
+                                            SigV4Buffer_t * pAuthBuffer,
+                                            const char * pHexPayloadHash,
+                                            uint8_t * pDigest )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4HttpParameters_t * pHttpParams = NULL;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    SigV4Buffer_t * pProcessing = NULL;
+    char pComputedPayloadHash[ HEX_ENCODED_DIGEST_LEN ];
+    const char * pPayloadHash = NULL;
+    size_t payloadHashLen = HEX_ENCODED_DIGEST_LEN;
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) );
+    assert( ( pCanonicalContext != NULL ) && ( pDigest != NULL ) );
+
+    pHttpParams = pParams->pHttpParameters;
+    pCryptoInterface = pParams->pCryptoInterface;
+    pProcessing = &pCanonicalContext->processing;
+
+    pPayloadHash = getFixedPayloadHash( pHttpParams, &payloadHashLen );
+
+    if( pPayloadHash != NULL )
+    {
+        /* The payload is not hashed. */
+    }
+    else if( pHexPayloadHash != NULL )
+    {
+        pPayloadHash = pHexPayloadHash;
+        payloadHashLen = HEX_ENCODED_DIGEST_LEN;
+    }
+    else
+    {
+        returnStatus = hashPayload( pParams, pComputedPayloadHash );
+        pPayloadHash = pComputedPayloadHash;
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The payload hash is needed at the end of the canonical request. */
+    }
+    else if( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 )
+    {
+        LogError( ( "Failed to initialize the hash context." ) );
+        returnStatus = SigV4HashError;
+    }
+    else
+    {
+        pProcessing->pCryptoInterface = pCryptoInterface;
+        returnStatus = writeToBuffer( pProcessing, pHttpParams->pHttpMethod, pHttpParams->httpMethodLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCanonicalUri( pParams, pCanonicalContext );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeQueryString( pHttpParams, pCanonicalContext );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeHeaders( pHttpParams, pCanonicalContext, pAuthBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pProcessing, pPayloadHash, payloadHashLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = flushBuffer( pProcessing );
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                       pDigest,
+                                       SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to finalize the canonical request hash." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( pProcessing->pRetrySnapshot != NULL ) )
+    {
+        finishRetrySnapshot( pParams, pProcessing->pRetrySnapshot );
+    }
+
+    /* The processing buffer is reused for the string to sign. */
+    pProcessing->pCryptoInterface = NULL;
+    pProcessing->pRetrySnapshot = NULL;
+    pProcessing->dataLen = 0U;
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeAuthorizationPrefix( const SigV4Parameters_t * pParams,
+                                               SigV4Buffer_t * pAuthBuffer,
+                                               SigV4ConstString_t * pCredentialScope )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t scopeStart = 0U;
+
+    assert( ( pParams != NULL ) && ( pAuthBuffer != NULL ) && ( pCredentialScope != NULL ) );
+
+    returnStatus = writeToBuffer( pAuthBuffer, SIGV4_AWS4_HMAC_SHA256, sizeof( SIGV4_AWS4_HMAC_SHA256 ) - 1U );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pAuthBuffer, AUTH_CREDENTIAL_PREFIX, AUTH_CREDENTIAL_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pAuthBuffer, pParams->pCredentials->pAccessKeyId, pParams->pCredentials->accessKeyLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pAuthBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        scopeStart = pAuthBuffer->dataLen;
+        returnStatus = writeCredentialScope( pParams, pAuthBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        pCredentialScope->pData = &pAuthBuffer->pData[ scopeStart ];
+        pCredentialScope->dataLen = pAuthBuffer->dataLen - scopeStart;
+        returnStatus = writeToBuffer( pAuthBuffer, AUTH_SIGNED_HEADERS_PREFIX, AUTH_SIGNED_HEADERS_PREFIX_LEN );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeCredentialScope( const SigV4Parameters_t * pParams,
+                                           SigV4Buffer_t * pBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pParams != NULL ) && ( pBuffer != NULL ) );
+
+    returnStatus = writeToBuffer( pBuffer, pParams->pDateIso8601, ISO_DATE_SCOPE_LEN );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, pParams->pRegion, pParams->regionLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, pParams->pService, pParams->serviceLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pBuffer, SCOPE_SEPARATOR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, CREDENTIAL_SCOPE_TERMINATOR, CREDENTIAL_SCOPE_TERMINATOR_LEN );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeStringToSign( const SigV4Parameters_t * pParams,
+                                        CanonicalContext_t * pCanonicalContext,
+                                        const uint8_t * pCanonicalRequestDigest,
+                                        const SigV4ConstString_t * pCredentialScope )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Buffer_t * pProcessing = NULL;
+
+    assert( ( pParams != NULL ) && ( pCanonicalContext != NULL ) );
+    assert( pCanonicalRequestDigest != NULL );
+
+    pProcessing = &pCanonicalContext->processing;
+
+    returnStatus = writeToBuffer( pProcessing, SIGV4_AWS4_HMAC_SHA256, sizeof( SIGV4_AWS4_HMAC_SHA256 ) - 1U );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pProcessing, pParams->pDateIso8601, SIGV4_ISO_STRING_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( pCredentialScope == NULL ) )
+    {
+        returnStatus = writeCredentialScope( pParams, pProcessing );
+    }
+    else if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pProcessing, pCredentialScope->pData, pCredentialScope->dataLen );
+    }
+    else
+    {
+        /* The string to sign could not be written. */
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( HEX_ENCODED_DIGEST_LEN > ( pProcessing->bufferLen - pProcessing->dataLen ) ) )
+    {
+        LogError( ( "Insufficient memory for the hex-encoded canonical request hash." ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pCanonicalRequestDigest, SIGV4_HASH_DIGEST_LENGTH, &pProcessing->pData[ pProcessing->dataLen ] );
+        pProcessing->dataLen += HEX_ENCODED_DIGEST_LEN;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeSignature( const SigV4Parameters_t * pParams,
+                                     CanonicalContext_t * pCanonicalContext,
+                                     const uint8_t * pSigningKey,
+                                     const char * pSignaturePrefix,
+                                     size_t signaturePrefixLen,
+                                     SigV4Buffer_t * pAuthBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    uint8_t pMac[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    assert( ( pParams != NULL ) && ( pCanonicalContext != NULL ) && ( pAuthBuffer != NULL ) );
+
+    pCanonicalContext->hmac.pCryptoInterface = pParams->pCryptoInterface;
+
+    returnStatus = writeToBuffer( pAuthBuffer, pSignaturePrefix, signaturePrefixLen );
+
+    if( ( returnStatus == SigV4Success ) && ( HEX_ENCODED_DIGEST_LEN > ( pAuthBuffer->bufferLen - pAuthBuffer->dataLen ) ) )
+    {
+        LogError( ( "Insufficient memory for the signature in the Authorization buffer." ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+
+    /* Signature = HexEncode( HMAC( kSigning, StringToSign ) ) */
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) memcpy( pMac, pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+        returnStatus = hmacWithSigningKey( pParams->pSigningKeyCache,
+                                           &pCanonicalContext->hmac,
+                                           pMac,
+                                           pCanonicalContext->processing.pData,
+                                           pCanonicalContext->processing.dataLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pMac, SIGV4_HASH_DIGEST_LENGTH, &pAuthBuffer->pData[ pAuthBuffer->dataLen ] );
+        pAuthBuffer->dataLen += HEX_ENCODED_DIGEST_LEN;
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pMac, 0, sizeof( pMac ) );
+    ( void ) memset( pCanonicalContext->hmac.key, 0, sizeof( pCanonicalContext->hmac.key ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t generateAuthorization( const SigV4Parameters_t * pParams,
+                                            CanonicalContext_t * pCanonicalContext,
+                                            const uint8_t * pSigningKey,
+                                            AuthorizationPrefix_t * pPrefix,
+                                            const char * pHexPayloadHash,
+                                            SigV4Buffer_t * pAuthBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    uint8_t pCanonicalRequestDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    assert( ( pParams != NULL ) && ( pCanonicalContext != NULL ) );
+    assert( ( pSigningKey != NULL ) && ( pPrefix != NULL ) && ( pAuthBuffer != NULL ) );
+
+    pCanonicalContext->processing.pData = pCanonicalContext->pBufProcessing;
+    pCanonicalContext->processing.bufferLen = sizeof( pCanonicalContext->pBufProcessing );
+    pCanonicalContext->processing.dataLen = 0U;
+    pCanonicalContext->processing.pCryptoInterface = NULL;
+    pCanonicalContext->processing.pRetrySnapshot = NULL;
+    pCanonicalContext->securityToken.pData = pParams->pCredentials->pSecurityToken;
+    pCanonicalContext->securityToken.dataLen = ( pParams->pCredentials->pSecurityToken != NULL ) ? pParams->pCredentials->securityTokenLen : 0U;
+    pCanonicalContext->hmac.pCryptoInterface = pParams->pCryptoInterface;
+
+    if( pPrefix->value.pData == NULL )
+    {
+        returnStatus = writeAuthorizationPrefix( pParams, pAuthBuffer, &pPrefix->credentialScope );
+
+        if( returnStatus == SigV4Success )
+        {
+            pPrefix->value.pData = pAuthBuffer->pData;
+            pPrefix->value.dataLen = pAuthBuffer->dataLen;
+        }
+    }
+    else
+    {
+        returnStatus = writeToBuffer( pAuthBuffer, pPrefix->value.pData, pPrefix->value.dataLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCanonicalRequest( pParams,
+                                              pCanonicalContext,
+                                              pAuthBuffer,
+                                              pHexPayloadHash,
+                                              pCanonicalRequestDigest );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeStringToSign( pParams,
+                                          pCanonicalContext,
+                                          pCanonicalRequestDigest,
+                                          &pPrefix->credentialScope );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeSignature( pParams,
+                                       pCanonicalContext,
+                                       pSigningKey,
+                                       AUTH_SIGNATURE_PREFIX,
+                                       AUTH_SIGNATURE_PREFIX_LEN,
+                                       pAuthBuffer );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t resignAuthorization( const SigV4Parameters_t * pParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          const uint8_t * pSigningKey,
+                                          SigV4Buffer_t * pAuthBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4RetrySnapshot_t * pSnapshot = NULL;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    SigV4ConstString_t credentialScope = { 0 }, token = { 0 };
+    uint8_t pCanonicalRequestDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+    size_t signedHeadersStart = 0U, signedHeadersEnd = 0U, tokenOffset = 0U;
+
+    assert( ( pParams != NULL ) && ( pParams->pRetrySnapshot != NULL ) && ( pCanonicalContext != NULL ) );
+    assert( ( pSigningKey != NULL ) && ( pAuthBuffer != NULL ) );
+
+    pSnapshot = pParams->pRetrySnapshot;
+    pCryptoInterface = pParams->pCryptoInterface;
+
+    pCanonicalContext->processing.pData = pCanonicalContext->pBufProcessing;
+    pCanonicalContext->processing.bufferLen = sizeof( pCanonicalContext->pBufProcessing );
+    pCanonicalContext->processing.dataLen = 0U;
+    pCanonicalContext->processing.pCryptoInterface = NULL;
+    pCanonicalContext->processing.pRetrySnapshot = NULL;
+    pCanonicalContext->hmac.pCryptoInterface = pCryptoInterface;
+
+    /* The suffix ends with the signed headers and the payload hash, each
+     * preceded by a linefeed. */
+    signedHeadersEnd = pSnapshot->suffixLen - 1U;
+
+    while( pSnapshot->pSuffix[ signedHeadersEnd ] != LINEFEED_CHAR )
+    {
+        signedHeadersEnd--;
+    }
+
+    signedHeadersStart = signedHeadersEnd;
+
+    while( ( signedHeadersStart > ( SIGV4_ISO_STRING_LEN + 1U ) ) &&
+           ( pSnapshot->pSuffix[ signedHeadersStart - 1U ] != LINEFEED_CHAR ) )
+    {
+        signedHeadersStart--;
+    }
+
+    returnStatus = writeAuthorizationPrefix( pParams, pAuthBuffer, &credentialScope );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pAuthBuffer,
+                                      &pSnapshot->pSuffix[ signedHeadersStart ],
+                                      signedHeadersEnd - signedHeadersStart );
+    }
+
+    /* The new date replaces the saved one in the canonical request, and the
+     * security token of the retry is hashed where the saved one was left
+     * out. */
+    tokenOffset = ( pSnapshot->tokenLen > 0U ) ? pSnapshot->tokenOffset : pSnapshot->suffixLen;
+
+    if( pSnapshot->tokenLen > 0U )
+    {
+        token.pData = pParams->pCredentials->pSecurityToken;
+        token.dataLen = pParams->pCredentials->securityTokenLen;
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( ( pCryptoInterface->hashCopyContext( pCryptoInterface->pHashContext,
+                                               pSnapshot->pHashContext ) != 0 ) ||
+          ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                          ( const uint8_t * ) pParams->pDateIso8601,
+                                          SIGV4_ISO_STRING_LEN ) != 0 ) ||
+          ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                          ( const uint8_t * ) &pSnapshot->pSuffix[ SIGV4_ISO_STRING_LEN ],
+                                          tokenOffset - SIGV4_ISO_STRING_LEN ) != 0 ) ||
+          ( ( token.dataLen > 0U ) &&
+            ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                            ( const uint8_t * ) token.pData,
+                                            token.dataLen ) != 0 ) ) ||
+          ( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                          ( const uint8_t * ) &pSnapshot->pSuffix[ tokenOffset ],
+                                          pSnapshot->suffixLen - tokenOffset ) != 0 ) ||
+          ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                         pCanonicalRequestDigest,
+                                         SIGV4_HASH_DIGEST_LENGTH ) != 0 ) ) )
+    {
+        LogError( ( "Failed to hash the canonical request from the retry snapshot." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeStringToSign( pParams,
+                                          pCanonicalContext,
+                                          pCanonicalRequestDigest,
+                                          &credentialScope );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeSignature( pParams,
+                                       pCanonicalContext,
+                                       pSigningKey,
+                                       AUTH_SIGNATURE_PREFIX,
+                                       AUTH_SIGNATURE_PREFIX_LEN,
+                                       pAuthBuffer );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t findPresignedQuerySplit( const char * pQuery,
+                                              size_t queryLen,
+                                              size_t * pSplit )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t start = 0U, nameEnd = 0U, compareLen = 0U;
+    int32_t order = -1;
+
+    assert( ( ( pQuery != NULL ) || ( queryLen == 0U ) ) && ( pSplit != NULL ) );
+
+    /* The canonical query is sorted by name, and every name that does not
+     * start with "X-Amz-" sorts either before or after all of them. */
+    while( ( start < queryLen ) && ( order < 0 ) && ( returnStatus == SigV4Success ) )
+    {
+        nameEnd = start;
+
+        while( ( nameEnd < queryLen ) && ( pQuery[ nameEnd ] != QUERY_VALUE_SEPARATOR ) &&
+               ( pQuery[ nameEnd ] != QUERY_PAIR_SEPARATOR ) )
+        {
+            nameEnd++;
+        }
+
+        compareLen = nameEnd - start;
+
+        if( compareLen > PRESIGNED_PARAM_PREFIX_LEN )
+        {
+            compareLen = PRESIGNED_PARAM_PREFIX_LEN;
+        }
+
+        order = ( int32_t ) strncmp( &pQuery[ start ], PRESIGNED_PARAM_PREFIX, compareLen );
+
+        if( ( order == 0 ) && ( compareLen == PRESIGNED_PARAM_PREFIX_LEN ) )
+        {
+            LogError( ( "Invalid query: \"%.*s\" is an X-Amz- parameter of the presigned URL.",
+                        ( int ) ( nameEnd - start ), &pQuery[ start ] ) );
+            returnStatus = SigV4InvalidParameter;
+        }
+        /* A name that is a proper prefix of "X-Amz-" sorts before it. */
+        else if( order <= 0 )
+        {
+            order = -1;
+            start = nameEnd;
+
+            while( ( start < queryLen ) && ( pQuery[ start ] != QUERY_PAIR_SEPARATOR ) )
+            {
+                start++;
+            }
+
+            start = ( start < queryLen ) ? ( start + 1U ) : queryLen;
+        }
+        else
+        {
+            /* This parameter and the ones after it follow the X-Amz- ones. */
+        }
+    }
+
+    *pSplit = start;
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writeExpires( SigV4Buffer_t * pBuffer,
+                                   uint32_t expiresSeconds )
+{
+    char pDigits[ PRESIGNED_EXPIRES_MAX_DIGITS ];
+    char * pDigitsEnd = pDigits;
+    size_t digitCount = 1U;
+    uint32_t remaining = expiresSeconds / 10U;
+
+    assert( ( pBuffer != NULL ) && ( expiresSeconds <= SIGV4_PRESIGNED_URL_EXPIRES_MAX ) );
+
+    while( remaining > 0U )
+    {
+        digitCount++;
+        remaining /= 10U;
+    }
+
+    intToAscii( ( int32_t ) expiresSeconds, &pDigitsEnd, digitCount );
+
+    return writeToBuffer( pBuffer, pDigits, digitCount );
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writePresignedCredential( const SigV4Parameters_t * pParams,
+                                               SigV4Buffer_t * pBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pParams != NULL ) && ( pBuffer != NULL ) );
+
+    returnStatus = writeEncodedData( pBuffer,
+                                     pParams->pCredentials->pAccessKeyId,
+                                     pParams->pCredentials->accessKeyLen,
+                                     1U,
+                                     0U );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, SCOPE_SEPARATOR_ENCODED, URI_ENCODED_OCTET_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, pParams->pDateIso8601, ISO_DATE_SCOPE_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, SCOPE_SEPARATOR_ENCODED, URI_ENCODED_OCTET_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeEncodedData( pBuffer, pParams->pRegion, pParams->regionLen, 1U, 0U );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, SCOPE_SEPARATOR_ENCODED, URI_ENCODED_OCTET_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeEncodedData( pBuffer, pParams->pService, pParams->serviceLen, 1U, 0U );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, SCOPE_SEPARATOR_ENCODED, URI_ENCODED_OCTET_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pBuffer, CREDENTIAL_SCOPE_TERMINATOR, CREDENTIAL_SCOPE_TERMINATOR_LEN );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writePresignedSecurityToken( const SigV4Parameters_t * pParams,
+                                                  SigV4Buffer_t * pBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4Credentials_t * pCredentials = NULL;
+
+    assert( ( pParams != NULL ) && ( pParams->pCredentials != NULL ) && ( pBuffer != NULL ) );
+
+    pCredentials = pParams->pCredentials;
+
+    if( ( pCredentials->pSecurityToken != NULL ) && ( pCredentials->securityTokenLen > 0U ) )
+    {
+        returnStatus = writeToBuffer( pBuffer, PRESIGNED_TOKEN_PREFIX, PRESIGNED_TOKEN_PREFIX_LEN );
+
+        /* Security tokens are base64-encoded, so '+', '/' and '=' must be
+         * URI-encoded. */
+        if( returnStatus == SigV4Success )
+        {
+            returnStatus = writeEncodedData( pBuffer,
+                                             pCredentials->pSecurityToken,
+                                             pCredentials->securityTokenLen,
+                                             1U,
+                                             0U );
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t writePresignedQuery( const SigV4Parameters_t * pParams,
+                                          CanonicalContext_t * pCanonicalContext,
+                                          uint32_t expiresSeconds,
+                                          SigV4Buffer_t * pQueryBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4HttpParameters_t * pHttpParams = NULL;
+    size_t split = 0U, precedingLen = 0U;
+    uint8_t isCanonical = 0U;
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) );
+    assert( ( pCanonicalContext != NULL ) && ( pQueryBuffer != NULL ) );
+
+    pHttpParams = pParams->pHttpParameters;
+
+    returnStatus = findPresignedQuerySplit( pHttpParams->pQuery, pHttpParams->queryLen, &split );
+
+    /* The parameters that sort before the X-Amz- ones are written first,
+     * without the separator that follows them. */
+    precedingLen = split;
+
+    if( ( precedingLen > 0U ) && ( pHttpParams->pQuery[ precedingLen - 1U ] == QUERY_PAIR_SEPARATOR ) )
+    {
+        precedingLen--;
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( precedingLen > 0U ) )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, pHttpParams->pQuery, precedingLen );
+
+        if( returnStatus == SigV4Success )
+        {
+            returnStatus = writeCharToBuffer( pQueryBuffer, QUERY_PAIR_SEPARATOR );
+        }
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, PRESIGNED_CREDENTIAL_PREFIX, PRESIGNED_CREDENTIAL_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writePresignedCredential( pParams, pQueryBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, PRESIGNED_DATE_PREFIX, PRESIGNED_DATE_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, pParams->pDateIso8601, SIGV4_ISO_STRING_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, PRESIGNED_EXPIRES_PREFIX, PRESIGNED_EXPIRES_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeExpires( pQueryBuffer, expiresSeconds );
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( ( pHttpParams->flags & SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED ) == 0U ) )
+    {
+        returnStatus = writePresignedSecurityToken( pParams, pQueryBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = parseRequestHeaders( pHttpParams, pCanonicalContext, &isCanonical );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, PRESIGNED_HEADERS_PREFIX, PRESIGNED_HEADERS_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeSignedHeaders( pCanonicalContext, pQueryBuffer, 1U );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( split < pHttpParams->queryLen ) )
+    {
+        returnStatus = writeCharToBuffer( pQueryBuffer, QUERY_PAIR_SEPARATOR );
+
+        if( returnStatus == SigV4Success )
+        {
+            returnStatus = writeToBuffer( pQueryBuffer,
+                                          &pHttpParams->pQuery[ split ],
+                                          pHttpParams->queryLen - split );
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t generatePresignedUrl( const SigV4Parameters_t * pParams,
+                                           CanonicalContext_t * pCanonicalContext,
+                                           const uint8_t * pSigningKey,
+                                           uint32_t expiresSeconds,
+                                           SigV4Buffer_t * pQueryBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Parameters_t presignedParams;
+    SigV4HttpParameters_t presignedHttpParams;
+    uint8_t pCanonicalRequestDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    assert( ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) && ( pCanonicalContext != NULL ) );
+    assert( ( pSigningKey != NULL ) && ( pQueryBuffer != NULL ) );
+
+    pCanonicalContext->processing.pData = pCanonicalContext->pBufProcessing;
+    pCanonicalContext->processing.bufferLen = sizeof( pCanonicalContext->pBufProcessing );
+    pCanonicalContext->processing.dataLen = 0U;
+    pCanonicalContext->processing.pCryptoInterface = NULL;
+    pCanonicalContext->processing.pRetrySnapshot = NULL;
+    pCanonicalContext->securityToken.pData = pParams->pCredentials->pSecurityToken;
+    pCanonicalContext->securityToken.dataLen = ( pParams->pCredentials->pSecurityToken != NULL ) ? pParams->pCredentials->securityTokenLen : 0U;
+    pCanonicalContext->hmac.pCryptoInterface = pParams->pCryptoInterface;
+
+    returnStatus = writePresignedQuery( pParams, pCanonicalContext, expiresSeconds, pQueryBuffer );
+
+    /* The query string written so far is the canonical query, so it is
+     * signed from the output buffer as is. */
+    if( returnStatus == SigV4Success )
+    {
+        presignedHttpParams = *pParams->pHttpParameters;
+        presignedHttpParams.pQuery = pQueryBuffer->pData;
+        presignedHttpParams.queryLen = pQueryBuffer->dataLen;
+        presignedHttpParams.flags |= SIGV4_HTTP_QUERY_IS_CANONICAL_FLAG;
+
+        presignedParams = *pParams;
+        presignedParams.pHttpParameters = &presignedHttpParams;
+
+        returnStatus = writeCanonicalRequest( &presignedParams,
+                                              pCanonicalContext,
+                                              NULL,
+                                              NULL,
+                                              pCanonicalRequestDigest );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeStringToSign( pParams, pCanonicalContext, pCanonicalRequestDigest, NULL );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeSignature( pParams,
+                                       pCanonicalContext,
+                                       pSigningKey,
+                                       PRESIGNED_SIGNATURE_PREFIX,
+                                       PRESIGNED_SIGNATURE_PREFIX_LEN,
+                                       pQueryBuffer );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t findPresignedWindow( const SigV4PresignPool_t * pPool,
+                                     uint32_t published,
+                                     uint64_t windowStart )
+{
+    uint32_t slot = PRESIGN_POOL_CURRENT_SLOT( published );
+
+    assert( pPool != NULL );
+
+    if( ( slot == 0U ) || ( pPool->pWindows[ slot - 1U ].windowStart != windowStart ) )
+    {
+        slot = PRESIGN_POOL_NEXT_SLOT( published );
+    }
+
+    if( ( slot != 0U ) && ( pPool->pWindows[ slot - 1U ].windowStart != windowStart ) )
+    {
+        slot = 0U;
+    }
+
+    return slot;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint32_t findSparePresignSlot( uint32_t published,
+                                      uint32_t excludedSlot )
+{
+    uint32_t slot = 1U, spareSlot = 0U;
+
+    while( ( slot <= SIGV4_PRESIGN_POOL_SLOT_COUNT ) && ( spareSlot == 0U ) )
+    {
+        if( ( slot != PRESIGN_POOL_CURRENT_SLOT( published ) ) &&
+            ( slot != PRESIGN_POOL_NEXT_SLOT( published ) ) &&
+            ( slot != excludedSlot ) )
+        {
+            spareSlot = slot;
+        }
+
+        slot++;
+    }
+
+    return spareSlot;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t presignWindow( SigV4PresignPool_t * pPool,
+                                    const SigV4Parameters_t * pParams,
+                                    uint32_t slot,
+                                    uint64_t windowStart )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Parameters_t windowParams;
+    SigV4PresignedWindow_t * pWindow = NULL;
+    SigV4DateTime_t windowDate;
+    char pWindowDate[ SIGV4_ISO_STRING_LEN ];
+    char * pSignature = NULL;
+    size_t signatureLen = 0U;
+
+    assert( ( pPool != NULL ) && ( pParams != NULL ) );
+    assert( ( slot > 0U ) && ( slot <= SIGV4_PRESIGN_POOL_SLOT_COUNT ) );
+
+    pWindow = &pPool->pWindows[ slot - 1U ];
+
+    epochToDateTime( windowStart, &windowDate );
+    writeIso8601( &windowDate, pWindowDate );
+
+    windowParams = *pParams;
+    windowParams.pDateIso8601 = pWindowDate;
+
+    pWindow->queryLen = sizeof( pWindow->pQuery );
+    returnStatus = SigV4_GeneratePresignedUrl( &windowParams,
+                                               pPool->windowSeconds * PRESIGN_POOL_URL_WINDOWS,
+                                               pWindow->pQuery,
+                                               &pWindow->queryLen,
+                                               &pSignature,
+                                               &signatureLen );
+
+    if( returnStatus == SigV4Success )
+    {
+        pWindow->windowStart = windowStart;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t copyCredentialString( SigV4Buffer_t * pBuffer,
+                                           const char * pString,
+                                           size_t stringLen,
+                                           const char ** pCopy,
+                                           size_t * pCopyLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    assert( ( pBuffer != NULL ) && ( pCopy != NULL ) && ( pCopyLen != NULL ) );
+
+    *pCopy = NULL;
+    *pCopyLen = 0U;
+
+    if( ( pString != NULL ) && ( stringLen > 0U ) )
+    {
+        returnStatus = writeToBuffer( pBuffer, pString, stringLen );
+
+        if( returnStatus == SigV4Success )
+        {
+            *pCopy = &pBuffer->pData[ pBuffer->dataLen - stringLen ];
+            *pCopyLen = stringLen;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t copyCredentials( SigV4CredentialSlot_t * pSlot,
+                                      const SigV4Credentials_t * pCredentials )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    SigV4Credentials_t * pCopy = NULL;
+    SigV4Buffer_t buffer = { 0 };
+
+    assert( ( pSlot != NULL ) && ( pCredentials != NULL ) );
+
+    pCopy = &pSlot->credentials;
+    buffer.pData = pSlot->pData;
+    buffer.bufferLen = sizeof( pSlot->pData );
+
+    /* Do not leave the secret key of earlier credentials in the slot. */
+    ( void ) memset( pSlot->pData, 0, sizeof( pSlot->pData ) );
+
+    returnStatus = copyCredentialString( &buffer,
+                                         pCredentials->pAccessKeyId,
+                                         pCredentials->accessKeyLen,
+                                         &pCopy->pAccessKeyId,
+                                         &pCopy->accessKeyLen );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = copyCredentialString( &buffer,
+                                             pCredentials->pSecretAccessKey,
+                                             pCredentials->secretAccessKeyLen,
+                                             &pCopy->pSecretAccessKey,
+                                             &pCopy->secretAccessKeyLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = copyCredentialString( &buffer,
+                                             pCredentials->pSecurityToken,
+                                             pCredentials->securityTokenLen,
+                                             &pCopy->pSecurityToken,
+                                             &pCopy->securityTokenLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = copyCredentialString( &buffer,
+                                             pCredentials->pExpiration,
+                                             pCredentials->expirationLen,
+                                             &pCopy->pExpiration,
+                                             &pCopy->expirationLen );
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        LogError( ( "The credentials do not fit in SIGV4_CREDENTIAL_STORE_SLOT_LENGTH=%lu bytes.",
+                    ( unsigned long ) SIGV4_CREDENTIAL_STORE_SLOT_LENGTH ) );
+        ( void ) memset( pSlot->pData, 0, sizeof( pSlot->pData ) );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t compilePresignTemplate( SigV4PresignTemplate_t * pTemplate,
+                                             const SigV4Parameters_t * pParams,
+                                             CanonicalContext_t * pCanonicalContext,
+                                             uint32_t expiresSeconds )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4HttpParameters_t * pHttpParams = NULL;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    SigV4Buffer_t * pProcessing = NULL;
+    uint8_t pPlaceholderDigest[ SIGV4_HASH_DIGEST_LENGTH ] = { 0 };
+    char pComputedPayloadHash[ HEX_ENCODED_DIGEST_LEN ];
+    const char * pPayloadHash = NULL;
+    size_t payloadHashLen = HEX_ENCODED_DIGEST_LEN, prefixLen = 0U, queryStart = 0U;
+
+    assert( ( pTemplate != NULL ) && ( pParams != NULL ) && ( pParams->pHttpParameters != NULL ) );
+    assert( pCanonicalContext != NULL );
+
+    pHttpParams = pParams->pHttpParameters;
+    pCryptoInterface = pParams->pCryptoInterface;
+    pProcessing = &pCanonicalContext->processing;
+
+    /* The payload is hashed before the hash context holds the canonical
+     * request. */
+    pPayloadHash = getFixedPayloadHash( pHttpParams, &payloadHashLen );
+
+    if( pPayloadHash == NULL )
+    {
+        returnStatus = hashPayload( pParams, pComputedPayloadHash );
+        pPayloadHash = pComputedPayloadHash;
+    }
+
+    /* The string to sign is written with a placeholder digest, which checks
+     * that the digest of each URL fits after its start. */
+    if( returnStatus == SigV4Success )
+    {
+        pProcessing->pData = pCanonicalContext->pBufProcessing;
+        pProcessing->bufferLen = sizeof( pCanonicalContext->pBufProcessing );
+        pProcessing->dataLen = 0U;
+        pProcessing->pCryptoInterface = NULL;
+        pProcessing->pRetrySnapshot = NULL;
+        pCanonicalContext->securityToken.pData = pParams->pCredentials->pSecurityToken;
+        pCanonicalContext->securityToken.dataLen = ( pParams->pCredentials->pSecurityToken != NULL ) ? pParams->pCredentials->securityTokenLen : 0U;
+        returnStatus = writeStringToSign( pParams, pCanonicalContext, pPlaceholderDigest, NULL );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        prefixLen = pProcessing->dataLen - HEX_ENCODED_DIGEST_LEN;
+        pProcessing->pData = pTemplate->pData;
+        pProcessing->bufferLen = sizeof( pTemplate->pData );
+        pProcessing->dataLen = 0U;
+        returnStatus = writeToBuffer( pProcessing, pCanonicalContext->pBufProcessing, prefixLen );
+    }
+
+    /* The canonical request after the path holds the query string of the
+     * URLs, without their signature. */
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+        queryStart = pProcessing->dataLen;
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writePresignedQuery( pParams, pCanonicalContext, expiresSeconds, pProcessing );
+        pTemplate->queryLen = pProcessing->dataLen - queryStart;
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeHeaders( pHttpParams, pCanonicalContext, NULL );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pProcessing, pPayloadHash, payloadHashLen );
+        pTemplate->canonicalSuffixLen = pProcessing->dataLen - prefixLen;
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( ( pHttpParams->flags & SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED ) != 0U ) )
+    {
+        returnStatus = writePresignedSecurityToken( pParams, pProcessing );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        pTemplate->stringToSignPrefixLen = prefixLen;
+        pTemplate->unsignedTokenLen = pProcessing->dataLen - prefixLen - pTemplate->canonicalSuffixLen;
+    }
+
+    /* The canonical request is hashed up to the end of the path prefix. */
+    if( ( returnStatus == SigV4Success ) && ( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 ) )
+    {
+        LogError( ( "Failed to initialize the hash context." ) );
+        returnStatus = SigV4HashError;
+    }
+    else if( returnStatus == SigV4Success )
+    {
+        pProcessing->pData = pCanonicalContext->pBufProcessing;
+        pProcessing->bufferLen = sizeof( pCanonicalContext->pBufProcessing );
+        pProcessing->dataLen = 0U;
+        pProcessing->pCryptoInterface = pCryptoInterface;
+        returnStatus = writeToBuffer( pProcessing, pHttpParams->pHttpMethod, pHttpParams->httpMethodLen );
+    }
+    else
+    {
+        /* The template could not be written. */
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( pProcessing, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCanonicalUri( pParams, pCanonicalContext );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = flushBuffer( pProcessing );
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( pCryptoInterface->hashCopyContext( pTemplate->pHashContext, pCryptoInterface->pHashContext ) != 0 ) )
+    {
+        LogError( ( "Failed to save the canonical request hash state in the presign template." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    pProcessing->pCryptoInterface = NULL;
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t signTemplateKey( const SigV4PresignTemplate_t * pTemplate,
+                                      const char * pKey,
+                                      size_t keyLen,
+                                      SigV4Buffer_t * pQueryBuffer )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    SigV4Buffer_t processing = { 0 };
+    HmacContext_t hmac;
+    char pBufProcessing[ SIGV4_PROCESSING_BUFFER_LENGTH ];
+    uint8_t pDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+    uint8_t pMac[ SIGV4_HASH_DIGEST_LENGTH ];
+    size_t prefixLen = 0U;
+
+    assert( ( pTemplate != NULL ) && ( pTemplate->pCryptoInterface != NULL ) );
+    assert( ( ( pKey != NULL ) || ( keyLen == 0U ) ) && ( pQueryBuffer != NULL ) );
+
+    pCryptoInterface = pTemplate->pCryptoInterface;
+    prefixLen = pTemplate->stringToSignPrefixLen;
+    processing.pData = pBufProcessing;
+    processing.bufferLen = sizeof( pBufProcessing );
+    processing.pCryptoInterface = pCryptoInterface;
+
+    /* The canonical request continues from the saved state with the key,
+     * then the rest of the request, which is the same for every key. */
+    if( pCryptoInterface->hashCopyContext( pCryptoInterface->pHashContext, pTemplate->pHashContext ) != 0 )
+    {
+        LogError( ( "Failed to restore the canonical request hash state of the presign template." ) );
+        returnStatus = SigV4HashError;
+    }
+    else
+    {
+        returnStatus = writePath( &processing, pKey, keyLen, pTemplate->keyEncoding );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &processing, &pTemplate->pData[ prefixLen ], pTemplate->canonicalSuffixLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = flushBuffer( &processing );
+    }
+
+    if( ( returnStatus == SigV4Success ) &&
+        ( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                       pDigest,
+                                       SIGV4_HASH_DIGEST_LENGTH ) != 0 ) )
+    {
+        LogError( ( "Failed to finalize the canonical request hash." ) );
+        returnStatus = SigV4HashError;
+    }
+
+    /* The query string is the one of the template, followed by the
+     * signature. */
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, &pTemplate->pData[ prefixLen + 1U ], pTemplate->queryLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( pQueryBuffer, PRESIGNED_SIGNATURE_PREFIX, PRESIGNED_SIGNATURE_PREFIX_LEN );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( HEX_ENCODED_DIGEST_LEN > ( pQueryBuffer->bufferLen - pQueryBuffer->dataLen ) ) )
+    {
+        LogError( ( "Insufficient memory for the signature in the query buffer." ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+
+    /* The template was compiled with room for the digest after the start of
+     * the string to sign. */
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) memcpy( pBufProcessing, pTemplate->pData, prefixLen );
+        lowercaseHexEncode( pDigest, SIGV4_HASH_DIGEST_LENGTH, &pBufProcessing[ prefixLen ] );
+
+        hmac.pCryptoInterface = pCryptoInterface;
+        ( void ) memcpy( pMac, pTemplate->signingKey.pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+        returnStatus = hmacWithSigningKey( &pTemplate->signingKey,
+                                           &hmac,
+                                           pMac,
+                                           pBufProcessing,
+                                           prefixLen + HEX_ENCODED_DIGEST_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pMac, SIGV4_HASH_DIGEST_LENGTH, &pQueryBuffer->pData[ pQueryBuffer->dataLen ] );
+        pQueryBuffer->dataLen += HEX_ENCODED_DIGEST_LEN;
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pMac, 0, sizeof( pMac ) );
+    ( void ) memset( hmac.key, 0, sizeof( hmac.key ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t signChainLink( const SigV4Parameters_t * pParams,
+                                    const uint8_t * pSigningKey,
+                                    char * pPreviousSignature,
+                                    const char * pHexHeadersHash,
+                                    const char * pHexPayloadHash,
+                                    uint8_t * pSignature )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    HmacContext_t hmac;
+    char pBufStringToSign[ SIGV4_HASH_MAX_BLOCK_LENGTH ];
+    SigV4Buffer_t stringToSign = { 0 };
+
+    assert( ( pParams != NULL ) && ( pSigningKey != NULL ) && ( pPreviousSignature != NULL ) );
+    assert( ( pHexHeadersHash != NULL ) && ( pHexPayloadHash != NULL ) && ( pSignature != NULL ) );
+
+    hmac.pCryptoInterface = pParams->pCryptoInterface;
+    stringToSign.pData = pBufStringToSign;
+    stringToSign.bufferLen = sizeof( pBufStringToSign );
+    stringToSign.pCryptoInterface = pParams->pCryptoInterface;
+
+    /* Signature = HMAC( kSigning, "AWS4-HMAC-SHA256-PAYLOAD" + "\n" + Date +
+     * "\n" + Scope + "\n" + PreviousSignature + "\n" + Hash( Headers ) +
+     * "\n" + Hash( Payload ) ), where the headers of a chunk are empty. */
+    returnStatus = hmacInit( &hmac, NULL, 0U, pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &stringToSign, CHUNK_STRING_TO_SIGN_PREFIX, CHUNK_STRING_TO_SIGN_PREFIX_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &stringToSign, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &stringToSign, pParams->pDateIso8601, SIGV4_ISO_STRING_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &stringToSign, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCredentialScope( pParams, &stringToSign );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &stringToSign, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &stringToSign, pPreviousSignature, HEX_ENCODED_DIGEST_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &stringToSign, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &stringToSign, pHexHeadersHash, HEX_ENCODED_DIGEST_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeCharToBuffer( &stringToSign, LINEFEED_CHAR );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = writeToBuffer( &stringToSign, pHexPayloadHash, HEX_ENCODED_DIGEST_LEN );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = flushBuffer( &stringToSign );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = hmacFinal( &hmac, pSignature );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pSignature, SIGV4_HASH_DIGEST_LENGTH, pPreviousSignature );
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( hmac.key, 0, sizeof( hmac.key ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void writeEventHeaders( uint64_t eventTime,
+                               uint8_t * pHeaderBuf )
+{
+    uint64_t timestamp = eventTime * MILLISECONDS_PER_SECOND;
+    size_t i = 0U, offset = 0U;
+
+    assert( pHeaderBuf != NULL );
+
+    /* Each header is its name length byte, its name, its value type byte,
+     * and its value. The timestamp is a big-endian count of milliseconds. */
+    pHeaderBuf[ offset ] = ( uint8_t ) EVENT_DATE_HEADER_NAME_LEN;
+    offset++;
+    ( void ) memcpy( &pHeaderBuf[ offset ], EVENT_DATE_HEADER_NAME, EVENT_DATE_HEADER_NAME_LEN );
+    offset += EVENT_DATE_HEADER_NAME_LEN;
+    pHeaderBuf[ offset ] = ( uint8_t ) EVENT_HEADER_TYPE_TIMESTAMP;
+    offset++;
+
+    for( i = 0U; i < 8U; i++ )
+    {
+        pHeaderBuf[ offset + 7U - i ] = ( uint8_t ) ( timestamp & 0xFFU );
+        timestamp >>= 8;
+    }
+
+    offset += 8U;
+
+    /* A byte array value is preceded by its big-endian 16-bit length. */
+    pHeaderBuf[ offset ] = ( uint8_t ) EVENT_SIGNATURE_HEADER_NAME_LEN;
+    offset++;
+    ( void ) memcpy( &pHeaderBuf[ offset ], EVENT_SIGNATURE_HEADER_NAME, EVENT_SIGNATURE_HEADER_NAME_LEN );
+    offset += EVENT_SIGNATURE_HEADER_NAME_LEN;
+    pHeaderBuf[ offset ] = ( uint8_t ) EVENT_HEADER_TYPE_BYTE_ARRAY;
+    pHeaderBuf[ offset + 1U ] = ( uint8_t ) ( SIGV4_HASH_DIGEST_LENGTH >> 8 );
+    pHeaderBuf[ offset + 2U ] = ( uint8_t ) ( SIGV4_HASH_DIGEST_LENGTH & 0xFFU );
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t signChunkAndWriteHeader( SigV4ChunkSigner_t * pSigner,
+                                              const char * pHexChunkHash,
+                                              size_t chunkLen,
+                                              char * pHeaderBuf,
+                                              size_t * pHeaderBufLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t digitCount = 0U, headerLen = 0U;
+    uint8_t pSignature[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    assert( ( pSigner != NULL ) && ( pSigner->pParams != NULL ) && ( pHexChunkHash != NULL ) );
+    assert( ( pHeaderBuf != NULL ) && ( pHeaderBufLen != NULL ) );
+
+    digitCount = getChunkSizeDigits( chunkLen );
+    headerLen = digitCount + CHUNK_SIGNATURE_PREFIX_LEN + HEX_ENCODED_DIGEST_LEN + CHUNK_LINE_TERMINATOR_LEN;
+
+    /* The space is checked first, as the chain cannot be rolled back once the
+     * chunk is signed. */
+    if( *pHeaderBufLen < headerLen )
+    {
+        LogError( ( "Insufficient memory for the chunk header: %lu bytes are needed.",
+                    ( unsigned long ) headerLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        returnStatus = signChainLink( pSigner->pParams,
+                                      pSigner->pSigningKey,
+                                      pSigner->pPreviousSignature,
+                                      pSigner->pEmptyHash,
+                                      pHexChunkHash,
+                                      pSignature );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        writeChunkHeader( chunkLen, digitCount, pSigner->pPreviousSignature, pHeaderBuf );
+        *pHeaderBufLen = headerLen;
+    }
+
+    /* The final chunk ends the chain. */
+    if( ( returnStatus == SigV4Success ) && ( chunkLen == 0U ) )
+    {
+        ( void ) memset( pSigner->pSigningKey, 0, sizeof( pSigner->pSigningKey ) );
+        pSigner->pParams = NULL;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t checkChunks( const char * const * pChunks,
+                                  const size_t * pChunkLens,
+                                  size_t chunkCount )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    size_t i = 0U;
+
+    assert( ( pChunks != NULL ) && ( pChunkLens != NULL ) );
+
+    for( i = 0U; ( i < chunkCount ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        if( ( pChunks[ i ] == NULL ) && ( pChunkLens[ i ] > 0U ) )
+        {
+            LogError( ( "Parameter check failed: Chunk %lu is NULL.", ( unsigned long ) i ) );
+            returnStatus = SigV4InvalidParameter;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hashChunkGroup( const SigV4CryptoInterface_t * pCryptoInterface,
+                                     const char * const * pChunks,
+                                     const size_t * pChunkLens,
+                                     char * pHexChunkHashes,
+                                     size_t groupCount )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    const uint8_t * pInputs[ SIGV4_HASH_MULTIPLE_MAX_COUNT ] = { NULL };
+    uint8_t pDigests[ SIGV4_HASH_MULTIPLE_MAX_COUNT * SIGV4_HASH_DIGEST_LENGTH ];
+    size_t i = 0U;
+
+    assert( ( pCryptoInterface != NULL ) && ( groupCount <= SIGV4_HASH_MULTIPLE_MAX_COUNT ) );
+
+    if( pCryptoInterface->hashMultiple != NULL )
+    {
+        for( i = 0U; i < groupCount; i++ )
+        {
+            pInputs[ i ] = ( const uint8_t * ) ( ( pChunkLens[ i ] > 0U ) ? pChunks[ i ] : "" );
+        }
+
+        if( pCryptoInterface->hashMultiple( pCryptoInterface->pHashContext,
+                                            pInputs,
+                                            pChunkLens,
+                                            pDigests,
+                                            groupCount ) != 0 )
+        {
+            LogError( ( "Failed to hash the chunks." ) );
+            returnStatus = SigV4HashError;
+        }
+    }
+    else
+    {
+        for( i = 0U; ( i < groupCount ) && ( returnStatus == SigV4Success ); i++ )
+        {
+            returnStatus = completeHash( pCryptoInterface,
+                                         ( const uint8_t * ) ( ( pChunkLens[ i ] > 0U ) ? pChunks[ i ] : "" ),
+                                         pChunkLens[ i ],
+                                         &pDigests[ i * SIGV4_HASH_DIGEST_LENGTH ] );
+        }
+    }
+
+    for( i = 0U; ( i < groupCount ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        lowercaseHexEncode( &pDigests[ i * SIGV4_HASH_DIGEST_LENGTH ],
+                            SIGV4_HASH_DIGEST_LENGTH,
+                            &pHexChunkHashes[ i * HEX_ENCODED_DIGEST_LEN ] );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t getChunkSizeDigits( size_t chunkLen )
+{
+    size_t digitCount = 1U;
+
+    while( ( digitCount < CHUNK_SIZE_MAX_DIGITS ) && ( ( chunkLen >> ( 4U * digitCount ) ) != 0U ) )
+    {
+        digitCount++;
+    }
+
+    return digitCount;
+}
+
+/*-----------------------------------------------------------*/
+
+static void writeChunkHeader( size_t chunkLen,
+                              size_t digitCount,
+                              const char * pSignature,
+                              char * pHeader )
+{
+    static const char digitArr[] = "0123456789abcdef";
+    size_t i = 0U;
+
+    assert( ( pSignature != NULL ) && ( pHeader != NULL ) );
+    assert( ( digitCount > 0U ) && ( digitCount <= CHUNK_SIZE_MAX_DIGITS ) );
+
+    for( i = 0U; i < digitCount; i++ )
+    {
+        pHeader[ i ] = digitArr[ ( chunkLen >> ( 4U * ( digitCount - 1U - i ) ) ) & 0x0FU ];
+    }
+
+    ( void ) memcpy( &pHeader[ digitCount ], CHUNK_SIGNATURE_PREFIX, CHUNK_SIGNATURE_PREFIX_LEN );
+    ( void ) memcpy( &pHeader[ digitCount + CHUNK_SIGNATURE_PREFIX_LEN ], pSignature, HEX_ENCODED_DIGEST_LEN );
+    ( void ) memcpy( &pHeader[ digitCount + CHUNK_SIGNATURE_PREFIX_LEN + HEX_ENCODED_DIGEST_LEN ],
+                     CHUNK_LINE_TERMINATOR,
+                     CHUNK_LINE_TERMINATOR_LEN );
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t verifySigningParams( const SigV4Parameters_t * pParams )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    assert( pParams != NULL );
+
+    if( ( pParams->pCredentials == NULL ) ||
+        ( pParams->pCredentials->pAccessKeyId == NULL ) ||
+        ( pParams->pCredentials->accessKeyLen == 0U ) ||
+        ( pParams->pCredentials->pSecretAccessKey == NULL ) ||
+        ( pParams->pCredentials->secretAccessKeyLen == 0U ) )
+    {
+        LogError( ( "Parameter check failed: The access key ID and secret access key are required." ) );
+    }
+    else if( ( pParams->pDateIso8601 == NULL ) || ( pParams->pRegion == NULL ) ||
+             ( pParams->regionLen == 0U ) || ( pParams->pService == NULL ) ||
+             ( pParams->serviceLen == 0U ) )
+    {
+        LogError( ( "Parameter check failed: The date, region and service are required." ) );
+    }
+    else if( ( pParams->pCryptoInterface == NULL ) ||
+             ( pParams->pCryptoInterface->hashInit == NULL ) ||
+             ( pParams->pCryptoInterface->hashUpdate == NULL ) ||
+             ( pParams->pCryptoInterface->hashFinal == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pCryptoInterface and its hash functions must not be NULL." ) );
+    }
+    else if( ( getHashBlockLen( pParams->pCryptoInterface ) < SIGV4_HASH_DIGEST_LENGTH ) ||
+             ( getHashBlockLen( pParams->pCryptoInterface ) > SIGV4_HASH_MAX_BLOCK_LENGTH ) )
+    {
+        LogError( ( "Parameter check failed: hashBlockLen must be between SIGV4_HASH_DIGEST_LENGTH "
+                    "and SIGV4_HASH_MAX_BLOCK_LENGTH: hashBlockLen=%lu.",
+                    ( unsigned long ) getHashBlockLen( pParams->pCryptoInterface ) ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t verifyHttpParams( const SigV4HttpParameters_t * pHttpParams )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( ( pHttpParams == NULL ) || ( pHttpParams->pHttpMethod == NULL ) ||
+        ( pHttpParams->httpMethodLen == 0U ) )
+    {
+        LogError( ( "Parameter check failed: The HTTP method is required." ) );
+    }
+    else if( ( ( pHttpParams->pPath == NULL ) && ( pHttpParams->pathLen > 0U ) ) ||
+             ( ( pHttpParams->pQuery == NULL ) && ( pHttpParams->queryLen > 0U ) ) ||
+             ( ( pHttpParams->pHeaders == NULL ) && ( pHttpParams->headersLen > 0U ) ) ||
+             ( ( pHttpParams->pPayload == NULL ) && ( pHttpParams->payloadLen > 0U ) ) )
+    {
+        LogError( ( "Parameter check failed: The path, query, headers and payload "
+                    "may only be NULL if their length is zero." ) );
+    }
+    else if( ( ( pHttpParams->flags & SIGV4_HTTP_PAYLOAD_IS_HASH ) != 0U ) &&
+             ( pHttpParams->payloadLen == 0U ) )
+    {
+        LogError( ( "Parameter check failed: The payload hash is required when "
+                    "SIGV4_HTTP_PAYLOAD_IS_HASH is set." ) );
+    }
+    else if( ( ( pHttpParams->flags & SIGV4_HTTP_PAYLOAD_IS_HASH ) != 0U ) &&
+             ( ( pHttpParams->flags & SIGV4_HTTP_PAYLOAD_IS_UNSIGNED ) != 0U ) )
+    {
+        LogError( ( "Parameter check failed: SIGV4_HTTP_PAYLOAD_IS_HASH and "
+                    "SIGV4_HTTP_PAYLOAD_IS_UNSIGNED cannot both be set." ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t verifyParams( const SigV4Parameters_t * pParams,
+                                   const char * pAuthBuf,
+                                   const size_t * authBufLen,
+                                   char * const * pSignature,
+                                   const size_t * signatureLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( ( pParams == NULL ) || ( pAuthBuf == NULL ) || ( authBufLen == NULL ) ||
+        ( pSignature == NULL ) || ( signatureLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pParams, pAuthBuf, authBufLen, "
+                    "pSignature and signatureLen must not be NULL." ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = verifyHttpParams( pParams->pHttpParameters );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_GenerateHTTPAuthorization( const SigV4Parameters_t * pParams,
+                                               char * pAuthBuf,
+                                               size_t * authBufLen,
+                                               char ** pSignature,
+                                               size_t * signatureLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    CanonicalContext_t canonicalContext;
+    SigV4Buffer_t authBuffer = { 0 };
+    AuthorizationPrefix_t prefix = { 0 };
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+    SigV4RetrySnapshot_t * pSnapshot = NULL;
+
+    returnStatus = verifyParams( pParams, pAuthBuf, authBufLen, pSignature, signatureLen );
+
+    if( returnStatus == SigV4Success )
+    {
+        canonicalContext.pRetrySnapshot = NULL;
+        pSnapshot = pParams->pRetrySnapshot;
+
+        /* A snapshot from an earlier request is invalidated even if this one
+         * cannot be saved. */
+        if( pSnapshot != NULL )
+        {
+            pSnapshot->suffixLen = 0U;
+            pSnapshot->tokenLen = 0U;
+
+            if( ( pSnapshot->pHashContext != NULL ) &&
+                ( pParams->pCryptoInterface->hashCopyContext != NULL ) )
+            {
+                canonicalContext.pRetrySnapshot = pSnapshot;
+            }
+        }
+
+        canonicalContext.hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &canonicalContext.hmac, pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        authBuffer.pData = pAuthBuf;
+        authBuffer.bufferLen = *authBufLen;
+
+        returnStatus = generateAuthorization( pParams, &canonicalContext, pSigningKey, &prefix, NULL, &authBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        *pSignature = &pAuthBuf[ authBuffer.dataLen - HEX_ENCODED_DIGEST_LEN ];
+        *signatureLen = HEX_ENCODED_DIGEST_LEN;
+        *authBufLen = authBuffer.dataLen;
+    }
+    /* A request that could not be signed leaves no snapshot to retry from. */
+    else if( pSnapshot != NULL )
+    {
+        pSnapshot->suffixLen = 0U;
+    }
+    else
+    {
+        /* No retry snapshot was requested. */
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pSigningKey, 0, sizeof( pSigningKey ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_ResignHTTPAuthorization( const SigV4Parameters_t * pParams,
+                                             char * pAuthBuf,
+                                             size_t * authBufLen,
+                                             char ** pSignature,
+                                             size_t * signatureLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    CanonicalContext_t canonicalContext;
+    SigV4Buffer_t authBuffer = { 0 };
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+    const SigV4RetrySnapshot_t * pSnapshot = NULL;
+
+    if( ( pParams == NULL ) || ( pAuthBuf == NULL ) || ( authBufLen == NULL ) ||
+        ( pSignature == NULL ) || ( signatureLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pParams, pAuthBuf, authBufLen, "
+                    "pSignature and signatureLen must not be NULL." ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+        pSnapshot = pParams->pRetrySnapshot;
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The parameters are invalid. */
+    }
+    else if( ( pSnapshot == NULL ) || ( pSnapshot->pHashContext == NULL ) ||
+             ( pParams->pCryptoInterface->hashCopyContext == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pRetrySnapshot, its pHashContext and hashCopyContext "
+                    "must not be NULL." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else if( ( pSnapshot->suffixLen <= SIGV4_ISO_STRING_LEN ) ||
+             ( pSnapshot->suffixLen > sizeof( pSnapshot->pSuffix ) ) ||
+             ( pSnapshot->pSuffix[ SIGV4_ISO_STRING_LEN ] != LINEFEED_CHAR ) )
+    {
+        LogError( ( "Parameter check failed: No snapshot is saved in pRetrySnapshot." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else if( ( pSnapshot->tokenLen > 0U ) &&
+             ( ( pSnapshot->tokenOffset <= SIGV4_ISO_STRING_LEN ) ||
+               ( pSnapshot->tokenOffset > pSnapshot->suffixLen ) ) )
+    {
+        LogError( ( "Parameter check failed: The security token offset of pRetrySnapshot is out of range." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else if( ( pSnapshot->tokenLen > 0U ) &&
+             ( ( pParams->pCredentials->pSecurityToken == NULL ) ||
+               ( pParams->pCredentials->securityTokenLen == 0U ) ) )
+    {
+        LogError( ( "Parameter check failed: The request was signed with a security token, "
+                    "but pCredentials has none." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        canonicalContext.pRetrySnapshot = NULL;
+        canonicalContext.hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &canonicalContext.hmac, pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        authBuffer.pData = pAuthBuf;
+        authBuffer.bufferLen = *authBufLen;
+
+        returnStatus = resignAuthorization( pParams, &canonicalContext, pSigningKey, &authBuffer );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        *pSignature = &pAuthBuf[ authBuffer.dataLen - HEX_ENCODED_DIGEST_LEN ];
+        *signatureLen = HEX_ENCODED_DIGEST_LEN;
+        *authBufLen = authBuffer.dataLen;
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pSigningKey, 0, sizeof( pSigningKey ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_GeneratePresignedUrl( const SigV4Parameters_t * pParams,
+                                          uint32_t expiresSeconds,
+                                          char * pQueryBuf,
+                                          size_t * queryBufLen,
+                                          char ** pSignature,
+                                          size_t * signatureLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    CanonicalContext_t canonicalContext;
+    SigV4Buffer_t queryBuffer = { 0 };
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+    size_t signatureEnd = 0U;
+
+    returnStatus = verifyParams( pParams, pQueryBuf, queryBufLen, pSignature, signatureLen );
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The parameters are invalid. */
+    }
+    else if( ( expiresSeconds == 0U ) || ( expiresSeconds > SIGV4_PRESIGNED_URL_EXPIRES_MAX ) )
+    {
+        LogError( ( "Parameter check failed: expiresSeconds must be between 1 and "
+                    "SIGV4_PRESIGNED_URL_EXPIRES_MAX: expiresSeconds=%lu.",
+                    ( unsigned long ) expiresSeconds ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        canonicalContext.pRetrySnapshot = NULL;
+        canonicalContext.hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &canonicalContext.hmac, pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        queryBuffer.pData = pQueryBuf;
+        queryBuffer.bufferLen = *queryBufLen;
+
+        returnStatus = generatePresignedUrl( pParams, &canonicalContext, pSigningKey, expiresSeconds, &queryBuffer );
+    }
+
+    /* An unsigned security token follows the signature. */
+    if( returnStatus == SigV4Success )
+    {
+        signatureEnd = queryBuffer.dataLen;
+
+        if( ( pParams->pHttpParameters->flags & SIGV4_HTTP_SECURITY_TOKEN_IS_UNSIGNED ) != 0U )
+        {
+            returnStatus = writePresignedSecurityToken( pParams, &queryBuffer );
+        }
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        *pSignature = &pQueryBuf[ signatureEnd - HEX_ENCODED_DIGEST_LEN ];
+        *signatureLen = HEX_ENCODED_DIGEST_LEN;
+        *queryBufLen = queryBuffer.dataLen;
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pSigningKey, 0, sizeof( pSigningKey ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PresignPoolInit( SigV4PresignPool_t * pPool,
+                                     uint32_t windowSeconds )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( pPool == NULL )
+    {
+        LogError( ( "Parameter check failed: pPool must not be NULL." ) );
+    }
+    else if( ( windowSeconds == 0U ) ||
+             ( windowSeconds > ( SIGV4_PRESIGNED_URL_EXPIRES_MAX / PRESIGN_POOL_URL_WINDOWS ) ) )
+    {
+        LogError( ( "Parameter check failed: windowSeconds must be between 1 and half of "
+                    "SIGV4_PRESIGNED_URL_EXPIRES_MAX: windowSeconds=%lu.",
+                    ( unsigned long ) windowSeconds ) );
+    }
+    else
+    {
+        ( void ) memset( pPool, 0, sizeof( *pPool ) );
+        pPool->windowSeconds = windowSeconds;
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PresignPoolRefresh( SigV4PresignPool_t * pPool,
+                                        const SigV4Parameters_t * pParams,
+                                        uint64_t currentTime )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    uint32_t published = 0U, currentSlot = 0U, nextSlot = 0U;
+    uint64_t currentStart = 0U;
+
+    if( ( pPool == NULL ) || ( pParams == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pPool and pParams must not be NULL." ) );
+    }
+    else if( ( pPool->windowSeconds == 0U ) ||
+             ( pPool->windowSeconds > ( SIGV4_PRESIGNED_URL_EXPIRES_MAX / PRESIGN_POOL_URL_WINDOWS ) ) )
+    {
+        LogError( ( "Parameter check failed: The pool was not set up with SigV4_PresignPoolInit." ) );
+    }
+    else if( currentTime > ( EVENT_TIME_MAX - pPool->windowSeconds ) )
+    {
+        LogError( ( "Parameter check failed: currentTime must be before the year 10000." ) );
+    }
+    else
+    {
+        /* Only this task writes the published value. */
+        published = pPool->published;
+        currentStart = currentTime - ( currentTime % pPool->windowSeconds );
+        currentSlot = findPresignedWindow( pPool, published, currentStart );
+        nextSlot = findPresignedWindow( pPool, published, currentStart + pPool->windowSeconds );
+        returnStatus = SigV4Success;
+    }
+
+    /* The current window is missing after a pause longer than a window. Its
+     * URL is published before the next one is generated, as the slots
+     * published when the refresh started may still be read. At most two slots
+     * were, so a spare one is left. */
+    if( ( returnStatus == SigV4Success ) && ( currentSlot == 0U ) )
+    {
+        currentSlot = findSparePresignSlot( published, nextSlot );
+        assert( currentSlot != 0U );
+        returnStatus = presignWindow( pPool, pParams, currentSlot, currentStart );
+
+        if( returnStatus == SigV4Success )
+        {
+            SIGV4_ATOMIC_STORE_U32( &pPool->published, PRESIGN_POOL_PUBLISHED( currentSlot, nextSlot ) );
+        }
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( nextSlot == 0U ) )
+    {
+        nextSlot = findSparePresignSlot( published, currentSlot );
+
+        if( nextSlot == 0U )
+        {
+            LogDebug( ( "The URL of the next window is left to the next refresh, "
+                        "as the other slots may still be read." ) );
+        }
+        else
+        {
+            returnStatus = presignWindow( pPool, pParams, nextSlot, currentStart + pPool->windowSeconds );
+
+            if( returnStatus == SigV4Success )
+            {
+                SIGV4_ATOMIC_STORE_U32( &pPool->published, PRESIGN_POOL_PUBLISHED( currentSlot, nextSlot ) );
+            }
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PresignPoolGet( const SigV4PresignPool_t * pPool,
+                                    uint64_t currentTime,
+                                    const char ** pQuery,
+                                    size_t * queryLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    const SigV4PresignedWindow_t * pWindow = NULL;
+    uint32_t published = 0U, slot = 0U;
+
+    if( ( pPool == NULL ) || ( pQuery == NULL ) || ( queryLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pPool, pQuery and queryLen must not be NULL." ) );
+    }
+    else
+    {
+        published = SIGV4_ATOMIC_LOAD_U32( &pPool->published );
+        slot = PRESIGN_POOL_CURRENT_SLOT( published );
+        returnStatus = SigV4PresignedUrlUnavailable;
+    }
+
+    /* The refresh may be late, in which case the next window has started. */
+    while( ( returnStatus == SigV4PresignedUrlUnavailable ) && ( slot != 0U ) )
+    {
+        pWindow = &pPool->pWindows[ slot - 1U ];
+
+        if( ( currentTime >= pWindow->windowStart ) &&
+            ( ( currentTime - pWindow->windowStart ) < pPool->windowSeconds ) )
+        {
+            *pQuery = pWindow->pQuery;
+            *queryLen = pWindow->queryLen;
+            returnStatus = SigV4Success;
+        }
+        else if( slot == PRESIGN_POOL_CURRENT_SLOT( published ) )
+        {
+            slot = PRESIGN_POOL_NEXT_SLOT( published );
+        }
+        else
+        {
+            slot = 0U;
+        }
+    }
+
+    if( returnStatus == SigV4PresignedUrlUnavailable )
+    {
+        LogDebug( ( "No presigned URL is ready for the time %lu.", ( unsigned long ) currentTime ) );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PresignTemplateInit( SigV4PresignTemplate_t * pTemplate,
+                                         const SigV4Parameters_t * pParams,
+                                         uint32_t expiresSeconds )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4Parameters_t templateParams;
+    CanonicalContext_t canonicalContext;
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    if( ( pTemplate == NULL ) || ( pParams == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pTemplate and pParams must not be NULL." ) );
+    }
+    else
+    {
+        pTemplate->pCryptoInterface = NULL;
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = verifyHttpParams( pParams->pHttpParameters );
+    }
+
+    if( returnStatus != SigV4Success )
+    {
+        /* The parameters are invalid. */
+    }
+    else if( ( pTemplate->pHashContext == NULL ) || ( pParams->pCryptoInterface->hashCopyContext == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pTemplate->pHashContext and hashCopyContext must not be NULL." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else if( ( expiresSeconds == 0U ) || ( expiresSeconds > SIGV4_PRESIGNED_URL_EXPIRES_MAX ) )
+    {
+        LogError( ( "Parameter check failed: expiresSeconds must be between 1 and "
+                    "SIGV4_PRESIGNED_URL_EXPIRES_MAX: expiresSeconds=%lu.",
+                    ( unsigned long ) expiresSeconds ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        /* The signing key is cached in the template, which also saves its
+         * HMAC states if their storage is set. */
+        templateParams = *pParams;
+        templateParams.pSigningKeyCache = &pTemplate->signingKey;
+
+        canonicalContext.pRetrySnapshot = NULL;
+        canonicalContext.hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( &templateParams, &canonicalContext.hmac, pSigningKey );
+    }
+
+    /* The key is kept even if its tag does not fit in the cache. */
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) memcpy( pTemplate->signingKey.pSigningKey, pSigningKey, SIGV4_HASH_DIGEST_LENGTH );
+        returnStatus = compilePresignTemplate( pTemplate, &templateParams, &canonicalContext, expiresSeconds );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        pTemplate->keyEncoding = getPathEncoding( pParams );
+        pTemplate->pCryptoInterface = pParams->pCryptoInterface;
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pSigningKey, 0, sizeof( pSigningKey ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PresignTemplateSign( const SigV4PresignTemplate_t * pTemplate,
+                                         const char * pKey,
+                                         size_t keyLen,
+                                         char * pQueryBuf,
+                                         size_t * queryBufLen,
+                                         char ** pSignature,
+                                         size_t * signatureLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4Buffer_t queryBuffer = { 0 };
+    size_t signatureEnd = 0U;
+
+    if( ( pTemplate == NULL ) || ( pTemplate->pCryptoInterface == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pTemplate must be compiled by SigV4_PresignTemplateInit." ) );
+    }
+    else if( ( ( pKey == NULL ) && ( keyLen > 0U ) ) || ( pQueryBuf == NULL ) || ( queryBufLen == NULL ) ||
+             ( pSignature == NULL ) || ( signatureLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pQueryBuf, queryBufLen, pSignature and signatureLen must "
+                    "not be NULL, and pKey may only be NULL if keyLen is zero." ) );
+    }
+    else
+    {
+        queryBuffer.pData = pQueryBuf;
+        queryBuffer.bufferLen = *queryBufLen;
+
+        returnStatus = signTemplateKey( pTemplate, pKey, keyLen, &queryBuffer );
+    }
+
+    /* An unsigned security token follows the signature. */
+    if( returnStatus == SigV4Success )
+    {
+        signatureEnd = queryBuffer.dataLen;
+        returnStatus = writeToBuffer( &queryBuffer,
+                                      &pTemplate->pData[ pTemplate->stringToSignPrefixLen + pTemplate->canonicalSuffixLen ],
+                                      pTemplate->unsignedTokenLen );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        *pSignature = &pQueryBuf[ signatureEnd - HEX_ENCODED_DIGEST_LEN ];
+        *signatureLen = HEX_ENCODED_DIGEST_LEN;
+        *queryBufLen = queryBuffer.dataLen;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_GenerateHTTPAuthorizationBatch( const SigV4Parameters_t * pParams,
+                                                    const SigV4HttpParameters_t * pHttpParamsArray,
+                                                    SigV4Authorization_t * pAuthorizations,
+                                                    size_t requestCount )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4Parameters_t requestParams;
+    CanonicalContext_t canonicalContext;
+    SigV4Buffer_t authBuffer = { 0 };
+    AuthorizationPrefix_t prefix = { 0 };
+    uint8_t pSigningKey[ SIGV4_HASH_DIGEST_LENGTH ];
+    char pHexPayloadHashes[ SIGV4_HASH_MULTIPLE_MAX_COUNT * HEX_ENCODED_DIGEST_LEN ];
+    const char * pHexPayloadHash = NULL;
+    SigV4Authorization_t * pAuthorization = NULL;
+    SigV4Status_t payloadStatus = SigV4Success;
+    uint8_t hashTogether = 0U;
+    size_t i = 0U, groupStart = 0U, groupCount = 0U;
+
+    if( ( pParams == NULL ) || ( pHttpParamsArray == NULL ) ||
+        ( pAuthorizations == NULL ) || ( requestCount == 0U ) )
+    {
+        LogError( ( "Parameter check failed: pParams, pHttpParamsArray and "
+                    "pAuthorizations must not be NULL, and requestCount must be positive." ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    /* The signing key and the Authorization prefix are shared by all requests,
+     * so they are computed once. */
+    if( returnStatus == SigV4Success )
+    {
+        canonicalContext.pRetrySnapshot = NULL;
+        canonicalContext.hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &canonicalContext.hmac, pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        requestParams = *pParams;
+
+        /* The requests are processed in groups, so that the payloads of a
+         * group can be hashed together when the interface supports it. */
+        for( groupStart = 0U; groupStart < requestCount; groupStart += groupCount )
+        {
+            groupCount = requestCount - groupStart;
+
+            if( groupCount > SIGV4_HASH_MULTIPLE_MAX_COUNT )
+            {
+                groupCount = SIGV4_HASH_MULTIPLE_MAX_COUNT;
+            }
+
+            for( i = groupStart; i < ( groupStart + groupCount ); i++ )
+            {
+                pAuthorization = &pAuthorizations[ i ];
+
+                if( pAuthorization->pAuthBuf == NULL )
+                {
+                    LogError( ( "Parameter check failed: pAuthBuf of request %lu is NULL.", ( unsigned long ) i ) );
+                    pAuthorization->status = SigV4InvalidParameter;
+                }
+                else
+                {
+                    pAuthorization->status = verifyHttpParams( &pHttpParamsArray[ i ] );
+                }
+            }
+
+            payloadStatus = SigV4Success;
+
+            /* A request alone in its group is signed like a single request,
+             * since hashMultiple would only add to its cost. */
+            hashTogether = 0U;
+
+            if( ( pParams->pCryptoInterface->hashMultiple != NULL ) && ( groupCount > 1U ) )
+            {
+                hashTogether = 1U;
+                payloadStatus = hashPayloadsTogether( pParams->pCryptoInterface,
+                                                      &pHttpParamsArray[ groupStart ],
+                                                      &pAuthorizations[ groupStart ],
+                                                      groupCount,
+                                                      pHexPayloadHashes );
+            }
+
+            for( i = groupStart; i < ( groupStart + groupCount ); i++ )
+            {
+                pAuthorization = &pAuthorizations[ i ];
+                requestParams.pHttpParameters = &pHttpParamsArray[ i ];
+
+                if( ( pAuthorization->status == SigV4Success ) && ( payloadStatus != SigV4Success ) )
+                {
+                    pAuthorization->status = payloadStatus;
+                }
+
+                if( pAuthorization->status == SigV4Success )
+                {
+                    authBuffer.pData = pAuthorization->pAuthBuf;
+                    authBuffer.bufferLen = pAuthorization->authBufLen;
+                    authBuffer.dataLen = 0U;
+                    pHexPayloadHash = NULL;
+
+                    if( hashTogether == 1U )
+                    {
+                        pHexPayloadHash = &pHexPayloadHashes[ ( i - groupStart ) * HEX_ENCODED_DIGEST_LEN ];
+                    }
+
+                    pAuthorization->status = generateAuthorization( &requestParams,
+                                                                    &canonicalContext,
+                                                                    pSigningKey,
+                                                                    &prefix,
+                                                                    pHexPayloadHash,
+                                                                    &authBuffer );
+                }
+
+                if( pAuthorization->status == SigV4Success )
+                {
+                    pAuthorization->pSignature = &pAuthorization->pAuthBuf[ authBuffer.dataLen - HEX_ENCODED_DIGEST_LEN ];
+                    pAuthorization->signatureLen = HEX_ENCODED_DIGEST_LEN;
+                    pAuthorization->authBufLen = authBuffer.dataLen;
+                }
+
+                /* Report the first failure, and carry on with the other requests. */
+                if( ( pAuthorization->status != SigV4Success ) && ( returnStatus == SigV4Success ) )
+                {
+                    returnStatus = pAuthorization->status;
+                }
+            }
+        }
+    }
+
+    ( void ) memset( pSigningKey, 0, sizeof( pSigningKey ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_DeriveSigningKeys( const SigV4Parameters_t * pParams,
+                                       const char * const * pRegions,
+                                       const size_t * pRegionLens,
+                                       SigV4SigningKeyCache_t * pCaches,
+                                       size_t regionCount )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4Parameters_t regionParams;
+    HmacContext_t hmac;
+    HmacLanes_t lanes;
+    uint8_t pDateKey[ SIGV4_HASH_DIGEST_LENGTH ];
+    uint8_t pSigningKeys[ SIGV4_HASH_MULTIPLE_MAX_COUNT * SIGV4_HASH_DIGEST_LENGTH ];
+    uint8_t * pSigningKey = NULL;
+    uint8_t lanesAvailable = 0U, fitsLanes = 0U;
+    size_t i = 0U, groupStart = 0U, groupCount = 0U;
+
+    if( ( pParams == NULL ) || ( pRegions == NULL ) || ( pRegionLens == NULL ) ||
+        ( pCaches == NULL ) || ( regionCount == 0U ) )
+    {
+        LogError( ( "Parameter check failed: pParams, pRegions, pRegionLens and "
+                    "pCaches must not be NULL, and regionCount must be positive." ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    for( i = 0U; ( i < regionCount ) && ( returnStatus == SigV4Success ); i++ )
+    {
+        if( ( pRegions[ i ] == NULL ) || ( pRegionLens[ i ] == 0U ) )
+        {
+            LogError( ( "Parameter check failed: Region %lu is empty.", ( unsigned long ) i ) );
+            returnStatus = SigV4InvalidParameter;
+        }
+    }
+
+    /* kDate is the same for all regions. */
+    if( returnStatus == SigV4Success )
+    {
+        hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = deriveDateKey( pParams, &hmac, pDateKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        regionParams = *pParams;
+        if( ( pParams->pCryptoInterface->hashMultiple != NULL ) &&
+            ( pParams->serviceLen <= HMAC_LANE_MAX_DATA_LENGTH ) )
+        {
+            lanesAvailable = 1U;
+        }
+    }
+
+    for( groupStart = 0U; ( groupStart < regionCount ) && ( returnStatus == SigV4Success ); groupStart += groupCount )
+    {
+        groupCount = regionCount - groupStart;
+
+        if( groupCount > SIGV4_HASH_MULTIPLE_MAX_COUNT )
+        {
+            groupCount = SIGV4_HASH_MULTIPLE_MAX_COUNT;
+        }
+
+        /* A long region only sends its own group down the serial path. */
+        fitsLanes = lanesAvailable;
+
+        for( i = groupStart; ( i < ( groupStart + groupCount ) ) && ( fitsLanes == 1U ); i++ )
+        {
+            if( pRegionLens[ i ] > HMAC_LANE_MAX_DATA_LENGTH )
+            {
+                fitsLanes = 0U;
+            }
+        }
+
+        if( fitsLanes == 1U )
+        {
+            returnStatus = deriveRegionKeysTogether( pParams,
+                                                     &lanes,
+                                                     pDateKey,
+                                                     &pRegions[ groupStart ],
+                                                     &pRegionLens[ groupStart ],
+                                                     pSigningKeys,
+                                                     groupCount );
+        }
+        else
+        {
+            for( i = 0U; ( i < groupCount ) && ( returnStatus == SigV4Success ); i++ )
+            {
+                pSigningKey = &pSigningKeys[ i * SIGV4_HASH_DIGEST_LENGTH ];
+                ( void ) memcpy( pSigningKey, pDateKey, SIGV4_HASH_DIGEST_LENGTH );
+                returnStatus = chainHmac( &hmac, pSigningKey, pRegions[ groupStart + i ], pRegionLens[ groupStart + i ] );
+
+                if( returnStatus == SigV4Success )
+                {
+                    returnStatus = chainHmac( &hmac, pSigningKey, pParams->pService, pParams->serviceLen );
+                }
+
+                if( returnStatus == SigV4Success )
+                {
+                    returnStatus = chainHmac( &hmac, pSigningKey, CREDENTIAL_SCOPE_TERMINATOR, CREDENTIAL_SCOPE_TERMINATOR_LEN );
+                }
+            }
+        }
+
+        for( i = 0U; ( i < groupCount ) && ( returnStatus == SigV4Success ); i++ )
+        {
+            regionParams.pRegion = pRegions[ groupStart + i ];
+            regionParams.regionLen = pRegionLens[ groupStart + i ];
+            pCaches[ groupStart + i ].missCount++;
+            returnStatus = storeSigningKey( &regionParams,
+                                            &hmac,
+                                            &pSigningKeys[ i * SIGV4_HASH_DIGEST_LENGTH ],
+                                            &pCaches[ groupStart + i ] );
+        }
+    }
+
+    /* Do not leave key material on the stack. */
+    ( void ) memset( pDateKey, 0, sizeof( pDateKey ) );
+    ( void ) memset( pSigningKeys, 0, sizeof( pSigningKeys ) );
+    ( void ) memset( &lanes, 0, sizeof( lanes ) );
+    ( void ) memset( &hmac, 0, sizeof( hmac ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PayloadHashInit( SigV4PayloadHash_t * pPayloadHash,
+                                     const SigV4CryptoInterface_t * pCryptoInterface )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( ( pPayloadHash == NULL ) || ( pCryptoInterface == NULL ) ||
+        ( pCryptoInterface->hashInit == NULL ) ||
+        ( pCryptoInterface->hashUpdate == NULL ) ||
+        ( pCryptoInterface->hashFinal == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pPayloadHash, pCryptoInterface and "
+                    "its hash functions must not be NULL." ) );
+    }
+    else if( pCryptoInterface->hashInit( pCryptoInterface->pHashContext ) != 0 )
+    {
+        LogError( ( "Failed to initialize the payload hash." ) );
+        returnStatus = SigV4HashError;
+    }
+    else
+    {
+        pPayloadHash->pCryptoInterface = pCryptoInterface;
+        pPayloadHash->payloadLen = 0U;
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PayloadHashUpdate( SigV4PayloadHash_t * pPayloadHash,
+                                       const char * pData,
+                                       size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+
+    if( ( pPayloadHash == NULL ) || ( pPayloadHash->pCryptoInterface == NULL ) ||
+        ( ( pData == NULL ) && ( dataLen > 0U ) ) )
+    {
+        LogError( ( "Parameter check failed: pPayloadHash must be initialized, "
+                    "and pData may only be NULL if dataLen is zero." ) );
+    }
+    else
+    {
+        pCryptoInterface = pPayloadHash->pCryptoInterface;
+        returnStatus = SigV4Success;
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( dataLen > 0U ) )
+    {
+        if( pCryptoInterface->hashUpdate( pCryptoInterface->pHashContext,
+                                          ( const uint8_t * ) pData,
+                                          dataLen ) != 0 )
+        {
+            LogError( ( "Failed to update the payload hash." ) );
+            returnStatus = SigV4HashError;
+        }
+        else
+        {
+            pPayloadHash->payloadLen += dataLen;
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_PayloadHashFinal( SigV4PayloadHash_t * pPayloadHash,
+                                      char * pHexPayloadHash,
+                                      size_t hexPayloadHashLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    const SigV4CryptoInterface_t * pCryptoInterface = NULL;
+    uint8_t pDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    if( ( pPayloadHash == NULL ) || ( pPayloadHash->pCryptoInterface == NULL ) ||
+        ( pHexPayloadHash == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pPayloadHash must be initialized, "
+                    "and pHexPayloadHash must not be NULL." ) );
+    }
+    else if( hexPayloadHashLen < HEX_ENCODED_DIGEST_LEN )
+    {
+        LogError( ( "Insufficient memory: The payload hash needs %lu bytes: hexPayloadHashLen=%lu.",
+                    ( unsigned long ) HEX_ENCODED_DIGEST_LEN,
+                    ( unsigned long ) hexPayloadHashLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        pCryptoInterface = pPayloadHash->pCryptoInterface;
+
+        if( pCryptoInterface->hashFinal( pCryptoInterface->pHashContext,
+                                         pDigest,
+                                         SIGV4_HASH_DIGEST_LENGTH ) != 0 )
+        {
+            LogError( ( "Failed to finalize the payload hash." ) );
+            returnStatus = SigV4HashError;
+        }
+        else
+        {
+            lowercaseHexEncode( pDigest, SIGV4_HASH_DIGEST_LENGTH, pHexPayloadHash );
+            returnStatus = SigV4Success;
+        }
+
+        /* The state is used up, whether or not the hash could be finalized. */
+        pPayloadHash->pCryptoInterface = NULL;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_ChunkSignerInit( SigV4ChunkSigner_t * pSigner,
+                                     const SigV4Parameters_t * pParams,
+                                     const char * pSeedSignature,
+                                     size_t seedSignatureLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    HmacContext_t hmac;
+    uint8_t pEmptyDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+
+    if( ( pSigner == NULL ) || ( pParams == NULL ) || ( pSeedSignature == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pSigner, pParams and pSeedSignature must not be NULL." ) );
+    }
+    else if( seedSignatureLen != HEX_ENCODED_DIGEST_LEN )
+    {
+        LogError( ( "Parameter check failed: The seed signature must be %lu characters long: seedSignatureLen=%lu.",
+                    ( unsigned long ) HEX_ENCODED_DIGEST_LEN,
+                    ( unsigned long ) seedSignatureLen ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &hmac, pSigner->pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = completeHash( pParams->pCryptoInterface, ( const uint8_t * ) "", 0U, pEmptyDigest );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pEmptyDigest, SIGV4_HASH_DIGEST_LENGTH, pSigner->pEmptyHash );
+        ( void ) memcpy( pSigner->pPreviousSignature, pSeedSignature, HEX_ENCODED_DIGEST_LEN );
+        pSigner->pParams = pParams;
+    }
+    else if( pSigner != NULL )
+    {
+        ( void ) memset( pSigner, 0, sizeof( *pSigner ) );
+    }
+    else
+    {
+        /* There is no signer to clear. */
+    }
+
+    ( void ) memset( hmac.key, 0, sizeof( hmac.key ) );
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_SignChunk( SigV4ChunkSigner_t * pSigner,
+                               const char * pChunk,
+                               size_t chunkLen,
+                               char * pHeaderBuf,
+                               size_t * pHeaderBufLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    uint8_t pChunkDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+    char pHexChunkHash[ HEX_ENCODED_DIGEST_LEN ];
+
+    if( ( pSigner == NULL ) || ( pSigner->pParams == NULL ) ||
+        ( ( pChunk == NULL ) && ( chunkLen > 0U ) ) ||
+        ( pHeaderBuf == NULL ) || ( pHeaderBufLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pSigner must be initialized and not finished, "
+                    "pHeaderBuf and pHeaderBufLen must not be NULL, and pChunk may only "
+                    "be NULL if chunkLen is zero." ) );
+    }
+    else
+    {
+        returnStatus = completeHash( pSigner->pParams->pCryptoInterface,
+                                     ( const uint8_t * ) ( ( chunkLen > 0U ) ? pChunk : "" ),
+                                     chunkLen,
+                                     pChunkDigest );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        lowercaseHexEncode( pChunkDigest, SIGV4_HASH_DIGEST_LENGTH, pHexChunkHash );
+        returnStatus = signChunkAndWriteHeader( pSigner, pHexChunkHash, chunkLen, pHeaderBuf, pHeaderBufLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_SignChunkHash( SigV4ChunkSigner_t * pSigner,
+                                   const char * pHexChunkHash,
+                                   size_t hexChunkHashLen,
+                                   size_t chunkLen,
+                                   char * pHeaderBuf,
+                                   size_t * pHeaderBufLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( ( pSigner == NULL ) || ( pSigner->pParams == NULL ) || ( pHexChunkHash == NULL ) ||
+        ( pHeaderBuf == NULL ) || ( pHeaderBufLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pSigner must be initialized and not finished, "
+                    "and pHexChunkHash, pHeaderBuf and pHeaderBufLen must not be NULL." ) );
+    }
+    else if( hexChunkHashLen != HEX_ENCODED_DIGEST_LEN )
+    {
+        LogError( ( "Parameter check failed: The chunk hash must be %lu characters long: hexChunkHashLen=%lu.",
+                    ( unsigned long ) HEX_ENCODED_DIGEST_LEN,
+                    ( unsigned long ) hexChunkHashLen ) );
+    }
+    else
+    {
+        returnStatus = signChunkAndWriteHeader( pSigner, pHexChunkHash, chunkLen, pHeaderBuf, pHeaderBufLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_HashChunks( const SigV4CryptoInterface_t * pCryptoInterface,
+                                const char * const * pChunks,
+                                const size_t * pChunkLens,
+                                char * pHexChunkHashes,
+                                size_t chunkCount )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    size_t groupStart = 0U, groupCount = 0U;
+
+    if( ( pCryptoInterface == NULL ) || ( pCryptoInterface->hashInit == NULL ) ||
+        ( pCryptoInterface->hashUpdate == NULL ) || ( pCryptoInterface->hashFinal == NULL ) ||
+        ( pChunks == NULL ) || ( pChunkLens == NULL ) || ( pHexChunkHashes == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pCryptoInterface, its hash functions, pChunks, "
+                    "pChunkLens and pHexChunkHashes must not be NULL." ) );
+    }
+    else
+    {
+        returnStatus = checkChunks( pChunks, pChunkLens, chunkCount );
+    }
+
+    for( groupStart = 0U; ( groupStart < chunkCount ) && ( returnStatus == SigV4Success ); groupStart += groupCount )
+    {
+        groupCount = chunkCount - groupStart;
+
+        if( groupCount > SIGV4_HASH_MULTIPLE_MAX_COUNT )
+        {
+            groupCount = SIGV4_HASH_MULTIPLE_MAX_COUNT;
+        }
+
+        returnStatus = hashChunkGroup( pCryptoInterface,
+                                       &pChunks[ groupStart ],
+                                       &pChunkLens[ groupStart ],
+                                       &pHexChunkHashes[ groupStart * HEX_ENCODED_DIGEST_LEN ],
+                                       groupCount );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_ChunkHashJobInit( SigV4ChunkHashJob_t * pJob,
+                                      const char * const * pChunks,
+                                      const size_t * pChunkLens,
+                                      char * pHexChunkHashes,
+                                      size_t chunkCount )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( ( pJob == NULL ) || ( pChunks == NULL ) || ( pChunkLens == NULL ) || ( pHexChunkHashes == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pJob, pChunks, pChunkLens and pHexChunkHashes must not be NULL." ) );
+    }
+    else if( chunkCount > SIGV4_CHUNK_HASH_JOB_MAX_COUNT )
+    {
+        LogError( ( "Parameter check failed: A chunk hash job holds at most %lu chunks: chunkCount=%lu.",
+                    ( unsigned long ) SIGV4_CHUNK_HASH_JOB_MAX_COUNT,
+                    ( unsigned long ) chunkCount ) );
+    }
+    else
+    {
+        returnStatus = checkChunks( pChunks, pChunkLens, chunkCount );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        pJob->pChunks = pChunks;
+        pJob->pChunkLens = pChunkLens;
+        pJob->pHexChunkHashes = pHexChunkHashes;
+        pJob->chunkCount = chunkCount;
+        pJob->groupCount = ( uint32_t ) ( ( chunkCount + SIGV4_HASH_MULTIPLE_MAX_COUNT - 1U ) / SIGV4_HASH_MULTIPLE_MAX_COUNT );
+        pJob->nextGroup = 0U;
+        pJob->hashedGroups = 0U;
+        pJob->failed = 0U;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_ChunkHashJobRun( SigV4ChunkHashJob_t * pJob,
+                                     const SigV4CryptoInterface_t * pCryptoInterface )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    size_t groupStart = 0U, groupCount = 0U;
+    uint32_t group = 0U;
+    uint8_t claiming = 0U;
+
+    if( ( pJob == NULL ) || ( pCryptoInterface == NULL ) || ( pCryptoInterface->hashInit == NULL ) ||
+        ( pCryptoInterface->hashUpdate == NULL ) || ( pCryptoInterface->hashFinal == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pJob, pCryptoInterface and its hash functions must not be NULL." ) );
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+        claiming = 1U;
+    }
+
+    while( claiming == 1U )
+    {
+        /* Every claim past the last group fails, so the counter can only
+         * pass it by the number of calls, which the chunk count limit
+         * leaves room for. */
+        group = SIGV4_ATOMIC_FETCH_ADD_U32( &pJob->nextGroup, 1U );
+
+        if( ( group >= pJob->groupCount ) || ( SIGV4_ATOMIC_LOAD_U32( &pJob->failed ) != 0U ) )
+        {
+            claiming = 0U;
+        }
+        else
+        {
+            groupStart = ( size_t ) group * SIGV4_HASH_MULTIPLE_MAX_COUNT;
+            groupCount = pJob->chunkCount - groupStart;
+
+            if( groupCount > SIGV4_HASH_MULTIPLE_MAX_COUNT )
+            {
+                groupCount = SIGV4_HASH_MULTIPLE_MAX_COUNT;
+            }
+
+            returnStatus = hashChunkGroup( pCryptoInterface,
+                                           &pJob->pChunks[ groupStart ],
+                                           &pJob->pChunkLens[ groupStart ],
+                                           &pJob->pHexChunkHashes[ groupStart * HEX_ENCODED_DIGEST_LEN ],
+                                           groupCount );
+
+            if( returnStatus == SigV4Success )
+            {
+                /* The hashes are written before the group is counted. */
+                ( void ) SIGV4_ATOMIC_FETCH_ADD_U32( &pJob->hashedGroups, 1U );
+            }
+            else
+            {
+                SIGV4_ATOMIC_STORE_U32( &pJob->failed, 1U );
+                claiming = 0U;
+            }
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_ChunkHashJobResult( const SigV4ChunkHashJob_t * pJob )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+
+    if( pJob == NULL )
+    {
+        LogError( ( "Parameter check failed: pJob is NULL." ) );
+    }
+    else if( SIGV4_ATOMIC_LOAD_U32( &pJob->failed ) != 0U )
+    {
+        LogError( ( "Failed to hash the chunks of the job." ) );
+        returnStatus = SigV4HashError;
+    }
+    else if( SIGV4_ATOMIC_LOAD_U32( &pJob->hashedGroups ) < pJob->groupCount )
+    {
+        returnStatus = SigV4ChunkHashesPending;
+    }
+    else
+    {
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_EventSignerInit( SigV4EventSigner_t * pSigner,
+                                     const SigV4Parameters_t * pParams,
+                                     const char * pSeedSignature,
+                                     size_t seedSignatureLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    HmacContext_t hmac;
 
-            /* Do not assign values for skipped characters ('*'), or
-             * unrecognized format specifiers. */
-            break;
+    if( ( pSigner == NULL ) || ( pParams == NULL ) || ( pSeedSignature == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pSigner, pParams and pSeedSignature must not be NULL." ) );
+    }
+    else if( seedSignatureLen != HEX_ENCODED_DIGEST_LEN )
+    {
+        LogError( ( "Parameter check failed: The seed signature must be %lu characters long: seedSignatureLen=%lu.",
+                    ( unsigned long ) HEX_ENCODED_DIGEST_LEN,
+                    ( unsigned long ) seedSignatureLen ) );
+    }
+    else
+    {
+        returnStatus = verifySigningParams( pParams );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        hmac.pCryptoInterface = pParams->pCryptoInterface;
+        returnStatus = getSigningKey( pParams, &hmac, pSigner->pSigningKey );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) memcpy( pSigner->pKeyDate, pParams->pDateIso8601, SIGV4_ISO_STRING_LEN );
+        ( void ) memcpy( pSigner->pPreviousSignature, pSeedSignature, HEX_ENCODED_DIGEST_LEN );
+        pSigner->pParams = pParams;
+    }
+    else if( pSigner != NULL )
+    {
+        ( void ) memset( pSigner, 0, sizeof( *pSigner ) );
+    }
+    else
+    {
+        /* There is no signer to clear. */
     }
+
+    ( void ) memset( hmac.key, 0, sizeof( hmac.key ) );
+
+    return returnStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-static SigV4Status_t scanValue( const char * pDate,
-                                const char formatChar,
-                                size_t readLoc,
-                                size_t lenToRead,
-                                SigV4DateTime_t * pDateElements )
+SigV4Status_t SigV4_SignEvent( SigV4EventSigner_t * pSigner,
+                               uint64_t eventTime,
+                               const uint8_t * pPayload,
+                               size_t payloadLen,
+                               uint8_t * pHeaderBuf,
+                               size_t headerBufLen )
 {
     SigV4Status_t returnStatus = SigV4InvalidParameter;
-    const char * pMonthNames[] = MONTH_NAMES;
-    const char * pLoc = pDate + readLoc;
-    size_t remainingLenToRead = lenToRead;
-    int32_t result = 0;
-
-    assert( pDate != NULL );
-    assert( pDateElements != NULL );
+    SigV4Parameters_t eventParams;
+    SigV4DateTime_t eventDate = { 0 };
+    HmacContext_t hmac;
+    char pEventDate[ SIGV4_ISO_STRING_LEN ];
+    uint8_t pDigest[ SIGV4_HASH_DIGEST_LENGTH ];
+    char pHexHeadersHash[ HEX_ENCODED_DIGEST_LEN ];
+    char pHexPayloadHash[ HEX_ENCODED_DIGEST_LEN ];
 
-    if( formatChar == '*' )
+    if( ( pSigner == NULL ) || ( pSigner->pParams == NULL ) ||
+        ( ( pPayload == NULL ) && ( payloadLen > 0U ) ) || ( pHeaderBuf == NULL ) )
     {
-        remainingLenToRead = 0U;
+        LogError( ( "Parameter check failed: pSigner must be initialized, pHeaderBuf must "
+                    "not be NULL, and pPayload may only be NULL if payloadLen is zero." ) );
+    }
+    else if( eventTime > EVENT_TIME_MAX )
+    {
+        LogError( ( "Parameter check failed: The event time is after the year 9999." ) );
+    }
+    else if( headerBufLen < SIGV4_EVENT_HEADERS_LENGTH )
+    {
+        LogError( ( "Insufficient memory: The event headers need %lu bytes: headerBufLen=%lu.",
+                    ( unsigned long ) SIGV4_EVENT_HEADERS_LENGTH,
+                    ( unsigned long ) headerBufLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        epochToDateTime( eventTime, &eventDate );
+        writeIso8601( &eventDate, pEventDate );
+        eventParams = *pSigner->pParams;
+        eventParams.pDateIso8601 = pEventDate;
+        hmac.pCryptoInterface = eventParams.pCryptoInterface;
+        returnStatus = SigV4Success;
     }
 
-    /* Determine if month value is non-numeric. */
-    if( ( formatChar == 'M' ) && ( remainingLenToRead == MONTH_ASCII_LEN ) )
+    /* The signing key changes with the date of the credential scope. */
+    if( ( returnStatus == SigV4Success ) &&
+        ( memcmp( pEventDate, pSigner->pKeyDate, ISO_DATE_SCOPE_LEN ) != 0 ) )
     {
-        while( result++ < 12 )
+        returnStatus = getSigningKey( &eventParams, &hmac, pSigner->pSigningKey );
+        ( void ) memset( hmac.key, 0, sizeof( hmac.key ) );
+
+        if( returnStatus == SigV4Success )
         {
-            /* Search month array for parsed string. */
-            if( strncmp( pMonthNames[ result - 1 ], pLoc, MONTH_ASCII_LEN ) == 0 )
-            {
-                returnStatus = SigV4Success;
-                break;
-            }
+            ( void ) memcpy( pSigner->pKeyDate, pEventDate, SIGV4_ISO_STRING_LEN );
         }
-
-        if( returnStatus != SigV4Success )
+        else
         {
-            LogError( ( "Unable to match string '%.3s' to a month value.",
-                        pLoc ) );
-            returnStatus = SigV4ISOFormattingError;
+            /* The key of the previous date was overwritten. */
+            ( void ) memset( pSigner->pSigningKey, 0, sizeof( pSigner->pSigningKey ) );
+            ( void ) memset( pSigner->pKeyDate, 0, sizeof( pSigner->pKeyDate ) );
         }
-
-        remainingLenToRead = 0U;
     }
 
-    /* Interpret integer value of numeric representation. */
-    while( ( remainingLenToRead > 0U ) && ( *pLoc >= '0' ) && ( *pLoc <= '9' ) )
+    if( returnStatus == SigV4Success )
     {
-        result = ( result * 10 ) + ( int32_t ) ( *pLoc - '0' );
-        remainingLenToRead--;
-        pLoc += 1;
+        writeEventHeaders( eventTime, pHeaderBuf );
+        returnStatus = completeHash( eventParams.pCryptoInterface, pHeaderBuf, EVENT_DATE_HEADER_LEN, pDigest );
     }
 
-    if( remainingLenToRead != 0U )
+    if( returnStatus == SigV4Success )
     {
-        LogError( ( "Parsing Error: Expected numerical string of type '%%%d%c', "
-                    "but received '%.*s'.",
-                    ( int ) lenToRead,
-                    formatChar,
-                    ( int ) lenToRead,
-                    pLoc ) );
-        returnStatus = SigV4ISOFormattingError;
+        lowercaseHexEncode( pDigest, SIGV4_HASH_DIGEST_LENGTH, pHexHeadersHash );
+        returnStatus = completeHash( eventParams.pCryptoInterface,
+                                     ( payloadLen > 0U ) ? pPayload : ( const uint8_t * ) "",
+                                     payloadLen,
+                                     pDigest );
     }
 
-    if( returnStatus != SigV4ISOFormattingError )
+    if( returnStatus == SigV4Success )
     {
-        addToDate( formatChar,
-                   result,
-                   pDateElements );
+        lowercaseHexEncode( pDigest, SIGV4_HASH_DIGEST_LENGTH, pHexPayloadHash );
+        returnStatus = signChainLink( &eventParams,
+                                      pSigner->pSigningKey,
+                                      pSigner->pPreviousSignature,
+                                      pHexHeadersHash,
+                                      pHexPayloadHash,
+                                      &pHeaderBuf[ SIGV4_EVENT_HEADERS_LENGTH - SIGV4_HASH_DIGEST_LENGTH ] );
     }
 
     return returnStatus;
@@ -367,68 +7713,52 @@ static SigV4Status_t scanValue( const char * pDate,
 
 /*-----------------------------------------------------------*/
 
-static SigV4Status_t parseDate( const char * pDate,
-                                size_t dateLen,
-                                const char * pFormat,
-                                size_t formatLen,
-                                SigV4DateTime_t * pDateElements )
+SigV4Status_t SigV4_ParseCredentialsExpiration( SigV4Credentials_t * pCredentials )
 {
     SigV4Status_t returnStatus = SigV4InvalidParameter;
-    size_t readLoc = 0U, lenToRead = 0U, formatIndex = 0U;
+    uint64_t expirationTime = 0U;
 
-    assert( pDate != NULL );
-    assert( pFormat != NULL );
-    assert( pDateElements != NULL );
-    ( void ) dateLen;
+    if( pCredentials == NULL )
+    {
+        LogError( ( "Parameter check failed: pCredentials is NULL." ) );
+    }
+    else
+    {
+        returnStatus = parseExpirationTime( pCredentials->pExpiration,
+                                            pCredentials->expirationLen,
+                                            &expirationTime );
+    }
 
-    /* Loop through the format string. */
-    while( ( formatIndex < formatLen ) && ( returnStatus != SigV4ISOFormattingError ) )
+    if( returnStatus == SigV4Success )
     {
-        if( pFormat[ formatIndex ] == '%' )
-        {
-            /* '%' must be followed by a length and type specification. */
-            assert( formatIndex < formatLen - 2 );
-            formatIndex++;
+        pCredentials->expirationTime = expirationTime;
+    }
 
-            /* Numerical value of length specifier character. */
-            lenToRead = ( ( uint32_t ) pFormat[ formatIndex ] - ( uint32_t ) '0' );
-            formatIndex++;
+    return returnStatus;
+}
 
-            /* Ensure read is within buffer bounds. */
-            assert( readLoc + lenToRead - 1 < dateLen );
-            returnStatus = scanValue( pDate,
-                                      pFormat[ formatIndex ],
-                                      readLoc,
-                                      lenToRead,
-                                      pDateElements );
+/*-----------------------------------------------------------*/
 
-            readLoc += lenToRead;
-        }
-        else if( pDate[ readLoc ] != pFormat[ formatIndex ] )
-        {
-            LogError( ( "Parsing error: Expected character '%c', "
-                        "but received '%c'.",
-                        pFormat[ formatIndex ], pDate[ readLoc ] ) );
-            returnStatus = SigV4ISOFormattingError;
-        }
-        else
-        {
-            readLoc++;
-            LogDebug( ( "Successfully matched character '%c' found in format string.",
-                        pDate[ readLoc - 1 ] ) );
-        }
+SigV4Status_t SigV4_CredentialsExpireWithin( const SigV4Credentials_t * pCredentials,
+                                             uint64_t currentTime,
+                                             uint32_t seconds )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
 
-        formatIndex++;
+    if( pCredentials == NULL )
+    {
+        LogError( ( "Parameter check failed: pCredentials is NULL." ) );
     }
-
-    if( ( returnStatus != SigV4ISOFormattingError ) )
+    /* The subtraction cannot wrap, unlike adding seconds to currentTime. */
+    else if( ( pCredentials->expirationTime != 0U ) &&
+             ( ( pCredentials->expirationTime <= currentTime ) ||
+               ( ( pCredentials->expirationTime - currentTime ) <= seconds ) ) )
     {
-        returnStatus = SigV4Success;
+        returnStatus = SigV4CredentialsExpiring;
     }
     else
     {
-        LogError( ( "Parsing Error: Date did not match expected string format." ) );
-        returnStatus = SigV4ISOFormattingError;
+        returnStatus = SigV4Success;
     }
 
     return returnStatus;
@@ -436,78 +7766,161 @@ static SigV4Status_t parseDate( const char * pDate,
 
 /*-----------------------------------------------------------*/
 
+SigV4Status_t SigV4_CredentialStoreInit( SigV4CredentialStore_t * pStore )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
 
-SigV4Status_t SigV4_AwsIotDateToIso8601( const char * pDate,
-                                         size_t dateLen,
-                                         char * pDateISO8601,
-                                         size_t dateISO8601Len )
+    if( pStore == NULL )
+    {
+        LogError( ( "Parameter check failed: pStore must not be NULL." ) );
+    }
+    else
+    {
+        ( void ) memset( pStore, 0, sizeof( *pStore ) );
+        returnStatus = SigV4Success;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_CredentialStorePublish( SigV4CredentialStore_t * pStore,
+                                            const SigV4Credentials_t * pCredentials )
 {
     SigV4Status_t returnStatus = SigV4InvalidParameter;
-    SigV4DateTime_t date = { 0 };
-    char * pWriteLoc = pDateISO8601;
-    const char * pFormatStr = NULL;
-    size_t formatLen = 0U;
+    SigV4CredentialSlot_t * pSlot = NULL;
+    uint32_t epoch = 0U;
+    uint64_t expirationTime = 0U;
 
-    /* Check for NULL parameters. */
-    if( pDate == NULL )
+    if( ( pStore == NULL ) || ( pCredentials == NULL ) )
     {
-        LogError( ( "Parameter check failed: pDate is NULL." ) );
+        LogError( ( "Parameter check failed: pStore and pCredentials must not be NULL." ) );
     }
-    else if( pDateISO8601 == NULL )
+    else if( ( pCredentials->pAccessKeyId == NULL ) || ( pCredentials->accessKeyLen == 0U ) ||
+             ( pCredentials->pSecretAccessKey == NULL ) || ( pCredentials->secretAccessKeyLen == 0U ) )
     {
-        LogError( ( "Parameter check failed: pDateISO8601 is NULL." ) );
+        LogError( ( "Parameter check failed: The access key ID and secret access key must not be empty." ) );
     }
-    /* Check that the date provided is of the expected length. */
-    else if( ( dateLen != SIGV4_EXPECTED_LEN_RFC_3339 ) &&
-             ( dateLen != SIGV4_EXPECTED_LEN_RFC_5322 ) )
+    else
     {
-        LogError( ( "Parameter check failed: dateLen must be either %u or %u, "
-                    "for RFC 3339 and RFC 5322 formats, respectively.",
-                    SIGV4_EXPECTED_LEN_RFC_3339,
-                    SIGV4_EXPECTED_LEN_RFC_5322 ) );
+        returnStatus = parseExpirationTime( pCredentials->pExpiration,
+                                            pCredentials->expirationLen,
+                                            &expirationTime );
     }
 
-    /* Check that the output buffer provided is large enough for the formatted
-     * string. */
-    else if( dateISO8601Len < SIGV4_ISO_STRING_LEN )
+    if( returnStatus == SigV4Success )
     {
-        LogError( ( "Parameter check failed: dateISO8601Len must be at least %u.",
-                    SIGV4_ISO_STRING_LEN ) );
+        /* Only this task changes the epoch. At one rotation per second, it
+         * does not wrap around for more than a century. */
+        epoch = pStore->epoch;
+        pSlot = &pStore->pSlots[ ( epoch + 1U ) % SIGV4_CREDENTIAL_STORE_SLOT_COUNT ];
+
+        /* The slot was published at epoch - 1. A task that acquired it then
+         * may still use it. A task that reads an older epoch may count itself
+         * in briefly, but it sees that the epoch changed and leaves without
+         * reading the slot. Both this read and the task's check of the epoch
+         * are sequentially consistent, so they cannot both miss the other
+         * task's increment. */
+        if( SIGV4_ATOMIC_LOAD_SEQ_CST_U32( &pSlot->readerCount ) != 0U )
+        {
+            LogDebug( ( "The credentials published before the current ones are still in use." ) );
+            returnStatus = SigV4CredentialsInUse;
+        }
+        else
+        {
+            returnStatus = copyCredentials( pSlot, pCredentials );
+        }
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        pSlot->credentials.expirationTime = expirationTime;
+        SIGV4_ATOMIC_INCREMENT_U32( &pStore->epoch );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_CredentialStoreAcquire( SigV4CredentialStore_t * pStore,
+                                            SigV4Credentials_t ** pCredentials )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4CredentialSlot_t * pSlot = NULL;
+    uint32_t epoch = 0U;
+
+    if( ( pStore == NULL ) || ( pCredentials == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pStore and pCredentials must not be NULL." ) );
     }
     else
     {
-        /* Assign format string according to input type received. */
-        pFormatStr = ( dateLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
-                     ( FORMAT_RFC_3339 ) : ( FORMAT_RFC_5322 );
+        epoch = SIGV4_ATOMIC_LOAD_U32( &pStore->epoch );
+        returnStatus = SigV4CredentialsUnavailable;
+    }
 
-        formatLen = ( dateLen == SIGV4_EXPECTED_LEN_RFC_3339 ) ?
-                    ( FORMAT_RFC_3339_LEN ) : ( FORMAT_RFC_5322_LEN );
+    /* The slot of the epoch is counted in before it is used. If the epoch
+     * changed in the meantime, the slot may be about to be written, so the
+     * count is given back and the new epoch is tried. */
+    while( ( returnStatus == SigV4CredentialsUnavailable ) && ( epoch != 0U ) )
+    {
+        pSlot = &pStore->pSlots[ epoch % SIGV4_CREDENTIAL_STORE_SLOT_COUNT ];
+        SIGV4_ATOMIC_INCREMENT_U32( &pSlot->readerCount );
 
-        returnStatus = parseDate( pDate, dateLen, pFormatStr, formatLen, &date );
+        if( SIGV4_ATOMIC_LOAD_SEQ_CST_U32( &pStore->epoch ) == epoch )
+        {
+            *pCredentials = &pSlot->credentials;
+            returnStatus = SigV4Success;
+        }
+        else
+        {
+            SIGV4_ATOMIC_DECREMENT_U32( &pSlot->readerCount );
+            epoch = SIGV4_ATOMIC_LOAD_U32( &pStore->epoch );
+        }
     }
 
-    if( returnStatus == SigV4Success )
+    if( returnStatus == SigV4CredentialsUnavailable )
     {
-        returnStatus = validateDateTime( &date );
+        LogDebug( ( "No credentials were published to the credential store." ) );
     }
 
-    if( returnStatus == SigV4Success )
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_CredentialStoreRelease( SigV4CredentialStore_t * pStore,
+                                            const SigV4Credentials_t * pCredentials )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4CredentialSlot_t * pSlot = NULL;
+    size_t i = 0U;
+
+    if( ( pStore == NULL ) || ( pCredentials == NULL ) )
     {
-        /* Combine date elements into complete ASCII representation, and fill
-         * buffer with result. */
-        intToAscii( date.tm_year, &pWriteLoc, ISO_YEAR_LEN );
-        intToAscii( date.tm_mon, &pWriteLoc, ISO_NON_YEAR_LEN );
-        intToAscii( date.tm_mday, &pWriteLoc, ISO_NON_YEAR_LEN );
-        *pWriteLoc = 'T';
-        pWriteLoc++;
-        intToAscii( date.tm_hour, &pWriteLoc, ISO_NON_YEAR_LEN );
-        intToAscii( date.tm_min, &pWriteLoc, ISO_NON_YEAR_LEN );
-        intToAscii( date.tm_sec, &pWriteLoc, ISO_NON_YEAR_LEN );
-        *pWriteLoc = 'Z';
+        LogError( ( "Parameter check failed: pStore and pCredentials must not be NULL." ) );
+    }
+    else
+    {
+        for( i = 0U; i < SIGV4_CREDENTIAL_STORE_SLOT_COUNT; i++ )
+        {
+            if( pCredentials == &pStore->pSlots[ i ].credentials )
+            {
+                pSlot = &pStore->pSlots[ i ];
+            }
+        }
+    }
 
-        LogDebug( ( "Successfully formatted ISO 8601 date: \"%.*s\"",
-                    ( int ) dateISO8601Len,
-                    pDateISO8601 ) );
+    if( ( pSlot == NULL ) || ( SIGV4_ATOMIC_LOAD_U32( &pSlot->readerCount ) == 0U ) )
+    {
+        LogError( ( "Parameter check failed: pCredentials were not acquired from pStore." ) );
+    }
+    else
+    {
+        SIGV4_ATOMIC_DECREMENT_U32( &pSlot->readerCount );
+        returnStatus = SigV4Success;
     }
 
     return returnStatus;
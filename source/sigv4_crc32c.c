@@ -0,0 +1,462 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file sigv4_crc32c.c
+ * @brief Implements the optional CRC32C functions in sigv4_crc32c.h
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "sigv4_crc32c.h"
+
+/* The SSE4.2 crc32 and PCLMUL instructions are used through compiler
+ * intrinsics, which are enabled per function with the target attribute of
+ * GCC and Clang. The 64-bit crc32 instruction needs x86-64. */
+#if defined( __x86_64__ ) && ( SIGV4_CRC32C_USE_SSE42 == 1 ) && \
+    ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 7 ) ) )
+    #define CRC32C_SSE42_SUPPORTED    1
+#else
+    #define CRC32C_SSE42_SUPPORTED    0
+#endif
+
+#if ( CRC32C_SSE42_SUPPORTED == 1 )
+    #include <cpuid.h>
+    #include <immintrin.h>
+#endif
+
+#define CRC32C_INITIAL_VALUE        0xFFFFFFFFUL /**< Initial value of the CRC register, which is also XOR-ed into the result. */
+#define CRC32C_LANE_LENGTH          1024U        /**< Bytes of each of the three interleaved lanes of the SSE4.2 implementation. */
+#define CRC32C_SHIFT_LANE           0x170076faUL /**< x^(8 * 1024 - 33) mod P, reflected, to shift a CRC over one lane. */
+#define CRC32C_SHIFT_TWO_LANES      0xa51b6135UL /**< x^(8 * 2048 - 33) mod P, reflected, to shift a CRC over two lanes. */
+
+#define CHUNK_LINE_TERMINATOR       "\r\n"                   /**< Ends the chunk header, and the trailer. */
+#define CHUNK_LINE_TERMINATOR_LEN   ( sizeof( CHUNK_LINE_TERMINATOR ) - 1U ) /**< Length of #CHUNK_LINE_TERMINATOR. */
+#define CRC32C_TRAILER_PREFIX       "0\r\n" SIGV4_HTTP_X_AMZ_CHECKSUM_CRC32C_HEADER ":" /**< The final chunk and the name of the checksum trailer. */
+#define CRC32C_TRAILER_PREFIX_LEN   ( sizeof( CRC32C_TRAILER_PREFIX ) - 1U ) /**< Length of #CRC32C_TRAILER_PREFIX. */
+#define CRC32C_BASE64_LEN           8U           /**< Length of a base64 encoded checksum, with its padding. */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The CRC32C table for the reflected polynomial 0x82f63b78, giving
+ * the CRC of each byte value.
+ */
+static const uint32_t crc32cTable[ 256 ] =
+{
+    0x00000000UL, 0xf26b8303UL, 0xe13b70f7UL, 0x1350f3f4UL, 0xc79a971fUL, 0x35f1141cUL, 0x26a1e7e8UL, 0xd4ca64ebUL,
+    0x8ad958cfUL, 0x78b2dbccUL, 0x6be22838UL, 0x9989ab3bUL, 0x4d43cfd0UL, 0xbf284cd3UL, 0xac78bf27UL, 0x5e133c24UL,
+    0x105ec76fUL, 0xe235446cUL, 0xf165b798UL, 0x030e349bUL, 0xd7c45070UL, 0x25afd373UL, 0x36ff2087UL, 0xc494a384UL,
+    0x9a879fa0UL, 0x68ec1ca3UL, 0x7bbcef57UL, 0x89d76c54UL, 0x5d1d08bfUL, 0xaf768bbcUL, 0xbc267848UL, 0x4e4dfb4bUL,
+    0x20bd8edeUL, 0xd2d60dddUL, 0xc186fe29UL, 0x33ed7d2aUL, 0xe72719c1UL, 0x154c9ac2UL, 0x061c6936UL, 0xf477ea35UL,
+    0xaa64d611UL, 0x580f5512UL, 0x4b5fa6e6UL, 0xb93425e5UL, 0x6dfe410eUL, 0x9f95c20dUL, 0x8cc531f9UL, 0x7eaeb2faUL,
+    0x30e349b1UL, 0xc288cab2UL, 0xd1d83946UL, 0x23b3ba45UL, 0xf779deaeUL, 0x05125dadUL, 0x1642ae59UL, 0xe4292d5aUL,
+    0xba3a117eUL, 0x4851927dUL, 0x5b016189UL, 0xa96ae28aUL, 0x7da08661UL, 0x8fcb0562UL, 0x9c9bf696UL, 0x6ef07595UL,
+    0x417b1dbcUL, 0xb3109ebfUL, 0xa0406d4bUL, 0x522bee48UL, 0x86e18aa3UL, 0x748a09a0UL, 0x67dafa54UL, 0x95b17957UL,
+    0xcba24573UL, 0x39c9c670UL, 0x2a993584UL, 0xd8f2b687UL, 0x0c38d26cUL, 0xfe53516fUL, 0xed03a29bUL, 0x1f682198UL,
+    0x5125dad3UL, 0xa34e59d0UL, 0xb01eaa24UL, 0x42752927UL, 0x96bf4dccUL, 0x64d4cecfUL, 0x77843d3bUL, 0x85efbe38UL,
+    0xdbfc821cUL, 0x2997011fUL, 0x3ac7f2ebUL, 0xc8ac71e8UL, 0x1c661503UL, 0xee0d9600UL, 0xfd5d65f4UL, 0x0f36e6f7UL,
+    0x61c69362UL, 0x93ad1061UL, 0x80fde395UL, 0x72966096UL, 0xa65c047dUL, 0x5437877eUL, 0x4767748aUL, 0xb50cf789UL,
+    0xeb1fcbadUL, 0x197448aeUL, 0x0a24bb5aUL, 0xf84f3859UL, 0x2c855cb2UL, 0xdeeedfb1UL, 0xcdbe2c45UL, 0x3fd5af46UL,
+    0x7198540dUL, 0x83f3d70eUL, 0x90a324faUL, 0x62c8a7f9UL, 0xb602c312UL, 0x44694011UL, 0x5739b3e5UL, 0xa55230e6UL,
+    0xfb410cc2UL, 0x092a8fc1UL, 0x1a7a7c35UL, 0xe811ff36UL, 0x3cdb9bddUL, 0xceb018deUL, 0xdde0eb2aUL, 0x2f8b6829UL,
+    0x82f63b78UL, 0x709db87bUL, 0x63cd4b8fUL, 0x91a6c88cUL, 0x456cac67UL, 0xb7072f64UL, 0xa457dc90UL, 0x563c5f93UL,
+    0x082f63b7UL, 0xfa44e0b4UL, 0xe9141340UL, 0x1b7f9043UL, 0xcfb5f4a8UL, 0x3dde77abUL, 0x2e8e845fUL, 0xdce5075cUL,
+    0x92a8fc17UL, 0x60c37f14UL, 0x73938ce0UL, 0x81f80fe3UL, 0x55326b08UL, 0xa759e80bUL, 0xb4091bffUL, 0x466298fcUL,
+    0x1871a4d8UL, 0xea1a27dbUL, 0xf94ad42fUL, 0x0b21572cUL, 0xdfeb33c7UL, 0x2d80b0c4UL, 0x3ed04330UL, 0xccbbc033UL,
+    0xa24bb5a6UL, 0x502036a5UL, 0x4370c551UL, 0xb11b4652UL, 0x65d122b9UL, 0x97baa1baUL, 0x84ea524eUL, 0x7681d14dUL,
+    0x2892ed69UL, 0xdaf96e6aUL, 0xc9a99d9eUL, 0x3bc21e9dUL, 0xef087a76UL, 0x1d63f975UL, 0x0e330a81UL, 0xfc588982UL,
+    0xb21572c9UL, 0x407ef1caUL, 0x532e023eUL, 0xa145813dUL, 0x758fe5d6UL, 0x87e466d5UL, 0x94b49521UL, 0x66df1622UL,
+    0x38cc2a06UL, 0xcaa7a905UL, 0xd9f75af1UL, 0x2b9cd9f2UL, 0xff56bd19UL, 0x0d3d3e1aUL, 0x1e6dcdeeUL, 0xec064eedUL,
+    0xc38d26c4UL, 0x31e6a5c7UL, 0x22b65633UL, 0xd0ddd530UL, 0x0417b1dbUL, 0xf67c32d8UL, 0xe52cc12cUL, 0x1747422fUL,
+    0x49547e0bUL, 0xbb3ffd08UL, 0xa86f0efcUL, 0x5a048dffUL, 0x8ecee914UL, 0x7ca56a17UL, 0x6ff599e3UL, 0x9d9e1ae0UL,
+    0xd3d3e1abUL, 0x21b862a8UL, 0x32e8915cUL, 0xc083125fUL, 0x144976b4UL, 0xe622f5b7UL, 0xf5720643UL, 0x07198540UL,
+    0x590ab964UL, 0xab613a67UL, 0xb831c993UL, 0x4a5a4a90UL, 0x9e902e7bUL, 0x6cfbad78UL, 0x7fab5e8cUL, 0x8dc0dd8fUL,
+    0xe330a81aUL, 0x115b2b19UL, 0x020bd8edUL, 0xf0605beeUL, 0x24aa3f05UL, 0xd6c1bc06UL, 0xc5914ff2UL, 0x37faccf1UL,
+    0x69e9f0d5UL, 0x9b8273d6UL, 0x88d28022UL, 0x7ab90321UL, 0xae7367caUL, 0x5c18e4c9UL, 0x4f48173dUL, 0xbd23943eUL,
+    0xf36e6f75UL, 0x0105ec76UL, 0x12551f82UL, 0xe03e9c81UL, 0x34f4f86aUL, 0xc69f7b69UL, 0xd5cf889dUL, 0x27a40b9eUL,
+    0x79b737baUL, 0x8bdcb4b9UL, 0x988c474dUL, 0x6ae7c44eUL, 0xbe2da0a5UL, 0x4c4623a6UL, 0x5f16d052UL, 0xad7d5351UL
+};
+
+/**
+ * @brief Update a CRC register in portable C, a byte at a time.
+ *
+ * @param[in] crc The CRC register.
+ * @param[in] pData The data.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return The updated CRC register.
+ */
+static uint32_t updateBytes( uint32_t crc,
+                             const uint8_t * pData,
+                             size_t dataLen );
+
+#if ( CRC32C_SSE42_SUPPORTED == 1 )
+
+/**
+ * @brief Shift a CRC register over a run of zero bytes, with a carry-less
+ * multiplication by a precomputed power of x.
+ *
+ * @param[in] crc The CRC register.
+ * @param[in] shiftConstant x^(8n - 33) mod P, reflected, to shift over n
+ * bytes.
+ *
+ * @return The shifted CRC register.
+ */
+    static uint32_t shiftSse42( uint32_t crc,
+                                uint32_t shiftConstant ) __attribute__( ( target( "sse4.2,pclmul" ) ) );
+
+/**
+ * @brief Update a CRC register with the SSE4.2 crc32 instruction.
+ *
+ * Blocks of three lanes are checksummed together to hide the latency of the
+ * instruction, and their CRCs are combined with #shiftSse42.
+ *
+ * @param[in] crc The CRC register.
+ * @param[in] pData The data.
+ * @param[in] dataLen Length of @p pData.
+ *
+ * @return The updated CRC register.
+ */
+    static uint32_t updateSse42( uint32_t crc,
+                                 const uint8_t * pData,
+                                 size_t dataLen ) __attribute__( ( target( "sse4.2,pclmul" ) ) );
+
+#endif /* #if ( CRC32C_SSE42_SUPPORTED == 1 ) */
+
+/**
+ * @brief Check whether the processor supports SSE4.2 and PCLMUL.
+ *
+ * @return 1 if they can be used, 0 otherwise.
+ */
+static uint8_t detectSse42( void );
+
+/**
+ * @brief Write a chunk size in hex, without leading zeros.
+ *
+ * @param[in] chunkLen The chunk size.
+ * @param[out] pBuffer The buffer, or NULL to only count the digits.
+ *
+ * @return The number of digits.
+ */
+static size_t writeChunkSize( size_t chunkLen,
+                              char * pBuffer );
+
+/*-----------------------------------------------------------*/
+
+static uint32_t updateBytes( uint32_t crc,
+                             const uint8_t * pData,
+                             size_t dataLen )
+{
+    uint32_t value = crc;
+    size_t i = 0U;
+
+    assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+    for( i = 0U; i < dataLen; i++ )
+    {
+        value = crc32cTable[ ( value ^ pData[ i ] ) & 0xFFU ] ^ ( value >> 8 );
+    }
+
+    return value;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CRC32C_SSE42_SUPPORTED == 1 )
+
+    static uint32_t shiftSse42( uint32_t crc,
+                                uint32_t shiftConstant )
+    {
+        __m128i product;
+
+        /* The product of two reflected 32-bit values is the reflected
+         * product times x. The crc32 instruction then multiplies it by x^32
+         * and reduces it modulo P. */
+        product = _mm_clmulepi64_si128( _mm_cvtsi32_si128( ( int ) crc ),
+                                        _mm_cvtsi32_si128( ( int ) shiftConstant ),
+                                        0x00 );
+
+        return ( uint32_t ) _mm_crc32_u64( 0U, ( uint64_t ) _mm_cvtsi128_si64( product ) );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint32_t updateSse42( uint32_t crc,
+                                 const uint8_t * pData,
+                                 size_t dataLen )
+    {
+        uint64_t crcA = crc, crcB = 0U, crcC = 0U, word = 0U;
+        const uint8_t * pNext = pData;
+        size_t remaining = dataLen, i = 0U;
+
+        assert( ( pData != NULL ) || ( dataLen == 0U ) );
+
+        while( remaining >= ( 3U * CRC32C_LANE_LENGTH ) )
+        {
+            crcB = 0U;
+            crcC = 0U;
+
+            for( i = 0U; i < CRC32C_LANE_LENGTH; i += sizeof( word ) )
+            {
+                ( void ) memcpy( &word, &pNext[ i ], sizeof( word ) );
+                crcA = _mm_crc32_u64( crcA, word );
+                ( void ) memcpy( &word, &pNext[ CRC32C_LANE_LENGTH + i ], sizeof( word ) );
+                crcB = _mm_crc32_u64( crcB, word );
+                ( void ) memcpy( &word, &pNext[ ( 2U * CRC32C_LANE_LENGTH ) + i ], sizeof( word ) );
+                crcC = _mm_crc32_u64( crcC, word );
+            }
+
+            crcA = ( uint64_t ) ( shiftSse42( ( uint32_t ) crcA, CRC32C_SHIFT_TWO_LANES ) ^
+                                  shiftSse42( ( uint32_t ) crcB, CRC32C_SHIFT_LANE ) ^
+                                  ( uint32_t ) crcC );
+            pNext = &pNext[ 3U * CRC32C_LANE_LENGTH ];
+            remaining -= 3U * CRC32C_LANE_LENGTH;
+        }
+
+        while( remaining >= sizeof( word ) )
+        {
+            ( void ) memcpy( &word, pNext, sizeof( word ) );
+            crcA = _mm_crc32_u64( crcA, word );
+            pNext = &pNext[ sizeof( word ) ];
+            remaining -= sizeof( word );
+        }
+
+        for( i = 0U; i < remaining; i++ )
+        {
+            crcA = _mm_crc32_u8( ( uint32_t ) crcA, pNext[ i ] );
+        }
+
+        return ( uint32_t ) crcA;
+    }
+
+#endif /* #if ( CRC32C_SSE42_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+static uint8_t detectSse42( void )
+{
+    uint8_t useSse42 = 0U;
+
+    #if ( CRC32C_SSE42_SUPPORTED == 1 )
+        unsigned int eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+
+        if( ( __get_cpuid( 1U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+            ( ( ecx & bit_SSE4_2 ) != 0U ) && ( ( ecx & bit_PCLMUL ) != 0U ) )
+        {
+            useSse42 = 1U;
+        }
+    #endif
+
+    return useSse42;
+}
+
+/*-----------------------------------------------------------*/
+
+static size_t writeChunkSize( size_t chunkLen,
+                              char * pBuffer )
+{
+    static const char pHexDigits[] = "0123456789abcdef";
+    size_t digitCount = 1U, i = 0U, remaining = chunkLen >> 4;
+
+    while( remaining > 0U )
+    {
+        digitCount++;
+        remaining >>= 4;
+    }
+
+    if( pBuffer != NULL )
+    {
+        remaining = chunkLen;
+
+        for( i = digitCount; i > 0U; i-- )
+        {
+            pBuffer[ i - 1U ] = pHexDigits[ remaining & 0xFU ];
+            remaining >>= 4;
+        }
+    }
+
+    return digitCount;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Crc32cInit( SigV4Crc32c_t * pCrc32c )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    if( pCrc32c == NULL )
+    {
+        LogError( ( "Parameter check failed: pCrc32c is NULL." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        pCrc32c->crc = CRC32C_INITIAL_VALUE;
+        pCrc32c->useSse42 = detectSse42();
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Crc32cUpdate( SigV4Crc32c_t * pCrc32c,
+                                  const uint8_t * pData,
+                                  size_t dataLen )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    if( ( pCrc32c == NULL ) || ( ( pData == NULL ) && ( dataLen > 0U ) ) )
+    {
+        LogError( ( "Parameter check failed: pCrc32c must not be NULL, and pData may only "
+                    "be NULL if dataLen is zero." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+
+    #if ( CRC32C_SSE42_SUPPORTED == 1 )
+        else if( pCrc32c->useSse42 == 1U )
+        {
+            pCrc32c->crc = updateSse42( pCrc32c->crc, pData, dataLen );
+        }
+    #endif
+    else
+    {
+        pCrc32c->crc = updateBytes( pCrc32c->crc, pData, dataLen );
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Crc32cFinal( const SigV4Crc32c_t * pCrc32c,
+                                 uint32_t * pChecksum )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    if( ( pCrc32c == NULL ) || ( pChecksum == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pCrc32c and pChecksum must not be NULL." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        *pChecksum = pCrc32c->crc ^ CRC32C_INITIAL_VALUE;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Crc32cChunkHeader( SigV4Crc32c_t * pCrc32c,
+                                       const char * pChunk,
+                                       size_t chunkLen,
+                                       char * pHeaderBuf,
+                                       size_t * pHeaderBufLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    size_t digitCount = 0U;
+
+    if( ( pCrc32c == NULL ) || ( pChunk == NULL ) || ( chunkLen == 0U ) ||
+        ( pHeaderBuf == NULL ) || ( pHeaderBufLen == NULL ) )
+    {
+        LogError( ( "Parameter check failed: The parameters must not be NULL, and chunkLen "
+                    "must not be zero, as SigV4_Crc32cTrailer() writes the final chunk." ) );
+    }
+    else
+    {
+        digitCount = writeChunkSize( chunkLen, NULL );
+
+        if( *pHeaderBufLen < ( digitCount + CHUNK_LINE_TERMINATOR_LEN ) )
+        {
+            LogError( ( "Insufficient memory for the chunk header: %lu bytes are needed.",
+                        ( unsigned long ) ( digitCount + CHUNK_LINE_TERMINATOR_LEN ) ) );
+            returnStatus = SigV4InsufficientMemory;
+        }
+        else
+        {
+            returnStatus = SigV4_Crc32cUpdate( pCrc32c, ( const uint8_t * ) pChunk, chunkLen );
+        }
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) writeChunkSize( chunkLen, pHeaderBuf );
+        ( void ) memcpy( &pHeaderBuf[ digitCount ], CHUNK_LINE_TERMINATOR, CHUNK_LINE_TERMINATOR_LEN );
+        *pHeaderBufLen = digitCount + CHUNK_LINE_TERMINATOR_LEN;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Crc32cTrailer( const SigV4Crc32c_t * pCrc32c,
+                                   char * pTrailerBuf,
+                                   size_t trailerBufLen )
+{
+    static const char pBase64Digits[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    uint32_t checksum = 0U;
+    char * pBase64 = NULL;
+
+    if( ( pCrc32c == NULL ) || ( pTrailerBuf == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pCrc32c and pTrailerBuf must not be NULL." ) );
+    }
+    else if( trailerBufLen < SIGV4_CRC32C_TRAILER_LENGTH )
+    {
+        LogError( ( "Insufficient memory: The trailer needs %lu bytes: trailerBufLen=%lu.",
+                    ( unsigned long ) SIGV4_CRC32C_TRAILER_LENGTH,
+                    ( unsigned long ) trailerBufLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        returnStatus = SigV4_Crc32cFinal( pCrc32c, &checksum );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        ( void ) memcpy( pTrailerBuf, CRC32C_TRAILER_PREFIX, CRC32C_TRAILER_PREFIX_LEN );
+        pBase64 = &pTrailerBuf[ CRC32C_TRAILER_PREFIX_LEN ];
+
+        /* The four big-endian bytes of the checksum are encoded as six 6-bit
+         * digits, the last holding two bits, and two padding characters. */
+        pBase64[ 0 ] = pBase64Digits[ ( checksum >> 26 ) & 0x3FU ];
+        pBase64[ 1 ] = pBase64Digits[ ( checksum >> 20 ) & 0x3FU ];
+        pBase64[ 2 ] = pBase64Digits[ ( checksum >> 14 ) & 0x3FU ];
+        pBase64[ 3 ] = pBase64Digits[ ( checksum >> 8 ) & 0x3FU ];
+        pBase64[ 4 ] = pBase64Digits[ ( checksum >> 2 ) & 0x3FU ];
+        pBase64[ 5 ] = pBase64Digits[ ( checksum << 4 ) & 0x30U ];
+        pBase64[ 6 ] = '=';
+        pBase64[ 7 ] = '=';
+
+        ( void ) memcpy( &pBase64[ CRC32C_BASE64_LEN ], CHUNK_LINE_TERMINATOR CHUNK_LINE_TERMINATOR, 2U * CHUNK_LINE_TERMINATOR_LEN );
+    }
+
+    return returnStatus;
+}
@@ -0,0 +1,175 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+
+/**
+ * @file sigv4_file.c
+ * @brief Implements the optional POSIX file hashing function in sigv4_file.h
+ */
+
+/* The file is mapped with the POSIX.1-2001 interfaces, which are not
+ * declared by the C90 headers alone. */
+#ifndef _POSIX_C_SOURCE
+    #define _POSIX_C_SOURCE    200112L
+#endif
+
+#include <assert.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "sigv4_file.h"
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Hash a file one mapped window at a time.
+ *
+ * @param[in] fileDescriptor The open file.
+ * @param[in] fileLen The length of the file.
+ * @param[in, out] pPayloadHash The payload hash in progress.
+ *
+ * @return #SigV4Success if successful, #SigV4FileError if a window could not
+ * be mapped, #SigV4HashError if the hash failed.
+ */
+static SigV4Status_t hashMappedFile( int fileDescriptor,
+                                     uint64_t fileLen,
+                                     SigV4PayloadHash_t * pPayloadHash );
+
+/*-----------------------------------------------------------*/
+
+static SigV4Status_t hashMappedFile( int fileDescriptor,
+                                     uint64_t fileLen,
+                                     SigV4PayloadHash_t * pPayloadHash )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+    uint64_t offset = 0U;
+    size_t windowLen = 0U;
+    void * pWindow = NULL;
+
+    assert( pPayloadHash != NULL );
+
+    /* The advice only tunes readahead, so its failure is not an error. */
+    ( void ) posix_fadvise( fileDescriptor, 0, 0, POSIX_FADV_SEQUENTIAL );
+
+    for( offset = 0U; ( offset < fileLen ) && ( returnStatus == SigV4Success ); offset += windowLen )
+    {
+        windowLen = ( ( fileLen - offset ) < SIGV4_FILE_MAP_WINDOW_LENGTH ) ?
+                    ( size_t ) ( fileLen - offset ) : ( size_t ) SIGV4_FILE_MAP_WINDOW_LENGTH;
+
+        pWindow = mmap( NULL, windowLen, PROT_READ, MAP_PRIVATE, fileDescriptor, ( off_t ) offset );
+
+        if( pWindow == MAP_FAILED )
+        {
+            LogError( ( "Failed to map %lu bytes of the file at offset %lu.",
+                        ( unsigned long ) windowLen,
+                        ( unsigned long ) offset ) );
+            returnStatus = SigV4FileError;
+        }
+        else
+        {
+            ( void ) posix_madvise( pWindow, windowLen, POSIX_MADV_SEQUENTIAL );
+
+            /* Read the next window ahead while this one is hashed. */
+            if( ( fileLen - offset ) > windowLen )
+            {
+                ( void ) posix_fadvise( fileDescriptor,
+                                        ( off_t ) ( offset + windowLen ),
+                                        ( off_t ) SIGV4_FILE_MAP_WINDOW_LENGTH,
+                                        POSIX_FADV_WILLNEED );
+            }
+
+            returnStatus = SigV4_PayloadHashUpdate( pPayloadHash, ( const char * ) pWindow, windowLen );
+            ( void ) munmap( pWindow, windowLen );
+        }
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_HashFile( const SigV4CryptoInterface_t * pCryptoInterface,
+                              const char * pFilePath,
+                              char * pHexPayloadHash,
+                              size_t hexPayloadHashLen,
+                              uint64_t * pFileLen )
+{
+    SigV4Status_t returnStatus = SigV4InvalidParameter;
+    SigV4PayloadHash_t payloadHash;
+    struct stat fileStatus;
+    int fileDescriptor = -1;
+
+    if( ( pFilePath == NULL ) || ( pHexPayloadHash == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pFilePath and pHexPayloadHash must not be NULL." ) );
+    }
+    else if( hexPayloadHashLen < SIGV4_HEX_PAYLOAD_HASH_LENGTH )
+    {
+        LogError( ( "Insufficient memory: The payload hash needs %lu bytes: hexPayloadHashLen=%lu.",
+                    ( unsigned long ) SIGV4_HEX_PAYLOAD_HASH_LENGTH,
+                    ( unsigned long ) hexPayloadHashLen ) );
+        returnStatus = SigV4InsufficientMemory;
+    }
+    else
+    {
+        returnStatus = SigV4_PayloadHashInit( &payloadHash, pCryptoInterface );
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        fileDescriptor = open( pFilePath, O_RDONLY );
+
+        if( fileDescriptor < 0 )
+        {
+            LogError( ( "Failed to open the file %s.", pFilePath ) );
+            returnStatus = SigV4FileError;
+        }
+        else if( ( fstat( fileDescriptor, &fileStatus ) != 0 ) || !S_ISREG( fileStatus.st_mode ) )
+        {
+            LogError( ( "The file %s is not a regular file.", pFilePath ) );
+            returnStatus = SigV4FileError;
+        }
+        else
+        {
+            returnStatus = hashMappedFile( fileDescriptor, ( uint64_t ) fileStatus.st_size, &payloadHash );
+        }
+
+        if( fileDescriptor >= 0 )
+        {
+            ( void ) close( fileDescriptor );
+        }
+    }
+
+    if( returnStatus == SigV4Success )
+    {
+        returnStatus = SigV4_PayloadHashFinal( &payloadHash, pHexPayloadHash, hexPayloadHashLen );
+    }
+
+    if( ( returnStatus == SigV4Success ) && ( pFileLen != NULL ) )
+    {
+        *pFileLen = payloadHash.payloadLen;
+    }
+
+    return returnStatus;
+}
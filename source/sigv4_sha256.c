@@ -0,0 +1,825 @@
+/*
+ * SigV4 Utility Library v1.0.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+/**
+ * @file sigv4_sha256.c
+ * @brief Implements the optional SHA-256 functions in sigv4_sha256.h
+ */
+
+#include <assert.h>
+#include <string.h>
+
+#include "sigv4_sha256.h"
+
+/* The x86 SHA extensions and AVX2 are used through compiler intrinsics, which
+ * are enabled per function with the target attribute of GCC and Clang. */
+#if ( defined( __x86_64__ ) || defined( __i386__ ) ) && \
+    ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( __GNUC__ >= 7 ) ) )
+    #define SHA256_X86_INTRINSICS    1
+#else
+    #define SHA256_X86_INTRINSICS    0
+#endif
+
+#if ( SHA256_X86_INTRINSICS == 1 ) && ( SIGV4_SHA256_USE_SHA_NI == 1 )
+    #define SHA256_SHA_NI_SUPPORTED    1
+#else
+    #define SHA256_SHA_NI_SUPPORTED    0
+#endif
+
+#if ( SHA256_X86_INTRINSICS == 1 ) && ( SIGV4_SHA256_USE_AVX2 == 1 )
+    #define SHA256_AVX2_SUPPORTED    1
+#else
+    #define SHA256_AVX2_SUPPORTED    0
+#endif
+
+#if ( SHA256_SHA_NI_SUPPORTED == 1 ) || ( SHA256_AVX2_SUPPORTED == 1 )
+    #include <cpuid.h>
+    #include <immintrin.h>
+#endif
+
+#define SHA256_LENGTH_OFFSET       56U /**< Offset of the message bit length in the last block. */
+#define SHA256_PADDING_START       0x80U /**< The byte appended to the message before the padding zeros. */
+#define SHA256_LANE_COUNT          8U    /**< Number of messages hashed together with AVX2. */
+#define SHA256_XCR0_AVX_STATE      0x6U  /**< XCR0 bits of the SSE and AVX registers, saved by the OS. */
+
+/* The functions of FIPS 180-4, section 4.1.2. */
+#define SHA256_ROTR( x, n )        ( ( ( x ) >> ( n ) ) | ( ( x ) << ( 32U - ( n ) ) ) )
+#define SHA256_CH( x, y, z )       ( ( ( x ) & ( y ) ) ^ ( ~( x ) & ( z ) ) )
+#define SHA256_MAJ( x, y, z )      ( ( ( x ) & ( y ) ) ^ ( ( x ) & ( z ) ) ^ ( ( y ) & ( z ) ) )
+#define SHA256_BSIG0( x )          ( SHA256_ROTR( x, 2U ) ^ SHA256_ROTR( x, 13U ) ^ SHA256_ROTR( x, 22U ) )
+#define SHA256_BSIG1( x )          ( SHA256_ROTR( x, 6U ) ^ SHA256_ROTR( x, 11U ) ^ SHA256_ROTR( x, 25U ) )
+#define SHA256_SSIG0( x )          ( SHA256_ROTR( x, 7U ) ^ SHA256_ROTR( x, 18U ) ^ ( ( x ) >> 3U ) )
+#define SHA256_SSIG1( x )          ( SHA256_ROTR( x, 17U ) ^ SHA256_ROTR( x, 19U ) ^ ( ( x ) >> 10U ) )
+
+/**
+ * @brief One round of the SHA-256 compression function.
+ *
+ * The message schedule is kept in a rolling window of 16 words, and is
+ * extended as the rounds consume it. Rather than moving the working
+ * variables after each round, the caller rotates their names.
+ */
+#define SHA256_ROUND( a, b, c, d, e, f, g, h, w, t )                                 \
+    do {                                                                             \
+        uint32_t temp;                                                               \
+        if( ( t ) >= 16U )                                                           \
+        {                                                                            \
+            ( w )[ ( t ) & 15U ] += SHA256_SSIG1( ( w )[ ( ( t ) - 2U ) & 15U ] ) +  \
+                                    ( w )[ ( ( t ) - 7U ) & 15U ] +                  \
+                                    SHA256_SSIG0( ( w )[ ( ( t ) - 15U ) & 15U ] );  \
+        }                                                                            \
+        temp = ( h ) + SHA256_BSIG1( e ) + SHA256_CH( e, f, g ) + sha256K[ t ] +     \
+               ( w )[ ( t ) & 15U ];                                                 \
+        ( d ) += temp;                                                               \
+        ( h ) = temp + SHA256_BSIG0( a ) + SHA256_MAJ( a, b, c );                    \
+    } while( 0 )
+
+#if ( SHA256_AVX2_SUPPORTED == 1 )
+
+/* The functions of FIPS 180-4, section 4.1.2, on eight lanes of 32-bit words. */
+    #define SHA256_LANE_ROTR( x, n )        _mm256_or_si256( _mm256_srli_epi32( x, n ), _mm256_slli_epi32( x, 32 - ( n ) ) )
+    #define SHA256_LANE_CH( x, y, z )       _mm256_xor_si256( _mm256_and_si256( x, y ), _mm256_andnot_si256( x, z ) )
+    #define SHA256_LANE_MAJ( x, y, z )      _mm256_or_si256( _mm256_and_si256( x, y ), _mm256_and_si256( z, _mm256_or_si256( x, y ) ) )
+    #define SHA256_LANE_BSIG0( x )          _mm256_xor_si256( _mm256_xor_si256( SHA256_LANE_ROTR( x, 2 ), SHA256_LANE_ROTR( x, 13 ) ), SHA256_LANE_ROTR( x, 22 ) )
+    #define SHA256_LANE_BSIG1( x )          _mm256_xor_si256( _mm256_xor_si256( SHA256_LANE_ROTR( x, 6 ), SHA256_LANE_ROTR( x, 11 ) ), SHA256_LANE_ROTR( x, 25 ) )
+    #define SHA256_LANE_SSIG0( x )          _mm256_xor_si256( _mm256_xor_si256( SHA256_LANE_ROTR( x, 7 ), SHA256_LANE_ROTR( x, 18 ) ), _mm256_srli_epi32( x, 3 ) )
+    #define SHA256_LANE_SSIG1( x )          _mm256_xor_si256( _mm256_xor_si256( SHA256_LANE_ROTR( x, 17 ), SHA256_LANE_ROTR( x, 19 ) ), _mm256_srli_epi32( x, 10 ) )
+
+/**
+ * @brief One round of the SHA-256 compression function on eight lanes, as
+ * #SHA256_ROUND.
+ */
+    #define SHA256_LANE_ROUND( a, b, c, d, e, f, g, h, w, t )                                           \
+    do {                                                                                                \
+        __m256i temp;                                                                                   \
+        if( ( t ) >= 16U )                                                                              \
+        {                                                                                               \
+            ( w )[ ( t ) & 15U ] = _mm256_add_epi32(                                                    \
+                _mm256_add_epi32( ( w )[ ( t ) & 15U ], SHA256_LANE_SSIG1( ( w )[ ( ( t ) - 2U ) & 15U ] ) ), \
+                _mm256_add_epi32( ( w )[ ( ( t ) - 7U ) & 15U ], SHA256_LANE_SSIG0( ( w )[ ( ( t ) - 15U ) & 15U ] ) ) ); \
+        }                                                                                               \
+        temp = _mm256_add_epi32( _mm256_add_epi32( ( h ), SHA256_LANE_BSIG1( e ) ),                     \
+                                 _mm256_add_epi32( SHA256_LANE_CH( e, f, g ),                           \
+                                                   _mm256_add_epi32( _mm256_set1_epi32( ( int ) sha256K[ t ] ), \
+                                                                     ( w )[ ( t ) & 15U ] ) ) );        \
+        ( d ) = _mm256_add_epi32( ( d ), temp );                                                        \
+        ( h ) = _mm256_add_epi32( temp, _mm256_add_epi32( SHA256_LANE_BSIG0( a ), SHA256_LANE_MAJ( a, b, c ) ) ); \
+    } while( 0 )
+
+#endif /* #if ( SHA256_AVX2_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief The SHA-256 round constants.
+ */
+static const uint32_t sha256K[ 64 ] =
+{
+    0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+    0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+    0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+    0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+    0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+    0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+    0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+    0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL
+};
+
+/**
+ * @brief The initial hash value of FIPS 180-4, section 5.3.3.
+ */
+static const uint32_t sha256InitialState[ 8 ] =
+{
+    0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL, 0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL
+};
+
+/**
+ * @brief Compress whole blocks into the hash state in portable C.
+ *
+ * @param[in, out] pState The intermediate hash value.
+ * @param[in] pBlocks The blocks to compress.
+ * @param[in] blockCount Number of blocks in @p pBlocks.
+ */
+static void compressBlocks( uint32_t * pState,
+                            const uint8_t * pBlocks,
+                            size_t blockCount );
+
+#if ( SHA256_SHA_NI_SUPPORTED == 1 )
+
+/**
+ * @brief Compress whole blocks into the hash state with the x86 SHA
+ * extensions.
+ *
+ * @param[in, out] pState The intermediate hash value.
+ * @param[in] pBlocks The blocks to compress.
+ * @param[in] blockCount Number of blocks in @p pBlocks.
+ */
+    static void compressBlocksShaNi( uint32_t * pState,
+                                     const uint8_t * pBlocks,
+                                     size_t blockCount ) __attribute__( ( target( "sha,sse4.1" ) ) );
+
+#endif /* #if ( SHA256_SHA_NI_SUPPORTED == 1 ) */
+
+#if ( SHA256_AVX2_SUPPORTED == 1 )
+
+/**
+ * @brief Compress one block of each of eight messages with AVX2.
+ *
+ * @param[in, out] pState The intermediate hash values, with word i of lane j
+ * in element j of pState[ i ].
+ * @param[in] pBlocks The block of each lane.
+ */
+    static void compressLanesAvx2( __m256i * pState,
+                                   const uint8_t * const * pBlocks ) __attribute__( ( target( "avx2" ) ) );
+
+/**
+ * @brief Hash up to eight messages together with AVX2.
+ *
+ * @param[in] pInputs The messages.
+ * @param[in] pInputLens Length of each message.
+ * @param[out] pDigests Buffer receiving the digests, one after another.
+ * @param[in] laneCount Number of messages, at most #SHA256_LANE_COUNT.
+ */
+    static void hashLanesAvx2( const uint8_t * const * pInputs,
+                               const size_t * pInputLens,
+                               uint8_t * pDigests,
+                               size_t laneCount ) __attribute__( ( target( "avx2" ) ) );
+
+#endif /* #if ( SHA256_AVX2_SUPPORTED == 1 ) */
+
+/**
+ * @brief Read a big-endian 32-bit word.
+ *
+ * @param[in] pData The four bytes of the word.
+ *
+ * @return The word.
+ */
+static uint32_t loadBigEndian32( const uint8_t * pData );
+
+/**
+ * @brief Check whether the processor supports the x86 SHA extensions.
+ *
+ * @return 1 if the SHA extensions can be used, 0 otherwise.
+ */
+static uint8_t detectShaNi( void );
+
+/**
+ * @brief Check whether the processor and the operating system support AVX2.
+ *
+ * @return 1 if AVX2 can be used, 0 otherwise.
+ */
+static uint8_t detectAvx2( void );
+
+/**
+ * @brief Compress whole blocks with the implementation selected for a
+ * context.
+ *
+ * @param[in, out] pContext The context holding the hash state.
+ * @param[in] pBlocks The blocks to compress.
+ * @param[in] blockCount Number of blocks in @p pBlocks.
+ */
+static void compressContextBlocks( SigV4Sha256Context_t * pContext,
+                                   const uint8_t * pBlocks,
+                                   size_t blockCount );
+
+/*-----------------------------------------------------------*/
+
+static void compressBlocks( uint32_t * pState,
+                            const uint8_t * pBlocks,
+                            size_t blockCount )
+{
+    uint32_t w[ 16 ];
+    uint32_t a = 0U, b = 0U, c = 0U, d = 0U, e = 0U, f = 0U, g = 0U, h = 0U;
+    size_t i = 0U, t = 0U;
+    const uint8_t * pBlock = pBlocks;
+
+    assert( ( pState != NULL ) && ( pBlocks != NULL ) );
+
+    for( i = 0U; i < blockCount; i++ )
+    {
+        for( t = 0U; t < 16U; t++ )
+        {
+            w[ t ] = loadBigEndian32( &pBlock[ 4U * t ] );
+        }
+
+        a = pState[ 0 ];
+        b = pState[ 1 ];
+        c = pState[ 2 ];
+        d = pState[ 3 ];
+        e = pState[ 4 ];
+        f = pState[ 5 ];
+        g = pState[ 6 ];
+        h = pState[ 7 ];
+
+        for( t = 0U; t < 64U; t += 8U )
+        {
+            SHA256_ROUND( a, b, c, d, e, f, g, h, w, t );
+            SHA256_ROUND( h, a, b, c, d, e, f, g, w, t + 1U );
+            SHA256_ROUND( g, h, a, b, c, d, e, f, w, t + 2U );
+            SHA256_ROUND( f, g, h, a, b, c, d, e, w, t + 3U );
+            SHA256_ROUND( e, f, g, h, a, b, c, d, w, t + 4U );
+            SHA256_ROUND( d, e, f, g, h, a, b, c, w, t + 5U );
+            SHA256_ROUND( c, d, e, f, g, h, a, b, w, t + 6U );
+            SHA256_ROUND( b, c, d, e, f, g, h, a, w, t + 7U );
+        }
+
+        pState[ 0 ] += a;
+        pState[ 1 ] += b;
+        pState[ 2 ] += c;
+        pState[ 3 ] += d;
+        pState[ 4 ] += e;
+        pState[ 5 ] += f;
+        pState[ 6 ] += g;
+        pState[ 7 ] += h;
+
+        pBlock = &pBlock[ SIGV4_SHA256_BLOCK_LENGTH ];
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( SHA256_SHA_NI_SUPPORTED == 1 )
+
+    static void compressBlocksShaNi( uint32_t * pState,
+                                     const uint8_t * pBlocks,
+                                     size_t blockCount )
+    {
+        /* Reverses the bytes of each 32-bit word, as SHA-256 is big-endian. */
+        const __m128i byteSwapMask = _mm_set_epi8( 12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3 );
+        __m128i abef, cdgh, abefSaved, cdghSaved, temp;
+        __m128i msg[ 4 ];
+        size_t i = 0U, t = 0U;
+        const uint8_t * pBlock = pBlocks;
+
+        assert( ( pState != NULL ) && ( pBlocks != NULL ) );
+
+        /* The SHA instructions hold the state as ABEF and CDGH. */
+        temp = _mm_shuffle_epi32( _mm_loadu_si128( ( const __m128i * ) &pState[ 0 ] ), 0xB1 );
+        cdgh = _mm_shuffle_epi32( _mm_loadu_si128( ( const __m128i * ) &pState[ 4 ] ), 0x1B );
+        abef = _mm_alignr_epi8( temp, cdgh, 8 );
+        cdgh = _mm_blend_epi16( cdgh, temp, 0xF0 );
+
+        for( i = 0U; i < blockCount; i++ )
+        {
+            abefSaved = abef;
+            cdghSaved = cdgh;
+
+            /* Each iteration performs four rounds. Message words 16 to 63 are
+             * computed from the previous 16, held in msg. */
+            for( t = 0U; t < 16U; t++ )
+            {
+                if( t < 4U )
+                {
+                    msg[ t ] = _mm_shuffle_epi8( _mm_loadu_si128( ( const __m128i * ) &pBlock[ 16U * t ] ), byteSwapMask );
+                }
+                else
+                {
+                    temp = _mm_sha256msg1_epu32( msg[ t & 3U ], msg[ ( t - 3U ) & 3U ] );
+                    temp = _mm_add_epi32( temp, _mm_alignr_epi8( msg[ ( t - 1U ) & 3U ], msg[ ( t - 2U ) & 3U ], 4 ) );
+                    msg[ t & 3U ] = _mm_sha256msg2_epu32( temp, msg[ ( t - 1U ) & 3U ] );
+                }
+
+                temp = _mm_add_epi32( msg[ t & 3U ], _mm_loadu_si128( ( const __m128i * ) &sha256K[ 4U * t ] ) );
+                cdgh = _mm_sha256rnds2_epu32( cdgh, abef, temp );
+                abef = _mm_sha256rnds2_epu32( abef, cdgh, _mm_shuffle_epi32( temp, 0x0E ) );
+            }
+
+            abef = _mm_add_epi32( abef, abefSaved );
+            cdgh = _mm_add_epi32( cdgh, cdghSaved );
+
+            pBlock = &pBlock[ SIGV4_SHA256_BLOCK_LENGTH ];
+        }
+
+        temp = _mm_shuffle_epi32( abef, 0x1B );
+        cdgh = _mm_shuffle_epi32( cdgh, 0xB1 );
+        _mm_storeu_si128( ( __m128i * ) &pState[ 0 ], _mm_blend_epi16( temp, cdgh, 0xF0 ) );
+        _mm_storeu_si128( ( __m128i * ) &pState[ 4 ], _mm_alignr_epi8( cdgh, temp, 8 ) );
+    }
+
+#endif /* #if ( SHA256_SHA_NI_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+#if ( SHA256_AVX2_SUPPORTED == 1 )
+
+    static void compressLanesAvx2( __m256i * pState,
+                                   const uint8_t * const * pBlocks )
+    {
+        __m256i w[ 16 ];
+        __m256i a, b, c, d, e, f, g, h;
+        size_t t = 0U;
+
+        assert( ( pState != NULL ) && ( pBlocks != NULL ) );
+
+        /* Gather word t of every lane's block into one vector. */
+        for( t = 0U; t < 16U; t++ )
+        {
+            w[ t ] = _mm256_set_epi32( ( int ) loadBigEndian32( &pBlocks[ 7 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 6 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 5 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 4 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 3 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 2 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 1 ][ 4U * t ] ),
+                                       ( int ) loadBigEndian32( &pBlocks[ 0 ][ 4U * t ] ) );
+        }
+
+        a = pState[ 0 ];
+        b = pState[ 1 ];
+        c = pState[ 2 ];
+        d = pState[ 3 ];
+        e = pState[ 4 ];
+        f = pState[ 5 ];
+        g = pState[ 6 ];
+        h = pState[ 7 ];
+
+        for( t = 0U; t < 64U; t += 8U )
+        {
+            SHA256_LANE_ROUND( a, b, c, d, e, f, g, h, w, t );
+            SHA256_LANE_ROUND( h, a, b, c, d, e, f, g, w, t + 1U );
+            SHA256_LANE_ROUND( g, h, a, b, c, d, e, f, w, t + 2U );
+            SHA256_LANE_ROUND( f, g, h, a, b, c, d, e, w, t + 3U );
+            SHA256_LANE_ROUND( e, f, g, h, a, b, c, d, w, t + 4U );
+            SHA256_LANE_ROUND( d, e, f, g, h, a, b, c, w, t + 5U );
+            SHA256_LANE_ROUND( c, d, e, f, g, h, a, b, w, t + 6U );
+            SHA256_LANE_ROUND( b, c, d, e, f, g, h, a, w, t + 7U );
+        }
+
+        pState[ 0 ] = _mm256_add_epi32( pState[ 0 ], a );
+        pState[ 1 ] = _mm256_add_epi32( pState[ 1 ], b );
+        pState[ 2 ] = _mm256_add_epi32( pState[ 2 ], c );
+        pState[ 3 ] = _mm256_add_epi32( pState[ 3 ], d );
+        pState[ 4 ] = _mm256_add_epi32( pState[ 4 ], e );
+        pState[ 5 ] = _mm256_add_epi32( pState[ 5 ], f );
+        pState[ 6 ] = _mm256_add_epi32( pState[ 6 ], g );
+        pState[ 7 ] = _mm256_add_epi32( pState[ 7 ], h );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void hashLanesAvx2( const uint8_t * const * pInputs,
+                               const size_t * pInputLens,
+                               uint8_t * pDigests,
+                               size_t laneCount )
+    {
+        /* The padded last one or two blocks of each message. */
+        uint8_t pTails[ SHA256_LANE_COUNT ][ 2U * SIGV4_SHA256_BLOCK_LENGTH ];
+        size_t pFullBlockCounts[ SHA256_LANE_COUNT ], pBlockCounts[ SHA256_LANE_COUNT ];
+        const uint8_t * pBlocks[ SHA256_LANE_COUNT ];
+        uint32_t pWords[ SHA256_LANE_COUNT ];
+        __m256i state[ 8 ];
+        size_t lane = 0U, block = 0U, maxBlockCount = 0U, tailLen = 0U, remainder = 0U, i = 0U;
+        uint64_t bitLen = 0U;
+
+        assert( ( pInputs != NULL ) && ( pInputLens != NULL ) && ( pDigests != NULL ) );
+        assert( laneCount <= SHA256_LANE_COUNT );
+
+        ( void ) memset( pTails, 0, sizeof( pTails ) );
+
+        for( lane = 0U; lane < SHA256_LANE_COUNT; lane++ )
+        {
+            pFullBlockCounts[ lane ] = 0U;
+            pBlockCounts[ lane ] = 0U;
+
+            if( lane < laneCount )
+            {
+                pFullBlockCounts[ lane ] = pInputLens[ lane ] / SIGV4_SHA256_BLOCK_LENGTH;
+                remainder = pInputLens[ lane ] % SIGV4_SHA256_BLOCK_LENGTH;
+
+                if( remainder > 0U )
+                {
+                    ( void ) memcpy( pTails[ lane ],
+                                     &pInputs[ lane ][ pFullBlockCounts[ lane ] * SIGV4_SHA256_BLOCK_LENGTH ],
+                                     remainder );
+                }
+
+                pTails[ lane ][ remainder ] = ( uint8_t ) SHA256_PADDING_START;
+                tailLen = ( remainder < SHA256_LENGTH_OFFSET ) ? SIGV4_SHA256_BLOCK_LENGTH : ( 2U * SIGV4_SHA256_BLOCK_LENGTH );
+                bitLen = ( uint64_t ) pInputLens[ lane ] << 3;
+
+                for( i = 0U; i < 8U; i++ )
+                {
+                    pTails[ lane ][ tailLen - 8U + i ] = ( uint8_t ) ( bitLen >> ( 56U - ( 8U * i ) ) );
+                }
+
+                pBlockCounts[ lane ] = pFullBlockCounts[ lane ] + ( tailLen / SIGV4_SHA256_BLOCK_LENGTH );
+                maxBlockCount = ( pBlockCounts[ lane ] > maxBlockCount ) ? pBlockCounts[ lane ] : maxBlockCount;
+            }
+        }
+
+        for( i = 0U; i < 8U; i++ )
+        {
+            state[ i ] = _mm256_set1_epi32( ( int ) sha256InitialState[ i ] );
+        }
+
+        for( block = 0U; block < maxBlockCount; block++ )
+        {
+            /* A lane that has finished, or is unused, compresses a block whose
+             * result is ignored. */
+            for( lane = 0U; lane < SHA256_LANE_COUNT; lane++ )
+            {
+                if( block < pFullBlockCounts[ lane ] )
+                {
+                    pBlocks[ lane ] = &pInputs[ lane ][ block * SIGV4_SHA256_BLOCK_LENGTH ];
+                }
+                else if( block < pBlockCounts[ lane ] )
+                {
+                    pBlocks[ lane ] = &pTails[ lane ][ ( block - pFullBlockCounts[ lane ] ) * SIGV4_SHA256_BLOCK_LENGTH ];
+                }
+                else
+                {
+                    pBlocks[ lane ] = pTails[ lane ];
+                }
+            }
+
+            compressLanesAvx2( state, pBlocks );
+
+            for( lane = 0U; lane < laneCount; lane++ )
+            {
+                if( pBlockCounts[ lane ] == ( block + 1U ) )
+                {
+                    for( i = 0U; i < 8U; i++ )
+                    {
+                        _mm256_storeu_si256( ( __m256i * ) pWords, state[ i ] );
+                        pDigests[ ( lane * SIGV4_SHA256_DIGEST_LENGTH ) + ( 4U * i ) ] = ( uint8_t ) ( pWords[ lane ] >> 24 );
+                        pDigests[ ( lane * SIGV4_SHA256_DIGEST_LENGTH ) + ( 4U * i ) + 1U ] = ( uint8_t ) ( pWords[ lane ] >> 16 );
+                        pDigests[ ( lane * SIGV4_SHA256_DIGEST_LENGTH ) + ( 4U * i ) + 2U ] = ( uint8_t ) ( pWords[ lane ] >> 8 );
+                        pDigests[ ( lane * SIGV4_SHA256_DIGEST_LENGTH ) + ( 4U * i ) + 3U ] = ( uint8_t ) pWords[ lane ];
+                    }
+                }
+            }
+        }
+    }
+
+#endif /* #if ( SHA256_AVX2_SUPPORTED == 1 ) */
+
+/*-----------------------------------------------------------*/
+
+static uint32_t loadBigEndian32( const uint8_t * pData )
+{
+    return ( ( uint32_t ) pData[ 0 ] << 24 ) | ( ( uint32_t ) pData[ 1 ] << 16 ) |
+           ( ( uint32_t ) pData[ 2 ] << 8 ) | ( uint32_t ) pData[ 3 ];
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t detectShaNi( void )
+{
+    uint8_t useShaNi = 0U;
+
+    #if ( SHA256_SHA_NI_SUPPORTED == 1 )
+        unsigned int eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+
+        /* Leaf 1 reports SSSE3 and SSE4.1, leaf 7 reports the SHA extensions. */
+        if( ( __get_cpuid( 1U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+            ( ( ecx & bit_SSSE3 ) != 0U ) && ( ( ecx & bit_SSE4_1 ) != 0U ) &&
+            ( __get_cpuid_count( 7U, 0U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+            ( ( ebx & bit_SHA ) != 0U ) )
+        {
+            useShaNi = 1U;
+        }
+    #endif
+
+    return useShaNi;
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t detectAvx2( void )
+{
+    uint8_t useAvx2 = 0U;
+
+    #if ( SHA256_AVX2_SUPPORTED == 1 )
+        unsigned int eax = 0U, ebx = 0U, ecx = 0U, edx = 0U;
+
+        /* Leaf 1 reports AVX and whether XGETBV is available, to check that
+         * the OS saves the AVX registers. Leaf 7 reports AVX2. */
+        if( ( __get_cpuid( 1U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+            ( ( ecx & bit_OSXSAVE ) != 0U ) && ( ( ecx & bit_AVX ) != 0U ) )
+        {
+            __asm__ __volatile__ ( "xgetbv" : "=a" ( eax ), "=d" ( edx ) : "c" ( 0U ) );
+
+            if( ( ( eax & SHA256_XCR0_AVX_STATE ) == SHA256_XCR0_AVX_STATE ) &&
+                ( __get_cpuid_count( 7U, 0U, &eax, &ebx, &ecx, &edx ) != 0 ) &&
+                ( ( ebx & bit_AVX2 ) != 0U ) )
+            {
+                useAvx2 = 1U;
+            }
+        }
+    #endif
+
+    return useAvx2;
+}
+
+/*-----------------------------------------------------------*/
+
+static void compressContextBlocks( SigV4Sha256Context_t * pContext,
+                                   const uint8_t * pBlocks,
+                                   size_t blockCount )
+{
+    assert( pContext != NULL );
+
+    #if ( SHA256_SHA_NI_SUPPORTED == 1 )
+        if( pContext->useShaNi == 1U )
+        {
+            compressBlocksShaNi( pContext->state, pBlocks, blockCount );
+        }
+        else
+    #endif
+    {
+        compressBlocks( pContext->state, pBlocks, blockCount );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+SigV4Status_t SigV4_Sha256InitCryptoInterface( SigV4CryptoInterface_t * pCryptoInterface,
+                                               SigV4Sha256Context_t * pContext )
+{
+    SigV4Status_t returnStatus = SigV4Success;
+
+    if( ( pCryptoInterface == NULL ) || ( pContext == NULL ) )
+    {
+        LogError( ( "Parameter check failed: pCryptoInterface and pContext must not be NULL." ) );
+        returnStatus = SigV4InvalidParameter;
+    }
+    else
+    {
+        ( void ) memset( pContext, 0, sizeof( SigV4Sha256Context_t ) );
+        pContext->useShaNi = detectShaNi();
+        pContext->useAvx2 = detectAvx2();
+
+        pCryptoInterface->hashInit = SigV4_Sha256Init;
+        pCryptoInterface->hashUpdate = SigV4_Sha256Update;
+        pCryptoInterface->hashFinal = SigV4_Sha256Final;
+        pCryptoInterface->hashCopyContext = SigV4_Sha256CopyContext;
+        pCryptoInterface->hashMultiple = SigV4_Sha256HashMultiple;
+        pCryptoInterface->pHashContext = pContext;
+        pCryptoInterface->hashBlockLen = SIGV4_SHA256_BLOCK_LENGTH;
+    }
+
+    return returnStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SigV4_Sha256Init( void * pHashContext )
+{
+    int32_t result = 0;
+    SigV4Sha256Context_t * pContext = ( SigV4Sha256Context_t * ) pHashContext;
+
+    if( pContext == NULL )
+    {
+        result = -1;
+    }
+    else
+    {
+        ( void ) memcpy( pContext->state, sha256InitialState, sizeof( sha256InitialState ) );
+        pContext->inputLen = 0U;
+        pContext->blockLen = 0U;
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SigV4_Sha256Update( void * pHashContext,
+                            const uint8_t * pInput,
+                            size_t inputLen )
+{
+    int32_t result = 0;
+    SigV4Sha256Context_t * pContext = ( SigV4Sha256Context_t * ) pHashContext;
+    size_t copyLen = 0U, blockCount = 0U, offset = 0U;
+
+    if( ( pContext == NULL ) || ( ( pInput == NULL ) && ( inputLen > 0U ) ) )
+    {
+        result = -1;
+    }
+    else
+    {
+        pContext->inputLen += inputLen;
+
+        /* Complete the block started by an earlier update. */
+        if( pContext->blockLen > 0U )
+        {
+            copyLen = SIGV4_SHA256_BLOCK_LENGTH - pContext->blockLen;
+            copyLen = ( inputLen < copyLen ) ? inputLen : copyLen;
+            ( void ) memcpy( &pContext->block[ pContext->blockLen ], pInput, copyLen );
+            pContext->blockLen += copyLen;
+            offset = copyLen;
+
+            if( pContext->blockLen == SIGV4_SHA256_BLOCK_LENGTH )
+            {
+                compressContextBlocks( pContext, pContext->block, 1U );
+                pContext->blockLen = 0U;
+            }
+        }
+
+        /* Compress whole blocks straight from the input. */
+        blockCount = ( inputLen - offset ) / SIGV4_SHA256_BLOCK_LENGTH;
+
+        if( blockCount > 0U )
+        {
+            compressContextBlocks( pContext, &pInput[ offset ], blockCount );
+            offset += blockCount * SIGV4_SHA256_BLOCK_LENGTH;
+        }
+
+        if( offset < inputLen )
+        {
+            ( void ) memcpy( pContext->block, &pInput[ offset ], inputLen - offset );
+            pContext->blockLen = inputLen - offset;
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SigV4_Sha256Final( void * pHashContext,
+                           uint8_t * pOutput,
+                           size_t outputLen )
+{
+    int32_t result = 0;
+    SigV4Sha256Context_t * pContext = ( SigV4Sha256Context_t * ) pHashContext;
+    uint64_t bitLen = 0U;
+    size_t i = 0U;
+
+    if( ( pContext == NULL ) || ( pOutput == NULL ) || ( outputLen < SIGV4_SHA256_DIGEST_LENGTH ) )
+    {
+        result = -1;
+    }
+    else
+    {
+        bitLen = pContext->inputLen << 3;
+
+        /* Append the padding start, then zeros up to the length. If the length
+         * does not fit in this block, it goes in another one. */
+        pContext->block[ pContext->blockLen ] = ( uint8_t ) SHA256_PADDING_START;
+        pContext->blockLen++;
+
+        if( pContext->blockLen > SHA256_LENGTH_OFFSET )
+        {
+            ( void ) memset( &pContext->block[ pContext->blockLen ], 0, SIGV4_SHA256_BLOCK_LENGTH - pContext->blockLen );
+            compressContextBlocks( pContext, pContext->block, 1U );
+            pContext->blockLen = 0U;
+        }
+
+        ( void ) memset( &pContext->block[ pContext->blockLen ], 0, SHA256_LENGTH_OFFSET - pContext->blockLen );
+
+        for( i = 0U; i < 8U; i++ )
+        {
+            pContext->block[ SHA256_LENGTH_OFFSET + i ] = ( uint8_t ) ( bitLen >> ( 56U - ( 8U * i ) ) );
+        }
+
+        compressContextBlocks( pContext, pContext->block, 1U );
+        pContext->blockLen = 0U;
+
+        for( i = 0U; i < SIGV4_SHA256_DIGEST_LENGTH; i++ )
+        {
+            pOutput[ i ] = ( uint8_t ) ( pContext->state[ i / 4U ] >> ( 24U - ( 8U * ( i % 4U ) ) ) );
+        }
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SigV4_Sha256CopyContext( void * pDestContext,
+                                 const void * pSrcContext )
+{
+    int32_t result = 0;
+
+    if( ( pDestContext == NULL ) || ( pSrcContext == NULL ) )
+    {
+        result = -1;
+    }
+    else
+    {
+        ( void ) memcpy( pDestContext, pSrcContext, sizeof( SigV4Sha256Context_t ) );
+    }
+
+    return result;
+}
+
+/*-----------------------------------------------------------*/
+
+int32_t SigV4_Sha256HashMultiple( void * pHashContext,
+                                  const uint8_t * const * pInputs,
+                                  const size_t * pInputLens,
+                                  uint8_t * pDigests,
+                                  size_t count )
+{
+    int32_t result = 0;
+    SigV4Sha256Context_t * pContext = ( SigV4Sha256Context_t * ) pHashContext;
+    size_t i = 0U;
+
+    if( ( pContext == NULL ) || ( pInputs == NULL ) || ( pInputLens == NULL ) || ( pDigests == NULL ) )
+    {
+        result = -1;
+    }
+
+    for( i = 0U; ( i < count ) && ( result == 0 ); i++ )
+    {
+        if( ( pInputs[ i ] == NULL ) && ( pInputLens[ i ] > 0U ) )
+        {
+            result = -1;
+        }
+    }
+
+    /* A single SHA-NI stream is faster than eight AVX2 lanes, so the lanes
+     * are only used when blocks would otherwise be compressed in C. */
+    #if ( SHA256_AVX2_SUPPORTED == 1 )
+        if( ( result == 0 ) && ( pContext->useAvx2 == 1U ) && ( pContext->useShaNi == 0U ) )
+        {
+            for( i = 0U; i < count; i += SHA256_LANE_COUNT )
+            {
+                hashLanesAvx2( &pInputs[ i ],
+                               &pInputLens[ i ],
+                               &pDigests[ i * SIGV4_SHA256_DIGEST_LENGTH ],
+                               ( ( count - i ) < SHA256_LANE_COUNT ) ? ( count - i ) : SHA256_LANE_COUNT );
+            }
+        }
+        else
+    #endif
+
+    if( result == 0 )
+    {
+        for( i = 0U; ( i < count ) && ( result == 0 ); i++ )
+        {
+            result = SigV4_Sha256Init( pContext );
+
+            if( result == 0 )
+            {
+                result = SigV4_Sha256Update( pContext, pInputs[ i ], pInputLens[ i ] );
+            }
+
+            if( result == 0 )
+            {
+                result = SigV4_Sha256Final( pContext, &pDigests[ i * SIGV4_SHA256_DIGEST_LENGTH ], SIGV4_SHA256_DIGEST_LENGTH );
+            }
+        }
+    }
+
+    return result;
+}